@@ -0,0 +1,94 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "ledger/ledgerCache.h"
+
+LedgerPublicKeyCache &LedgerPublicKeyCache::instance()
+{
+   static LedgerPublicKeyCache cache;
+   return cache;
+}
+
+LedgerPublicKeyCache::Key LedgerPublicKeyCache::key(const BinaryData &fingerprint, const bs::hd::Path &path)
+{
+   std::vector<uint32_t> elements;
+   elements.reserve(path.length());
+   for (const auto el : path) {
+      elements.push_back(el);
+   }
+   return { fingerprint, std::move(elements) };
+}
+
+bool LedgerPublicKeyCache::get(const BinaryData &fingerprint, const bs::hd::Path &path, BIP32_Node &node) const
+{
+   if (fingerprint.empty()) {
+      return false;
+   }
+   std::lock_guard<std::mutex> lock(mutex_);
+   const auto it = nodes_.find(key(fingerprint, path));
+   if (it == nodes_.end()) {
+      return false;
+   }
+   node = it->second;
+   return true;
+}
+
+void LedgerPublicKeyCache::put(const BinaryData &fingerprint, const bs::hd::Path &path, const BIP32_Node &node)
+{
+   if (fingerprint.empty() || node.getPublicKey().empty()) {
+      return;
+   }
+   std::lock_guard<std::mutex> lock(mutex_);
+   nodes_[key(fingerprint, path)] = node;
+}
+
+size_t LedgerPublicKeyCache::size() const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   return nodes_.size();
+}
+
+void LedgerPublicKeyCache::clear()
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   nodes_.clear();
+}
+
+bool LedgerTrustedInputCache::get(const BinaryData &txHash, uint32_t txOutIndex, QByteArray &trustedInput) const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   const auto it = trustedInputs_.find({ txHash, txOutIndex });
+   if (it == trustedInputs_.end()) {
+      return false;
+   }
+   trustedInput = it->second;
+   return true;
+}
+
+void LedgerTrustedInputCache::put(const BinaryData &txHash, uint32_t txOutIndex, const QByteArray &trustedInput)
+{
+   if (trustedInput.isEmpty()) {
+      return;
+   }
+   std::lock_guard<std::mutex> lock(mutex_);
+   trustedInputs_[{ txHash, txOutIndex }] = trustedInput;
+}
+
+size_t LedgerTrustedInputCache::size() const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   return trustedInputs_.size();
+}
+
+void LedgerTrustedInputCache::clear()
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   trustedInputs_.clear();
+}
@@ -0,0 +1,67 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef LEDGERCACHE_H
+#define LEDGERCACHE_H
+
+#include "BinaryData.h"
+#include "BIP32_Node.h"
+#include "HDPath.h"
+
+#include <QByteArray>
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Public keys derived by the device never change for a given seed, so they
+// are kept for the process lifetime, keyed by device fingerprint (hash of
+// the root public key) and derivation path.
+class LedgerPublicKeyCache
+{
+public:
+   static LedgerPublicKeyCache &instance();
+
+   bool get(const BinaryData &fingerprint, const bs::hd::Path &path, BIP32_Node &node) const;
+   void put(const BinaryData &fingerprint, const bs::hd::Path &path, const BIP32_Node &node);
+
+   size_t size() const;
+   void clear();
+
+private:
+   LedgerPublicKeyCache() = default;
+
+   using Key = std::pair<BinaryData, std::vector<uint32_t>>;
+   static Key key(const BinaryData &fingerprint, const bs::hd::Path &path);
+
+private:
+   mutable std::mutex   mutex_;
+   std::map<Key, BIP32_Node>  nodes_;
+};
+
+// Trusted inputs are authenticated by the device with a key that lives only
+// until Bitcoin app is restarted, so they are cached per outpoint for the
+// device session only (see LedgerDevice).
+class LedgerTrustedInputCache
+{
+public:
+   bool get(const BinaryData &txHash, uint32_t txOutIndex, QByteArray &trustedInput) const;
+   void put(const BinaryData &txHash, uint32_t txOutIndex, const QByteArray &trustedInput);
+
+   size_t size() const;
+   void clear();
+
+private:
+   mutable std::mutex   mutex_;
+   std::map<std::pair<BinaryData, uint32_t>, QByteArray>  trustedInputs_;
+};
+
+#endif // LEDGERCACHE_H
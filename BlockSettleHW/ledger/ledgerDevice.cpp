@@ -10,7 +10,9 @@
 */
 #include "spdlog/logger.h"
 #include "ledger/ledgerDevice.h"
+#include "ledger/ledgerCache.h"
 #include "ledger/ledgerClient.h"
+#include "ledger/ledgerTransport.h"
 #include "Assets.h"
 #include "ProtobufHeadlessUtils.h"
 #include "CoreWallet.h"
@@ -21,89 +23,6 @@
 #include "QDataStream"
 
 namespace {
-   int sendApdu(hid_device* dongle, const QByteArray& command) {
-      int result = 0;
-      QVector<QByteArray> chunks;
-      uint16_t chunkNumber = 0;
-
-      QByteArray current;
-      current.reserve(Ledger::CHUNK_MAX_BLOCK);
-      writeUintBE(current, Ledger::CHANNEL);
-      writeUintBE(current, Ledger::TAG_APDU);
-      writeUintBE(current, chunkNumber++);
-
-      writeUintBE(current, static_cast<uint16_t>(command.size()));
-
-
-      current.append(command.mid(0, Ledger::FIRST_BLOCK_SIZE));
-      chunks.push_back(std::move(current));
-
-      int processed = std::min(static_cast<int>(Ledger::FIRST_BLOCK_SIZE), chunks.first().size());
-      for (; command.size() - processed > 0; processed += Ledger::NEXT_BLOCK_SIZE) {
-         current.clear();
-         writeUintBE(current, Ledger::CHANNEL);
-         writeUintBE(current, Ledger::TAG_APDU);
-         writeUintBE(current, chunkNumber++);
-
-         current.append(command.mid(processed, Ledger::NEXT_BLOCK_SIZE));
-         chunks.push_back(std::move(current));
-      }
-
-      chunks.last() = chunks.last().leftJustified(Ledger::CHUNK_MAX_BLOCK, 0x00);
-
-      for (auto &chunk : chunks) {
-         assert(chunk.size() == Ledger::CHUNK_MAX_BLOCK);
-         chunk.prepend(static_cast<char>(0x00));
-         result = hid_write(dongle, reinterpret_cast<unsigned char*>(chunk.data())
-            , Ledger::CHUNK_MAX_BLOCK + 1);
-
-         if (result < 0) {
-            break;
-         }
-      }
-
-      return result;
-   }
-
-   uint16_t receiveApduResult(hid_device* dongle, QByteArray& response) {
-      response.clear();
-      uint16_t chunkNumber = 0;
-
-      unsigned char buf[Ledger::CHUNK_MAX_BLOCK];
-      uint16_t result = hid_read(dongle, buf, Ledger::CHUNK_MAX_BLOCK);
-      if (result < 0) {
-         return result;
-      }
-
-      std::vector<uint8_t> buff(&buf[0], &buf[0] + 64);
-
-      QByteArray chunk(reinterpret_cast<char*>(buf), Ledger::CHUNK_MAX_BLOCK);
-      assert(chunkNumber++ == chunk.mid(3, 2).toHex().toInt());
-
-      int left = static_cast<int>(((uint8_t)chunk[5] << 8) | (uint8_t)chunk[6]);
-
-      response.append(chunk.mid(Ledger::FIRST_BLOCK_OFFSET, left));
-      left -= Ledger::FIRST_BLOCK_SIZE;
-
-      for (; left > 0; left -= Ledger::NEXT_BLOCK_SIZE) {
-         chunk.clear();
-         int result = hid_read(dongle, buf, Ledger::CHUNK_MAX_BLOCK);
-         if (result < 0) {
-            return result;
-         }
-
-         chunk = QByteArray(reinterpret_cast<char*>(buf), Ledger::CHUNK_MAX_BLOCK);
-         assert(chunkNumber++ == chunk.mid(3, 2).toHex().toInt());
-
-         response.append(chunk.mid(Ledger::NEXT_BLOCK_OFFSET, left));
-      }
-
-      auto resultCode = response.right(2);
-      response.chop(2);
-      return static_cast<uint16_t>(((uint8_t)resultCode[0] << 8) | (uint8_t)resultCode[1]);
-
-   }
-
    QByteArray getApduHeader(uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2) {
       QByteArray header;
       header.append(cla);
@@ -128,6 +47,7 @@ LedgerDevice::LedgerDevice(HidDeviceInfo&& hidDeviceInfo, bool testNet,
    , logger_(logger)
    , testNet_(testNet)
    , walletManager_(walletManager)
+   , trustedInputCache_(std::make_shared<LedgerTrustedInputCache>())
 {
 }
 
@@ -236,6 +156,7 @@ void LedgerDevice::signTX(const bs::core::wallet::TXSignRequest& coreReq, AsyncC
 QPointer<LedgerCommandThread> LedgerDevice::blankCommand(AsyncCallBackCall&& cb /*= nullptr*/)
 {
    commandThread_ = new LedgerCommandThread(hidDeviceInfo_, testNet_, logger_, this);
+   commandThread_->setTrustedInputCache(trustedInputCache_);
    connect(commandThread_, &LedgerCommandThread::resultReady, this, [cbCopy = std::move(cb)](QVariant result) {
       if (cbCopy) {
          cbCopy(std::move(result));
@@ -322,6 +243,9 @@ void LedgerCommandThread::run()
       return;
    }
 
+   apduCount_ = 0;
+   fingerprint_.clear();
+
    try {
       switch (threadPurpose_)
       {
@@ -354,6 +278,10 @@ void LedgerCommandThread::run()
    catch (std::exception& exc) {
       releaseDevice();
       logger_->debug("[LedgerCommandThread] run - Done command with exception");
+      // Trusted inputs are rejected by device if Bitcoin app was restarted
+      if ((threadPurpose_ == HardwareCommand::SignTX) && trustedInputCache_) {
+         trustedInputCache_->clear();
+      }
       emit error(lastError_);
       if (threadPurpose_ == HardwareCommand::GetRootPublicKey) {
          emit resultReady({});
@@ -366,7 +294,8 @@ void LedgerCommandThread::run()
    }
 
    releaseDevice();
-   logger_->debug("[LedgerCommandThread] run - Done command successfully");
+   logger_->debug("[LedgerCommandThread] run - Done command successfully ({} APDU exchanges)"
+      , apduCount_);
 }
 
 void LedgerCommandThread::prepareGetPublicKey(const DeviceKey &deviceKey)
@@ -391,6 +320,16 @@ void LedgerCommandThread::prepareGetRootKey()
    threadPurpose_ = HardwareCommand::GetRootPublicKey;
 }
 
+void LedgerCommandThread::setTransport(std::unique_ptr<LedgerTransport> transport)
+{
+   transport_ = std::move(transport);
+}
+
+void LedgerCommandThread::setTrustedInputCache(const std::shared_ptr<LedgerTrustedInputCache> &cache)
+{
+   trustedInputCache_ = cache;
+}
+
 void LedgerCommandThread::processGetPublicKey()
 {
    auto deviceKey = deviceKey_;
@@ -501,15 +440,45 @@ void LedgerCommandThread::processGetRootKey()
 
 BIP32_Node LedgerCommandThread::retrievePublicKeyFromPath(bs::hd::Path&& derivationPath)
 {
+   auto &cache = LedgerPublicKeyCache::instance();
+   const auto &fingerprint = deviceFingerprint();
+
+   BIP32_Node result;
+   if (cache.get(fingerprint, derivationPath, result)) {
+      return result;
+   }
+
    // Parent
    std::unique_ptr<BIP32_Node> parent = nullptr;
    if (derivationPath.length() > 1) {
       auto parentPath = derivationPath;
       parentPath.pop();
-      parent.reset(new BIP32_Node(getPublicKeyApdu(std::move(parentPath))));
+      BIP32_Node parentNode;
+      if (!cache.get(fingerprint, parentPath, parentNode)) {
+         const auto path = parentPath;
+         parentNode = getPublicKeyApdu(std::move(parentPath));
+         cache.put(fingerprint, path, parentNode);
+      }
+      parent.reset(new BIP32_Node(parentNode));
    }
 
-   return getPublicKeyApdu(std::move(derivationPath), parent);
+   const auto path = derivationPath;
+   result = getPublicKeyApdu(std::move(derivationPath), parent);
+   cache.put(fingerprint, path, result);
+   return result;
+}
+
+const BinaryData &LedgerCommandThread::deviceFingerprint()
+{
+   if (fingerprint_.empty()) {
+      const bs::hd::Path rootPath({ bs::hd::hardFlag });
+      const auto rootNode = getPublicKeyApdu(bs::hd::Path(rootPath));
+      if (!rootNode.getPublicKey().empty()) {
+         fingerprint_ = BtcUtils::getHash160(rootNode.getPublicKey());
+         LedgerPublicKeyCache::instance().put(fingerprint_, rootPath, rootNode);
+      }
+   }
+   return fingerprint_;
 }
 
 BIP32_Node LedgerCommandThread::getPublicKeyApdu(bs::hd::Path&& derivationPath, const std::unique_ptr<BIP32_Node>& parent)
@@ -554,6 +523,13 @@ BIP32_Node LedgerCommandThread::getPublicKeyApdu(bs::hd::Path&& derivationPath,
 
 QByteArray LedgerCommandThread::getTrustedInput(const UTXO& utxo)
 {
+   QByteArray trustedInput;
+   if (trustedInputCache_ && trustedInputCache_->get(utxo.getTxHash(), utxo.getTxOutIndex(), trustedInput)) {
+      logger_->debug(
+         "[LedgerCommandThread] getTrustedInput - Use cached trusted input for legacy address.");
+      return trustedInput;
+   }
+
    logger_->debug(
       "[LedgerCommandThread] getTrustedInput - Start retrieve trusted input for legacy address.");
 
@@ -654,11 +630,13 @@ QByteArray LedgerCommandThread::getTrustedInput(const UTXO& utxo)
    auto command = getApduCommand(
       Ledger::CLA, Ledger::INS_GET_TRUSTED_INPUT, 0x80, 0x00, std::move(locktime));
 
-   QByteArray trustedInput;
    if (!exchangeData(command, trustedInput, "[LedgerCommandThread] signTX - getting trusted input")) {
       releaseDevice();
       throw std::runtime_error("failed to get trusted input");
    }
+   if (trustedInputCache_) {
+      trustedInputCache_->put(utxo.getTxHash(), utxo.getTxOutIndex(), trustedInput);
+   }
 
    logger_->debug(
       "[LedgerCommandThread] getTrustedInput - Done retrieve trusted input for legacy address.");
@@ -1091,33 +1069,23 @@ void LedgerCommandThread::debugPrintLegacyResult(const QByteArray& responseSigne
 
 bool LedgerCommandThread::initDevice()
 {
-   if (hid_init() < 0) {
-      logger_->info(
-         "[LedgerCommandThread] getPublicKey - Cannot init hid.");
-      return false;
+   if (!transport_) {
+      transport_ = std::make_unique<LedgerHidTransport>(hidDeviceInfo_);
    }
-
-   std::unique_ptr<wchar_t> serNumb(new wchar_t[hidDeviceInfo_.serialNumber_.length() + 1]);
-   hidDeviceInfo_.serialNumber_.toWCharArray(serNumb.get());
-   serNumb.get()[hidDeviceInfo_.serialNumber_.length()] = 0x00;
-   dongle_ = nullptr;
-   dongle_ = hid_open(static_cast<ushort>(Ledger::HID_VENDOR_ID), static_cast<ushort>(hidDeviceInfo_.productId_), serNumb.get());
-
-   return dongle_ != nullptr;
+   return transport_->open();
 }
 
 void LedgerCommandThread::releaseDevice()
 {
-   if (dongle_) {
-      hid_close(dongle_);
-      hid_exit();
-      dongle_ = nullptr;
+   if (transport_) {
+      transport_->close();
    }
 }
 
 bool LedgerCommandThread::exchangeData(const QByteArray& input,
    QByteArray& output, std::string&& logHeader)
 {
+   ++apduCount_;
    auto logHeaderCopy = logHeader;
    if (!writeData(input, std::move(logHeader))) {
       return false;
@@ -1129,7 +1097,7 @@ bool LedgerCommandThread::exchangeData(const QByteArray& input,
 bool LedgerCommandThread::writeData(const QByteArray& input, std::string&& logHeader)
 {
    logger_->debug(logHeader + " - >>> " + input.toHex().toStdString());
-   if (sendApdu(dongle_, input) < 0) {
+   if (transport_->send(input) < 0) {
       logger_->debug(
          logHeader + " - Cannot write to device.");
       return false;
@@ -1140,7 +1108,7 @@ bool LedgerCommandThread::writeData(const QByteArray& input, std::string&& logHe
 
 bool LedgerCommandThread::readData(QByteArray& output, std::string&& logHeader)
 {
-   auto res = receiveApduResult(dongle_, output);
+   auto res = transport_->receive(output);
    if (res != Ledger::SW_OK) {
       logger_->debug(
          logHeader + " - Cannot read from device. APDU error code : "
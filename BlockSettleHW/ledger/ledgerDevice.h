@@ -13,11 +13,12 @@
 
 #include "ledger/ledgerStructure.h"
 #include "hwdeviceinterface.h"
-#include "ledger/hidapi/hidapi.h"
 #include "BinaryData.h"
 
 #include <QThread>
 
+#include <memory>
+
 namespace spdlog {
    class logger;
 }
@@ -33,6 +34,8 @@ namespace bs {
 }
 
 class LedgerCommandThread;
+class LedgerTransport;
+class LedgerTrustedInputCache;
 class LedgerDevice : public HwDeviceInterface
 {
    Q_OBJECT
@@ -79,6 +82,7 @@ private:
    QString lastError_{};
    
    std::string xpubRoot_;
+   std::shared_ptr<LedgerTrustedInputCache> trustedInputCache_;
 };
 
 class LedgerCommandThread : public QThread
@@ -98,6 +102,13 @@ public:
       std::vector<bs::hd::Path>&& paths, bs::hd::Path&& changePath);
    void prepareGetRootKey();
 
+   // HID transport is used if not set
+   void setTransport(std::unique_ptr<LedgerTransport> transport);
+   void setTrustedInputCache(const std::shared_ptr<LedgerTrustedInputCache> &cache);
+
+   // Number of APDU exchanges made by the last command
+   unsigned apduCount() const { return apduCount_; }
+
 signals:
    // Done with success
    void resultReady(QVariant const &result);
@@ -122,6 +133,7 @@ protected:
    void processGetPublicKey();
    void processGetRootKey();
    BIP32_Node retrievePublicKeyFromPath(bs::hd::Path&& derivationPath);
+   const BinaryData &deviceFingerprint();
    BIP32_Node getPublicKeyApdu(bs::hd::Path&& derivationPath, const std::unique_ptr<BIP32_Node>& parent = nullptr);
 
    // Sign tx processing  
@@ -149,7 +161,12 @@ private:
    HidDeviceInfo hidDeviceInfo_;
    bool testNet_{};
    std::shared_ptr<spdlog::logger> logger_;
-   hid_device* dongle_ = nullptr;
+   std::unique_ptr<LedgerTransport> transport_;
+   std::shared_ptr<LedgerTrustedInputCache> trustedInputCache_;
+   unsigned apduCount_{};
+
+   // Hash of root public key, requested once per command
+   BinaryData fingerprint_;
 
    enum class HardwareCommand {
       None,
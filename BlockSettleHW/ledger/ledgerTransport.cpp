@@ -0,0 +1,145 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "ledger/ledgerTransport.h"
+
+#include <QVector>
+
+#include <cassert>
+#include <memory>
+
+namespace {
+   int sendApdu(hid_device* dongle, const QByteArray& command) {
+      int result = 0;
+      QVector<QByteArray> chunks;
+      uint16_t chunkNumber = 0;
+
+      QByteArray current;
+      current.reserve(Ledger::CHUNK_MAX_BLOCK);
+      writeUintBE(current, Ledger::CHANNEL);
+      writeUintBE(current, Ledger::TAG_APDU);
+      writeUintBE(current, chunkNumber++);
+
+      writeUintBE(current, static_cast<uint16_t>(command.size()));
+
+
+      current.append(command.mid(0, Ledger::FIRST_BLOCK_SIZE));
+      chunks.push_back(std::move(current));
+
+      int processed = std::min(static_cast<int>(Ledger::FIRST_BLOCK_SIZE), chunks.first().size());
+      for (; command.size() - processed > 0; processed += Ledger::NEXT_BLOCK_SIZE) {
+         current.clear();
+         writeUintBE(current, Ledger::CHANNEL);
+         writeUintBE(current, Ledger::TAG_APDU);
+         writeUintBE(current, chunkNumber++);
+
+         current.append(command.mid(processed, Ledger::NEXT_BLOCK_SIZE));
+         chunks.push_back(std::move(current));
+      }
+
+      chunks.last() = chunks.last().leftJustified(Ledger::CHUNK_MAX_BLOCK, 0x00);
+
+      for (auto &chunk : chunks) {
+         assert(chunk.size() == Ledger::CHUNK_MAX_BLOCK);
+         chunk.prepend(static_cast<char>(0x00));
+         result = hid_write(dongle, reinterpret_cast<unsigned char*>(chunk.data())
+            , Ledger::CHUNK_MAX_BLOCK + 1);
+
+         if (result < 0) {
+            break;
+         }
+      }
+
+      return result;
+   }
+
+   uint16_t receiveApduResult(hid_device* dongle, QByteArray& response) {
+      response.clear();
+      uint16_t chunkNumber = 0;
+
+      unsigned char buf[Ledger::CHUNK_MAX_BLOCK];
+      uint16_t result = hid_read(dongle, buf, Ledger::CHUNK_MAX_BLOCK);
+      if (result < 0) {
+         return result;
+      }
+
+      std::vector<uint8_t> buff(&buf[0], &buf[0] + 64);
+
+      QByteArray chunk(reinterpret_cast<char*>(buf), Ledger::CHUNK_MAX_BLOCK);
+      assert(chunkNumber++ == chunk.mid(3, 2).toHex().toInt());
+
+      int left = static_cast<int>(((uint8_t)chunk[5] << 8) | (uint8_t)chunk[6]);
+
+      response.append(chunk.mid(Ledger::FIRST_BLOCK_OFFSET, left));
+      left -= Ledger::FIRST_BLOCK_SIZE;
+
+      for (; left > 0; left -= Ledger::NEXT_BLOCK_SIZE) {
+         chunk.clear();
+         int result = hid_read(dongle, buf, Ledger::CHUNK_MAX_BLOCK);
+         if (result < 0) {
+            return result;
+         }
+
+         chunk = QByteArray(reinterpret_cast<char*>(buf), Ledger::CHUNK_MAX_BLOCK);
+         assert(chunkNumber++ == chunk.mid(3, 2).toHex().toInt());
+
+         response.append(chunk.mid(Ledger::NEXT_BLOCK_OFFSET, left));
+      }
+
+      auto resultCode = response.right(2);
+      response.chop(2);
+      return static_cast<uint16_t>(((uint8_t)resultCode[0] << 8) | (uint8_t)resultCode[1]);
+
+   }
+}
+
+LedgerHidTransport::LedgerHidTransport(const HidDeviceInfo &hidDeviceInfo)
+   : hidDeviceInfo_(hidDeviceInfo)
+{
+}
+
+LedgerHidTransport::~LedgerHidTransport()
+{
+   close();
+}
+
+bool LedgerHidTransport::open()
+{
+   if (hid_init() < 0) {
+      return false;
+   }
+
+   std::unique_ptr<wchar_t> serNumb(new wchar_t[hidDeviceInfo_.serialNumber_.length() + 1]);
+   hidDeviceInfo_.serialNumber_.toWCharArray(serNumb.get());
+   serNumb.get()[hidDeviceInfo_.serialNumber_.length()] = 0x00;
+   dongle_ = nullptr;
+   dongle_ = hid_open(static_cast<ushort>(Ledger::HID_VENDOR_ID), static_cast<ushort>(hidDeviceInfo_.productId_), serNumb.get());
+
+   return dongle_ != nullptr;
+}
+
+void LedgerHidTransport::close()
+{
+   if (dongle_) {
+      hid_close(dongle_);
+      hid_exit();
+      dongle_ = nullptr;
+   }
+}
+
+int LedgerHidTransport::send(const QByteArray &command)
+{
+   return sendApdu(dongle_, command);
+}
+
+uint16_t LedgerHidTransport::receive(QByteArray &response)
+{
+   return receiveApduResult(dongle_, response);
+}
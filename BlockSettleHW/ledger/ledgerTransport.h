@@ -0,0 +1,52 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef LEDGERTRANSPORT_H
+#define LEDGERTRANSPORT_H
+
+#include "ledger/ledgerStructure.h"
+#include "ledger/hidapi/hidapi.h"
+
+#include <QByteArray>
+
+// Delivers APDU commands to Ledger device and reads responses back.
+// LedgerCommandThread uses HID transport unless another one is set
+// (e.g. replay of recorded exchanges in unit tests).
+class LedgerTransport
+{
+public:
+   virtual ~LedgerTransport() = default;
+
+   virtual bool open() = 0;
+   virtual void close() = 0;
+
+   // Returns negative value on write failure
+   virtual int send(const QByteArray &command) = 0;
+   // Returns APDU status word, response is stripped of it
+   virtual uint16_t receive(QByteArray &response) = 0;
+};
+
+class LedgerHidTransport : public LedgerTransport
+{
+public:
+   explicit LedgerHidTransport(const HidDeviceInfo &hidDeviceInfo);
+   ~LedgerHidTransport() override;
+
+   bool open() override;
+   void close() override;
+   int send(const QByteArray &command) override;
+   uint16_t receive(QByteArray &response) override;
+
+private:
+   HidDeviceInfo hidDeviceInfo_;
+   hid_device* dongle_ = nullptr;
+};
+
+#endif // LEDGERTRANSPORT_H
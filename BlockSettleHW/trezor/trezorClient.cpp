@@ -124,6 +124,11 @@ void TrezorClient::releaseConnection(AsyncCallBack&& cb)
 
 }
 
+void TrezorClient::setBridgeEndPoint(const QByteArray &endPoint)
+{
+   trezorEndPoint_ = endPoint;
+}
+
 void TrezorClient::postToTrezor(QByteArray&& urlMethod, std::function<void(QNetworkReply*)> &&cb, bool timeout /* = false */)
 {
    post(std::move(urlMethod), std::move(cb), QByteArray(), timeout);
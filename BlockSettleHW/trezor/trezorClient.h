@@ -49,6 +49,9 @@ public:
    QVector<DeviceKey> deviceKeys() const;
    QPointer<TrezorDevice> getTrezorDevice(const QString& deviceId);
 
+   // Default is local trezord bridge, could be replaced with stand-in server in tests
+   void setBridgeEndPoint(const QByteArray &endPoint);
+
 private:
    void postToTrezor(QByteArray&& urlMethod, std::function<void(QNetworkReply*)> &&cb, bool timeout = false);
    void postToTrezorInput(QByteArray&& urlMethod, std::function<void(QNetworkReply*)> &&cb, QByteArray&& input);
@@ -70,7 +73,7 @@ private:
    std::shared_ptr<ConnectionManager> connectionManager_;
    std::shared_ptr<bs::sync::WalletsManager> walletManager_;
 
-   const QByteArray trezorEndPoint_ = "http://127.0.0.1:21325";
+   QByteArray trezorEndPoint_ = "http://127.0.0.1:21325";
    const QByteArray blocksettleOrigin = "https://blocksettle.trezor.io";
    DeviceData deviceData_;
    State state_ = State::None;
@@ -266,6 +266,7 @@ void TrezorDevice::clearSession(AsyncCallBack&& cb)
 void TrezorDevice::signTX(const bs::core::wallet::TXSignRequest &reqTX, AsyncCallBackCall&& cb /*= nullptr*/)
 {
    currentTxSignReq_.reset(new bs::core::wallet::TXSignRequest(reqTX));
+   prevTxStore_.prepare(*currentTxSignReq_);
    connectionManager_->GetLogger()->debug("[TrezorDevice] SignTX - specify init data to " + features_.label());
 
    const int change = static_cast<bool>(currentTxSignReq_->change.value) ? 1 : 0;
@@ -409,6 +410,7 @@ void TrezorDevice::resetCaches()
    awaitingCallbackNoData_.clear();
    awaitingCallbackData_.clear();
    currentTxSignReq_.reset(nullptr);
+   prevTxStore_.clear();
    awaitingTransaction_ = {};
    awaitingWalletInfo_ = {};
 }
@@ -462,21 +464,7 @@ void TrezorDevice::handleTxRequest(const MessageData& data)
    case bitcoin::TxRequest_RequestType_TXINPUT:
    {
       if (!txRequest.details().tx_hash().empty()) {
-         auto input = txAck.mutable_tx()->add_inputs();
-
-         auto tx = prevTx(txRequest);
-         if (tx.isInitialized()) {
-            auto txIn = tx.getTxInCopy(txRequest.details().request_index());
-            input->set_prev_hash(txIn.getOutPoint().getTxHash().copySwapEndian().toBinStr());
-            input->set_prev_index(txIn.getOutPoint().getTxOutIndex());
-            input->set_sequence(txIn.getSequence());
-            input->set_script_sig(txIn.getScript().toBinStr());
-         }
-
-         connectionManager_->GetLogger()->debug("[TrezorDevice] handleTxRequest TXINPUT for prev hash"
-             + getJSONReadableMessage(txAck));
-
-         makeCall(txAck);
+         makePrevTxCall(txRequest);
          break;
       }
 
@@ -532,18 +520,7 @@ void TrezorDevice::handleTxRequest(const MessageData& data)
    {
       // Legacy inputs support
       if (!txRequest.details().tx_hash().empty()) {
-         auto tx = prevTx(txRequest);
-         auto binOutput = txAck.mutable_tx()->add_bin_outputs();
-         if (tx.isInitialized()) {
-            auto txOut = tx.getTxOutCopy(txRequest.details().request_index());
-            binOutput->set_amount(txOut.getValue());
-            binOutput->set_script_pubkey(txOut.getScript().toBinStr());
-         }
-
-         connectionManager_->GetLogger()->debug("[TrezorDevice] handleTxRequest TXOUTPUT for prev hash"
-             + getJSONReadableMessage(txAck));
-
-         makeCall(txAck);
+         makePrevTxCall(txRequest);
          break;
       }
 
@@ -606,19 +583,7 @@ void TrezorDevice::handleTxRequest(const MessageData& data)
    {
       // Return previous tx details for legacy inputs
       // See https://wiki.trezor.io/Developers_guide:Message_Workflows
-      auto tx = prevTx(txRequest);
-      auto data = txAck.mutable_tx();
-      if (tx.isInitialized()) {
-         data->set_version(tx.getVersion());
-         data->set_lock_time(tx.getLockTime());
-         data->set_inputs_cnt(tx.getNumTxIn());
-         data->set_outputs_cnt(tx.getNumTxOut());
-      }
-
-      connectionManager_->GetLogger()->debug("[TrezorDevice] handleTxRequest TXMETA"
-         + getJSONReadableMessage(txAck));
-
-      makeCall(txAck);
+      makePrevTxCall(txRequest);
    }
    break;
    case bitcoin::TxRequest_RequestType_TXFINISHED:
@@ -642,15 +607,47 @@ void TrezorDevice::sendTxMessage(const QString& status)
    emit deviceTxStatusChanged(status);
 }
 
-Tx TrezorDevice::prevTx(const bitcoin::TxRequest &txRequest)
+void TrezorDevice::makePrevTxCall(const bitcoin::TxRequest &txRequest)
 {
-   auto txHash = BinaryData::fromString(txRequest.details().tx_hash()).swapEndian();
-   auto supportingTxIt = currentTxSignReq_->supportingTXs.find(txHash);
-   if (supportingTxIt == currentTxSignReq_->supportingTXs.end()) {
-      SPDLOG_LOGGER_ERROR(connectionManager_->GetLogger(), "can't find prev TX {}", txHash.toHexStr(1));
-      return {};
+   const auto &details = txRequest.details();
+   const bitcoin::TxAck *txAck = nullptr;
+   switch (txRequest.request_type()) {
+   case bitcoin::TxRequest_RequestType_TXINPUT:
+      txAck = prevTxStore_.input(details.tx_hash(), details.request_index());
+      break;
+   case bitcoin::TxRequest_RequestType_TXOUTPUT:
+      txAck = prevTxStore_.output(details.tx_hash(), details.request_index());
+      break;
+   case bitcoin::TxRequest_RequestType_TXMETA:
+      txAck = prevTxStore_.meta(details.tx_hash());
+      break;
+   default:
+      break;
+   }
+
+   if (txAck) {
+      connectionManager_->GetLogger()->debug("[TrezorDevice] handleTxRequest {} #{} for prev hash {}"
+         , bitcoin::TxRequest_RequestType_Name(txRequest.request_type()), details.request_index()
+         , BinaryData::fromString(details.tx_hash()).toHexStr());
+      makeCall(*txAck);
+      return;
+   }
+
+   SPDLOG_LOGGER_ERROR(connectionManager_->GetLogger(), "can't find prev TX {} item #{}"
+      , BinaryData::fromString(details.tx_hash()).toHexStr(), details.request_index());
+   bitcoin::TxAck emptyAck;
+   switch (txRequest.request_type()) {
+   case bitcoin::TxRequest_RequestType_TXINPUT:
+      emptyAck.mutable_tx()->add_inputs();
+      break;
+   case bitcoin::TxRequest_RequestType_TXOUTPUT:
+      emptyAck.mutable_tx()->add_bin_outputs();
+      break;
+   default:
+      emptyAck.mutable_tx();
+      break;
    }
-   return Tx(supportingTxIt->second);
+   makeCall(emptyAck);
 }
 
 bool TrezorDevice::hasCapability(management::Features::Capability cap) const
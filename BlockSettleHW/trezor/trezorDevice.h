@@ -24,6 +24,8 @@
 #include "trezor/generated_proto/messages-bitcoin.pb.h"
 #include "trezor/generated_proto/messages.pb.h"
 
+#include "trezorPrevTxStore.h"
+
 
 class ConnectionManager;
 class QNetworkRequest;
@@ -91,9 +93,9 @@ private:
    void handleTxRequest(const MessageData& data);
    void sendTxMessage(const QString& status);
 
-   // Returns previous Tx for legacy inputs
+   // Answers request for previous Tx details (used for legacy inputs)
    // Trezor could request non-existing hash if wrong passphrase entered
-   Tx prevTx(const hw::trezor::messages::bitcoin::TxRequest &txRequest);
+   void makePrevTxCall(const hw::trezor::messages::bitcoin::TxRequest &txRequest);
 
 private:
    bool hasCapability(hw::trezor::messages::management::Features::Capability cap) const;
@@ -108,6 +110,7 @@ private:
    hw::trezor::messages::management::Features features_{};
    bool testNet_{};
    std::unique_ptr<bs::core::wallet::TXSignRequest> currentTxSignReq_;
+   TrezorPrevTxStore prevTxStore_;
    HWSignedTx awaitingTransaction_;
    HwWalletWrapper awaitingWalletInfo_;
 
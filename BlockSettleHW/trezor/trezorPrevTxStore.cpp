@@ -0,0 +1,85 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "trezorPrevTxStore.h"
+#include "CoreWallet.h"
+
+using namespace hw::trezor::messages;
+
+void TrezorPrevTxStore::prepare(const bs::core::wallet::TXSignRequest &txReq)
+{
+   entries_.clear();
+
+   for (const auto &supportingTx : txReq.supportingTXs) {
+      const Tx tx(supportingTx.second);
+      if (!tx.isInitialized()) {
+         continue;
+      }
+
+      Entry entry;
+      auto meta = entry.meta.mutable_tx();
+      meta->set_version(tx.getVersion());
+      meta->set_lock_time(tx.getLockTime());
+      meta->set_inputs_cnt(tx.getNumTxIn());
+      meta->set_outputs_cnt(tx.getNumTxOut());
+
+      entry.inputs.resize(tx.getNumTxIn());
+      for (size_t i = 0; i < tx.getNumTxIn(); ++i) {
+         const auto txIn = tx.getTxInCopy(static_cast<int>(i));
+         auto input = entry.inputs[i].mutable_tx()->add_inputs();
+         input->set_prev_hash(txIn.getOutPoint().getTxHash().copySwapEndian().toBinStr());
+         input->set_prev_index(txIn.getOutPoint().getTxOutIndex());
+         input->set_sequence(txIn.getSequence());
+         input->set_script_sig(txIn.getScript().toBinStr());
+      }
+
+      entry.outputs.resize(tx.getNumTxOut());
+      for (size_t i = 0; i < tx.getNumTxOut(); ++i) {
+         const auto txOut = tx.getTxOutCopy(static_cast<int>(i));
+         auto binOutput = entry.outputs[i].mutable_tx()->add_bin_outputs();
+         binOutput->set_amount(txOut.getValue());
+         binOutput->set_script_pubkey(txOut.getScript().toBinStr());
+      }
+
+      entries_[supportingTx.first.copySwapEndian().toBinStr()] = std::move(entry);
+   }
+}
+
+void TrezorPrevTxStore::clear()
+{
+   entries_.clear();
+}
+
+const TrezorPrevTxStore::TxAck *TrezorPrevTxStore::meta(const std::string &txHash) const
+{
+   const auto it = entries_.find(txHash);
+   if (it == entries_.end()) {
+      return nullptr;
+   }
+   return &it->second.meta;
+}
+
+const TrezorPrevTxStore::TxAck *TrezorPrevTxStore::input(const std::string &txHash, uint32_t index) const
+{
+   const auto it = entries_.find(txHash);
+   if ((it == entries_.end()) || (index >= it->second.inputs.size())) {
+      return nullptr;
+   }
+   return &it->second.inputs[index];
+}
+
+const TrezorPrevTxStore::TxAck *TrezorPrevTxStore::output(const std::string &txHash, uint32_t index) const
+{
+   const auto it = entries_.find(txHash);
+   if ((it == entries_.end()) || (index >= it->second.outputs.size())) {
+      return nullptr;
+   }
+   return &it->second.outputs[index];
+}
@@ -0,0 +1,59 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef TREZORPREVTXSTORE_H
+#define TREZORPREVTXSTORE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trezor/generated_proto/messages-bitcoin.pb.h"
+
+namespace bs {
+   namespace core {
+      namespace wallet {
+         struct TXSignRequest;
+      }
+   }
+}
+
+// Answers for device requests about previous TXs (TXMETA and TXINPUT/TXOUTPUT
+// with tx_hash set). Trezor walks every input and output of each previous TX
+// one request at a time, so supporting TXs are parsed once per signing and
+// all answers are prepared up front.
+class TrezorPrevTxStore
+{
+public:
+   using TxAck = hw::trezor::messages::bitcoin::TxAck;
+
+   void prepare(const bs::core::wallet::TXSignRequest &);
+   void clear();
+
+   // txHash is in the byte order used by device (reversed).
+   // Return nullptr if TX or its item is not known.
+   const TxAck *meta(const std::string &txHash) const;
+   const TxAck *input(const std::string &txHash, uint32_t index) const;
+   const TxAck *output(const std::string &txHash, uint32_t index) const;
+
+   size_t size() const { return entries_.size(); }
+
+private:
+   struct Entry
+   {
+      TxAck meta;
+      std::vector<TxAck> inputs;
+      std::vector<TxAck> outputs;
+   };
+
+   std::unordered_map<std::string, Entry> entries_;
+};
+
+#endif // TREZORPREVTXSTORE_H
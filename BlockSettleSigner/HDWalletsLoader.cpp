@@ -0,0 +1,135 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "HDWalletsLoader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <QDir>
+#include <QStringList>
+#include <spdlog/spdlog.h>
+#include "CoreHDWallet.h"
+
+namespace {
+   // Wallet loading is mostly disk and KDF bound - more threads don't help
+   const unsigned kMaxLoadThreads = 8;
+
+   const std::string kWalletFileSuffix = "_wallet.lmdb";
+}
+
+HDWalletsLoader::HDWalletsLoader(const std::shared_ptr<spdlog::logger> &logger, unsigned maxThreads)
+   : logger_(logger)
+   , maxThreads_(maxThreads)
+{
+   if (maxThreads_ == 0) {
+      maxThreads_ = std::min(std::max(std::thread::hardware_concurrency(), 1u), kMaxLoadThreads);
+   }
+}
+
+std::vector<std::string> HDWalletsLoader::walletFiles(const std::string &walletsDir)
+{
+   const QStringList filters = {
+      QString::fromStdString(bs::core::hd::Wallet::fileNamePrefix(false) + "*" + kWalletFileSuffix),
+      QString::fromStdString(bs::core::hd::Wallet::fileNamePrefix(true) + "*" + kWalletFileSuffix)
+   };
+   std::vector<std::string> result;
+   const auto entries = QDir(QString::fromStdString(walletsDir)).entryList(filters, QDir::Files, QDir::Name);
+   for (const auto &entry : entries) {
+      result.push_back(entry.toStdString());
+   }
+   return result;
+}
+
+HDWalletsLoader::Result HDWalletsLoader::load(NetworkType netType, const std::string &walletsDir
+   , const SecureBinaryData &ctrlPass, const CbLoaded &cbLoaded, const CbFailed &cbFailed) const
+{
+   Result result;
+   const auto fileNames = walletFiles(walletsDir);
+   if (fileNames.empty()) {
+      return result;
+   }
+
+   struct Item
+   {
+      std::string fileName;
+      WalletPtr   wallet;
+      std::string error;
+   };
+   std::mutex mutex;
+   std::condition_variable cv;
+   std::deque<Item> ready;
+   std::atomic<size_t> nextFile{ 0 };
+
+   const auto worker = [&] {
+      while (true) {
+         const size_t index = nextFile++;
+         if (index >= fileNames.size()) {
+            break;
+         }
+         Item item;
+         item.fileName = fileNames[index];
+         try {
+            item.wallet = std::make_shared<bs::core::hd::Wallet>(item.fileName, netType
+               , walletsDir, ctrlPass, logger_);
+         }
+         catch (const std::exception &e) {
+            item.error = e.what();
+         }
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(std::move(item));
+         }
+         cv.notify_one();
+      }
+   };
+
+   const auto nbThreads = std::min(static_cast<size_t>(maxThreads_), fileNames.size());
+   std::vector<std::thread> threads;
+   threads.reserve(nbThreads);
+   for (size_t i = 0; i < nbThreads; ++i) {
+      threads.emplace_back(worker);
+   }
+
+   for (size_t processed = 0; processed < fileNames.size(); ++processed) {
+      Item item;
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         cv.wait(lock, [&ready] { return !ready.empty(); });
+         item = std::move(ready.front());
+         ready.pop_front();
+      }
+
+      if (!item.wallet) {
+         SPDLOG_LOGGER_ERROR(logger_, "failed to load wallet {}: {}", item.fileName, item.error);
+         result.nbFailed++;
+         if (cbFailed) {
+            cbFailed(item.fileName, item.error);
+         }
+         continue;
+      }
+      if (item.wallet->networkType() != netType) {
+         SPDLOG_LOGGER_DEBUG(logger_, "skipping wallet {} for another network type", item.fileName);
+         result.nbSkipped++;
+         continue;
+      }
+      result.nbLoaded++;
+      if (cbLoaded) {
+         cbLoaded(item.wallet);
+      }
+   }
+
+   for (auto &thread : threads) {
+      thread.join();
+   }
+   return result;
+}
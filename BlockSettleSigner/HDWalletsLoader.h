@@ -0,0 +1,64 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef HD_WALLETS_LOADER_H
+#define HD_WALLETS_LOADER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BtcDefinitions.h"
+#include "SecureBinaryData.h"
+
+namespace spdlog {
+   class logger;
+}
+namespace bs {
+   namespace core {
+      namespace hd {
+         class Wallet;
+      }
+   }
+}
+
+// Opens HD wallet files from the wallets dir concurrently on a bounded number
+// of threads. Loaded wallets are passed to the callback on the thread that
+// called load() as soon as each of them is ready, so the caller doesn't need
+// any locking to register them.
+class HDWalletsLoader
+{
+public:
+   using WalletPtr = std::shared_ptr<bs::core::hd::Wallet>;
+   using CbLoaded = std::function<void(const WalletPtr &)>;
+   using CbFailed = std::function<void(const std::string &fileName, const std::string &error)>;
+
+   struct Result
+   {
+      size_t nbLoaded{ 0 };
+      size_t nbFailed{ 0 };
+      size_t nbSkipped{ 0 };  // wallets for another network type
+   };
+
+   // maxThreads == 0 means hardware concurrency (capped)
+   HDWalletsLoader(const std::shared_ptr<spdlog::logger> &, unsigned maxThreads = 0);
+
+   static std::vector<std::string> walletFiles(const std::string &walletsDir);
+
+   // Blocks until all wallet files are processed
+   Result load(NetworkType, const std::string &walletsDir, const SecureBinaryData &ctrlPass
+      , const CbLoaded &, const CbFailed & = nullptr) const;
+
+private:
+   std::shared_ptr<spdlog::logger>  logger_;
+   unsigned maxThreads_;
+};
+
+#endif // HD_WALLETS_LOADER_H
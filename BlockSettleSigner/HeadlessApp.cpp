@@ -14,6 +14,7 @@
    #include <unistd.h>
 #endif // WIN32
 
+#include <chrono>
 #include <fstream>
 #include <functional>
 #include <spdlog/spdlog.h>
@@ -405,46 +406,71 @@ void HeadlessAppObj::reloadWallets(bool notifyGUI, const std::function<void()> &
 {
    walletsMgr_->reset();
 
-   queue_->dispatch([notifyGUICopy = notifyGUI, cbCopy = std::move(cb), this]() {
-      auto cbProgress = [this](int cur, int total) {
-         logger_->debug("Loaded wallet {} of {}", cur, total);
-      };
-
+   queue_->dispatch([notifyGUI, cbCopy = std::move(cb), this]() {
       if (cbCopy) {
          cbCopy();
       }
 
-      bool ok = walletsMgr_->loadWallets(settings_->netType(), settings_->getWalletsDir()
-         , controlPassword(), cbProgress);
+      // Wallet files are opened in parallel. Each loaded wallet is added and
+      // published to GUI and terminal on the queue thread after this task,
+      // control password status and startup are completed after the last one.
+      const auto startTime = std::chrono::steady_clock::now();
+      const auto cbLoaded = [this] (const HDWalletsLoader::WalletPtr &wallet) {
+         queue_->dispatch([this, wallet] {
+            walletsMgr_->addWallet(wallet);
+            logger_->debug("Loaded wallet {} ({})", wallet->walletId(), walletsMgr_->getHDWalletsCount());
+            // Notifies terminal listener too
+            guiListener_->walletsListUpdated();
+         });
+      };
+
+      const HDWalletsLoader loader(logger_);
+      const auto result = loader.load(settings_->netType(), settings_->getWalletsDir()
+         , controlPassword(), cbLoaded);
 
-      if (ok) {
-         logger_->debug("Loaded {} wallet[s]", walletsMgr_->getHDWalletsCount());
-         if (controlPassword().getSize() == 0) {
-            controlPasswordStatus_ = signer::ControlPasswordStatus::RequestedNew;
-         }
-         else {
-            controlPasswordStatus_ = signer::ControlPasswordStatus::Accepted;
-         }
+      queue_->dispatch([this, notifyGUI, result, startTime] {
+         logger_->debug("Loaded {} wallet[s] in {} ms", result.nbLoaded
+            , std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+         onWalletsLoaded(notifyGUI, result);
+      });
+   });
+}
+
+void HeadlessAppObj::onWalletsLoaded(bool notifyGUI, const HDWalletsLoader::Result &result)
+{
+   if (result.nbSkipped) {
+      logger_->warn("{} wallet[s] for another network type were skipped", result.nbSkipped);
+   }
+
+   // Any wallet that can't be opened fails the whole load (as before the
+   // parallel loading), so the GUI asks for the control password again
+   // instead of silently working with a part of the wallets
+   const bool ok = (result.nbFailed == 0);
+   if (ok) {
+      if (controlPassword().getSize() == 0) {
+         controlPasswordStatus_ = signer::ControlPasswordStatus::RequestedNew;
       }
       else {
-         // wallets not loaded if control password wrong
-         // send message to gui to request it
-         logger_->warn("Control password required to decrypt wallets. Sending message to GUI");
-         controlPasswordStatus_ = signer::ControlPasswordStatus::Rejected;
+         controlPasswordStatus_ = signer::ControlPasswordStatus::Accepted;
       }
+   }
+   else {
+      // wallets not loaded if control password wrong
+      // send message to gui to request it
+      logger_->warn("{} of {} wallet[s] failed to load. Control password required to decrypt"
+         " wallets. Sending message to GUI", result.nbFailed, result.nbFailed + result.nbLoaded);
+      controlPasswordStatus_ = signer::ControlPasswordStatus::Rejected;
+   }
 
-      queue_->dispatch([this, notifyGUI = notifyGUICopy, okCopy = ok]() {
-         if (notifyGUI) {
-            guiListener_->sendControlPasswordStatusUpdate(controlPasswordStatus_);
-         }
-         terminalListener_->setNoWallets(okCopy && walletsMgr_->empty());
+   if (notifyGUI) {
+      guiListener_->sendControlPasswordStatusUpdate(controlPasswordStatus_);
+   }
+   terminalListener_->setNoWallets(ok && walletsMgr_->empty());
 
-         if (controlPasswordStatus_ != signer::Rejected) {
-            guiListener_->onStarted();
-            terminalListener_->syncWallet();
-         }
-      });
-   });
+   if (controlPasswordStatus_ != signer::Rejected) {
+      guiListener_->onStarted();
+      terminalListener_->syncWallet();
+   }
 }
 
 void HeadlessAppObj::setLimits(bs::signer::Limits limits)
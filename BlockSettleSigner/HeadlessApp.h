@@ -17,6 +17,7 @@
 
 #include "SignerDefs.h"
 #include "BSErrorCode.h"
+#include "HDWalletsLoader.h"
 
 namespace spdlog {
    class logger;
@@ -79,6 +80,7 @@ private:
    void startTerminalsProcessing();
    void stopTerminalsProcessing();
    void applyNewControlPassword(const SecureBinaryData &controlPassword, bool notifyGui);
+   void onWalletsLoaded(bool notifyGUI, const HDWalletsLoader::Result &);
 
 private:
    std::shared_ptr<spdlog::logger>  logger_;
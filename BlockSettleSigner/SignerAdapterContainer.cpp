@@ -72,7 +72,7 @@ void SignAdapterContainer::syncHDWallet(const std::string &id, const std::functi
 void SignAdapterContainer::syncWallet(const std::string &id, const std::function<void(bs::sync::WalletData)> &cb)
 {
    signer::SyncWalletRequest request;
-   request.set_wallet_id(id);
+   request.set_wallet_id(listener_->walletSyncId(id));
    const auto reqId = listener_->send(signer::SyncWalletType, request.SerializeAsString());
    listener_->setWalletDataCb(reqId, cb);
 }
@@ -10,6 +10,8 @@
 */
 #include "SignerAdapterListener.h"
 
+#include <algorithm>
+#include <future>
 #include <spdlog/spdlog.h>
 
 #include "BSErrorCode.h"
@@ -25,6 +27,7 @@
 #include "Settings/HeadlessSettings.h"
 #include "StringUtils.h"
 #include "SystemFileUtils.h"
+#include "WalletSyncVersion.h"
 #include "ZMQ_BIP15X_ServerConnection.h"
 
 using namespace Blocksettle::Communication;
@@ -333,9 +336,133 @@ bool SignerAdapterListener::onSignOfflineTxRequest(const std::string &data, bs::
 
    // implication: all input leaves should belong to one hdWallet
    const auto hdWallet = walletsMgr_->getHDRootForLeaf(txSignReq.walletIds.front());
+   if (!hdWallet) {
+      logger_->error("[SignerAdapterListener::{}] failed to find root wallet for leaf {}"
+         , __func__, txSignReq.walletIds.front());
+      evt.set_errorcode((int)bs::error::ErrorCode::TxInvalidRequest);
+      return sendData(signer::SignOfflineTxRequestType, evt.SerializeAsString(), reqId);
+   }
+
+   // Requests which are already queued (pipelined by the client) are signed
+   // together, see processSignRequests
+   pendingSignRequests_.push_back({ reqId, hdWallet, std::move(txSignReq)
+      , SecureBinaryData::fromString(request.password()) });
+   if (pendingSignRequests_.size() == 1) {
+      queue_->dispatch([this] {
+         processSignRequests();
+      });
+   }
+   return true;
+}
+
+void SignerAdapterListener::processSignRequests()
+{
+   const auto requests = std::move(pendingSignRequests_);
+   pendingSignRequests_.clear();
+
+   // Requests for the same wallet with the same password make a signing
+   // session: wallet is unlocked once for all of them. Sessions for the same
+   // wallet are run one after another as they unlock the same wallet object,
+   // different wallets are independent and are signed concurrently.
+   struct Session
+   {
+      SecureBinaryData     password;
+      std::vector<size_t>  requests;
+   };
+   struct WalletSessions
+   {
+      std::shared_ptr<bs::core::hd::Wallet>  hdWallet;
+      std::vector<Session> sessions;
+   };
+   std::vector<WalletSessions> wallets;
+   size_t nbSessions = 0;
+   for (size_t i = 0; i < requests.size(); ++i) {
+      const auto &request = requests[i];
+      auto itWallet = std::find_if(wallets.begin(), wallets.end(), [&request](const WalletSessions &wallet) {
+         return (wallet.hdWallet == request.hdWallet);
+      });
+      if (itWallet == wallets.end()) {
+         wallets.push_back({ request.hdWallet, {} });
+         itWallet = std::prev(wallets.end());
+      }
+      auto &sessions = itWallet->sessions;
+      auto itSession = std::find_if(sessions.begin(), sessions.end(), [&request](const Session &session) {
+         return (session.password == request.password);
+      });
+      if (itSession == sessions.end()) {
+         sessions.push_back({ request.password, {} });
+         itSession = std::prev(sessions.end());
+         nbSessions++;
+      }
+      itSession->requests.push_back(i);
+   }
+
+   // Leaf wallets for multi-wallet requests are resolved here, on the queue
+   // thread: walletsMgr_ could be changed by the next queued task while the
+   // workers below are running, so they get only the resolved wallets.
+   std::vector<std::vector<std::shared_ptr<bs::core::Wallet>>> inputWallets(requests.size());
+   for (size_t i = 0; i < requests.size(); ++i) {
+      const auto &txSignReq = requests[i].txSignReq;
+      if (txSignReq.walletIds.size() == 1) {
+         continue;
+      }
+      inputWallets[i].reserve(txSignReq.inputs.size());
+      for (const auto &input : txSignReq.inputs) {
+         inputWallets[i].push_back(walletsMgr_->getWalletByAddress(bs::Address::fromUTXO(input)));
+      }
+   }
+
+   std::vector<signer::SignTxEvent> results(requests.size());
+   const auto signWallet = [this, &requests, &inputWallets, &results](const WalletSessions &wallet) {
+      for (const auto &session : wallet.sessions) {
+         try {
+            const bs::core::WalletPasswordScoped lock(wallet.hdWallet, session.password);
+            for (const auto i : session.requests) {
+               results[i] = signOfflineTx(wallet.hdWallet, requests[i].txSignReq, inputWallets[i]);
+            }
+         }
+         catch (const std::exception &e) {
+            logger_->error("[SignerAdapterListener::processSignRequests] failed to unlock wallet {}: {}"
+               , wallet.hdWallet->walletId(), e.what());
+            for (const auto i : session.requests) {
+               results[i].set_errorcode((int)bs::error::ErrorCode::InvalidPassword);
+            }
+         }
+      }
+   };
+
+   if (wallets.size() == 1) {
+      signWallet(wallets.front());
+   }
+   else {
+      std::vector<std::future<void>> futures;
+      futures.reserve(wallets.size());
+      for (const auto &wallet : wallets) {
+         futures.push_back(std::async(std::launch::async, signWallet, std::cref(wallet)));
+      }
+      for (auto &future : futures) {
+         future.get();
+      }
+   }
+
+   if (requests.size() > 1) {
+      logger_->debug("[SignerAdapterListener::{}] signed {} TX[s] in {} session[s]"
+         , __func__, requests.size(), nbSessions);
+   }
+   for (size_t i = 0; i < requests.size(); ++i) {
+      sendData(signer::SignOfflineTxRequestType, results[i].SerializeAsString(), requests[i].reqId);
+   }
+}
+
+// Should be called with hdWallet unlocked. inputWallets has a leaf wallet
+// (or null if not found) for each input of a multi-wallet request.
+signer::SignTxEvent SignerAdapterListener::signOfflineTx(const std::shared_ptr<bs::core::hd::Wallet> &hdWallet
+   , const bs::core::wallet::TXSignRequest &txSignReq
+   , const std::vector<std::shared_ptr<bs::core::Wallet>> &inputWallets) const
+{
+   signer::SignTxEvent evt;
    try {
       if (txSignReq.walletIds.size() == 1) {
-         bs::core::WalletPasswordScoped lock(hdWallet, SecureBinaryData::fromString(request.password()));
          BinaryData signedTx = hdWallet->signTXRequestWithWallet(txSignReq);
          evt.set_signedtx(signedTx.toBinStr());
       }
@@ -351,33 +478,30 @@ bool SignerAdapterListener::onSignOfflineTxRequest(const std::string &data, bs::
          multiReq.RBF = txSignReq.RBF;
 
          bs::core::WalletMap wallets;
-         for (const auto &input : txSignReq.inputs) {
-            const auto addr = bs::Address::fromUTXO(input);
-            const auto wallet = walletsMgr_->getWalletByAddress(addr);
+         for (size_t i = 0; i < txSignReq.inputs.size(); ++i) {
+            const auto &input = txSignReq.inputs[i];
+            const auto &wallet = inputWallets.at(i);
             if (!wallet) {
                logger_->error("[{}] failed to find wallet for input address {}"
-                  , __func__, addr.display());
+                  , __func__, bs::Address::fromUTXO(input).display());
                evt.set_errorcode((int)bs::error::ErrorCode::WrongAddress);
-               return sendData(signer::SignOfflineTxRequestType, evt.SerializeAsString(), reqId);
+               return evt;
             }
             multiReq.addInput(input, wallet->walletId());
             wallets[wallet->walletId()] = wallet;
          }
-         {
-            const bs::core::WalletPasswordScoped passLock(hdWallet, SecureBinaryData::fromString(request.password()));
-            const auto tx = bs::core::SignMultiInputTX(multiReq, wallets);
-            evt.set_signedtx(tx.toBinStr());
-         }
+         const auto tx = bs::core::SignMultiInputTX(multiReq, wallets);
+         evt.set_signedtx(tx.toBinStr());
       }
       evt.set_errorcode((int)bs::error::ErrorCode::NoError);
-      return sendData(signer::SignOfflineTxRequestType, evt.SerializeAsString(), reqId);
+      return evt;
    }
    catch (const std::exception &e) {
       logger_->error("[SignerAdapterListener::{}] sign error: {}"
          , __func__, e.what());
    }
    evt.set_errorcode((int)bs::error::ErrorCode::InvalidPassword);
-   return sendData(signer::SignOfflineTxRequestType, evt.SerializeAsString(), reqId);
+   return evt;
 }
 
 bool SignerAdapterListener::onSyncWalletInfo(bs::signer::RequestId reqId)
@@ -435,29 +559,64 @@ bool SignerAdapterListener::onSyncWallet(const std::string &data, bs::signer::Re
       logger_->error("[SignerAdapterListener::{}] failed to parse request", __func__);
       return false;
    }
-   const auto wallet = walletsMgr_->getWalletById(request.wallet_id());
+   const auto version = bs::signer::WalletSyncVersion::fromId(request.wallet_id());
+   const auto wallet = walletsMgr_->getWalletById(version.walletId);
    if (!wallet) {
       logger_->error("[SignerAdapterListener::{}] failed to find wallet with id {}"
-         , __func__, request.wallet_id());
+         , __func__, version.walletId);
       return false;
    }
    const auto rootWallet = walletsMgr_->getHDRootForLeaf(wallet->walletId());
    if (!rootWallet) {
       logger_->error("[SignerAdapterListener::{}] failed to find root wallet for leaf {}"
-         , __func__, request.wallet_id());
+         , __func__, version.walletId);
       return false;
    }
 
+   // Bring the log up to date - new used addresses are appended to it. If some
+   // logged address is not used anymore (wallet was re-created) the log is
+   // rebuilt in a new epoch and the client gets a full sync.
+   auto &syncLog = syncLogs_[wallet->walletId()];
+   const auto usedAddresses = wallet->getUsedAddressList();
+   std::vector<bs::Address> newAddresses;
+   size_t nbKnown = 0;
+   for (const auto &addr : usedAddresses) {
+      if (syncLog.known.find(addr.display()) != syncLog.known.end()) {
+         nbKnown++;
+      }
+      else {
+         newAddresses.push_back(addr);
+      }
+   }
+   if (syncLog.epoch.empty() || (nbKnown != syncLog.entries.size())) {
+      syncLog.epoch = CryptoPRNG::generateRandom(8).toHexStr();
+      syncLog.entries.clear();
+      syncLog.known.clear();
+      newAddresses = usedAddresses;
+   }
+   for (const auto &addr : newAddresses) {
+      const auto addrStr = addr.display();
+      syncLog.entries.push_back({ addrStr, wallet->getAddressIndex(addr) });
+      syncLog.known.insert(addrStr);
+   }
+
+   bs::signer::WalletSyncVersion respVersion;
+   respVersion.walletId = wallet->walletId();
+   respVersion.epoch = syncLog.epoch;
+   respVersion.seq = syncLog.entries.size();
+   if ((version.epoch == syncLog.epoch) && (version.seq <= syncLog.entries.size())) {
+      respVersion.baseSeq = version.seq;
+   }
+
    signer::SyncWalletResponse response;
-   response.set_wallet_id(wallet->walletId());
+   response.set_wallet_id(respVersion.toResponseId());
    response.set_highest_ext_index(wallet->getExtAddressCount());
    response.set_highest_int_index(wallet->getIntAddressCount());
 
-   for (const auto &addr : wallet->getUsedAddressList()) {
-      const auto index = wallet->getAddressIndex(addr);
+   for (size_t i = respVersion.baseSeq; i < syncLog.entries.size(); ++i) {
       auto address = response.add_addresses();
-      address->set_address(addr.display());
-      address->set_index(index);
+      address->set_address(syncLog.entries[i].first);
+      address->set_index(syncLog.entries[i].second);
    }
    return sendData(signer::SyncWalletType, response.SerializeAsString(), reqId);
 }
@@ -12,6 +12,10 @@
 #define SIGNER_ADAPTER_LISTENER_H
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "CoreWallet.h"
 #include "SignerDefs.h"
 #include "ServerConnectionListener.h"
@@ -77,6 +81,10 @@ protected:
       , Blocksettle::Communication::signer::PacketType, bs::signer::RequestId reqId = 0);
 
    bool onSignOfflineTxRequest(const std::string &data, bs::signer::RequestId);
+   void processSignRequests();
+   signer::SignTxEvent signOfflineTx(const std::shared_ptr<bs::core::hd::Wallet> &
+      , const bs::core::wallet::TXSignRequest &
+      , const std::vector<std::shared_ptr<bs::core::Wallet>> &inputWallets) const;
    bool onSyncWalletInfo(bs::signer::RequestId);
    bool onSyncHDWallet(const std::string &data, bs::signer::RequestId);
    bool onSyncWallet(const std::string &data, bs::signer::RequestId);
@@ -115,6 +123,24 @@ private:
    std::unique_ptr<HeadlessContainerCallbacksImpl> callbacks_;
    bool started_{false};
 
+   // Append-only log of used addresses sent for each leaf (see WalletSyncVersion)
+   struct LeafSyncLog
+   {
+      std::string epoch;
+      std::vector<std::pair<std::string, std::string>>  entries;  // address, index
+      std::unordered_set<std::string>  known;
+   };
+   std::unordered_map<std::string, LeafSyncLog> syncLogs_;
+
+   struct SignRequest
+   {
+      bs::signer::RequestId   reqId;
+      std::shared_ptr<bs::core::hd::Wallet>  hdWallet;
+      bs::core::wallet::TXSignRequest  txSignReq;
+      SecureBinaryData        password;
+   };
+   std::vector<SignRequest>   pendingSignRequests_;
+
 };
 
 #endif // SIGNER_ADAPTER_LISTENER_H
@@ -25,6 +25,7 @@
 
 #include "SignerInterfaceListener.h"
 #include "SignerAdapterContainer.h"
+#include "WalletSyncVersion.h"
 #include <memory>
 
 using namespace bs::sync;
@@ -430,6 +431,18 @@ void SignerInterfaceListener::onSyncHDWallet(const std::string &data, bs::signer
    cbHDWalletData_.erase(itCb);
 }
 
+std::string SignerInterfaceListener::walletSyncId(const std::string &walletId) const
+{
+   bs::signer::WalletSyncVersion version;
+   version.walletId = walletId;
+   const auto itSynced = syncedWallets_.find(walletId);
+   if (itSynced != syncedWallets_.end()) {
+      version.epoch = itSynced->second.epoch;
+      version.seq = itSynced->second.seq;
+   }
+   return version.toRequestId();
+}
+
 void SignerInterfaceListener::onSyncWallet(const std::string &data, bs::signer::RequestId reqId)
 {
    signer::SyncWalletResponse response;
@@ -443,17 +456,36 @@ void SignerInterfaceListener::onSyncWallet(const std::string &data, bs::signer::
          , __func__, reqId);
       return;
    }
-   bs::sync::WalletData result;
 
-   result.highestExtIndex = response.highest_ext_index();
-   result.highestIntIndex = response.highest_int_index();
+   const auto version = bs::signer::WalletSyncVersion::fromId(response.wallet_id());
+   auto &synced = syncedWallets_[version.walletId];
+   if (version.baseSeq == 0) {
+      synced.data.addresses.clear();
+   }
+   else if ((synced.epoch != version.epoch) || (synced.seq != version.baseSeq)) {
+      // Versions diverged - fall back to full sync
+      logger_->warn("[SignerInterfaceListener::{}] unexpected sync version for {}, requesting full sync"
+         , __func__, version.walletId);
+      syncedWallets_.erase(version.walletId);
+      signer::SyncWalletRequest request;
+      request.set_wallet_id(version.walletId);
+      const auto newReqId = send(signer::SyncWalletType, request.SerializeAsString());
+      cbWalletData_[newReqId] = std::move(itCb->second);
+      cbWalletData_.erase(reqId);
+      return;
+   }
+
+   synced.epoch = version.epoch;
+   synced.seq = version.seq;
+   synced.data.highestExtIndex = response.highest_ext_index();
+   synced.data.highestIntIndex = response.highest_int_index();
 
    for (int i = 0; i < response.addresses_size(); ++i) {
       const auto addr = response.addresses(i);
-      result.addresses.push_back({ addr.index()
+      synced.data.addresses.push_back({ addr.index()
          , bs::Address::fromAddressString(addr.address()), {} });
    }
-   itCb->second(result);
+   itCb->second(synced.data);
    cbWalletData_.erase(itCb);
 }
 
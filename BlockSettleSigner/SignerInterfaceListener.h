@@ -21,6 +21,7 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <unordered_map>
 
 namespace bs {
    namespace signer {
@@ -71,6 +72,8 @@ public:
    void setWalletDataCb(bs::signer::RequestId reqId, const std::function<void(bs::sync::WalletData)> &cb) {
       cbWalletData_[reqId] = cb;
    }
+   // Wallet ID with last synced version to request only changes since then
+   std::string walletSyncId(const std::string &walletId) const;
    void setWatchOnlyCb(bs::signer::RequestId reqId, const std::function<void(const bs::sync::WatchingOnlyWallet &)> &cb) {
       cbWO_[reqId] = cb;
    }
@@ -175,6 +178,14 @@ private:
 
    std::queue<std::string> decryptWalletRequestsQueue_;
 
+   struct SyncedWallet
+   {
+      std::string epoch;
+      uint64_t    seq{ 0 };
+      bs::sync::WalletData data;
+   };
+   std::unordered_map<std::string, SyncedWallet>   syncedWallets_;
+
    bool isWalletsSynchronized_{false};
 
 };
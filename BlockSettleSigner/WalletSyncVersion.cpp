@@ -0,0 +1,80 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "WalletSyncVersion.h"
+
+#include <vector>
+
+using namespace bs::signer;
+
+namespace {
+   const char kVersionSeparator = '#';
+   const char kFieldSeparator = ':';
+
+   uint64_t toSeq(const std::string &str)
+   {
+      try {
+         return std::stoull(str);
+      }
+      catch (const std::exception &) {
+         return 0;
+      }
+   }
+}
+
+std::string WalletSyncVersion::toRequestId() const
+{
+   if (epoch.empty()) {
+      return walletId;
+   }
+   return walletId + kVersionSeparator + epoch + kFieldSeparator + std::to_string(seq);
+}
+
+std::string WalletSyncVersion::toResponseId() const
+{
+   return walletId + kVersionSeparator + epoch + kFieldSeparator + std::to_string(baseSeq)
+      + kFieldSeparator + std::to_string(seq);
+}
+
+WalletSyncVersion WalletSyncVersion::fromId(const std::string &id)
+{
+   WalletSyncVersion result;
+   const auto pos = id.find(kVersionSeparator);
+   result.walletId = id.substr(0, pos);
+   if (pos == std::string::npos) {
+      return result;
+   }
+
+   std::vector<std::string> fields;
+   size_t start = pos + 1;
+   while (true) {
+      const auto end = id.find(kFieldSeparator, start);
+      fields.push_back(id.substr(start, end - start));
+      if (end == std::string::npos) {
+         break;
+      }
+      start = end + 1;
+   }
+
+   switch (fields.size()) {
+   case 2:
+      result.epoch = fields[0];
+      result.seq = toSeq(fields[1]);
+      break;
+   case 3:
+      result.epoch = fields[0];
+      result.baseSeq = toSeq(fields[1]);
+      result.seq = toSeq(fields[2]);
+      break;
+   default:
+      break;
+   }
+   return result;
+}
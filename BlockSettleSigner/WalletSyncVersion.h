@@ -0,0 +1,42 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef WALLET_SYNC_VERSION_H
+#define WALLET_SYNC_VERSION_H
+
+#include <cstdint>
+#include <string>
+
+namespace bs {
+   namespace signer {
+
+      // Version of the leaf state for incremental sync between signer and its
+      // GUI adapter. It travels in wallet_id field of SyncWalletRequest as
+      // "<walletId>#<epoch>:<seq>" and of SyncWalletResponse as
+      // "<walletId>#<epoch>:<baseSeq>:<seq>". Signer keeps an append-only log
+      // of used addresses per leaf and starts a new epoch when it rebuilds the
+      // log. Response with baseSeq 0 is a full sync, otherwise it contains only
+      // the addresses logged after baseSeq. Plain wallet ID requests full sync.
+      struct WalletSyncVersion
+      {
+         std::string walletId;
+         std::string epoch;
+         uint64_t    baseSeq{ 0 };
+         uint64_t    seq{ 0 };
+
+         std::string toRequestId() const;
+         std::string toResponseId() const;
+         static WalletSyncVersion fromId(const std::string &);
+      };
+
+   }  // namespace signer
+}  // namespace bs
+
+#endif // WALLET_SYNC_VERSION_H
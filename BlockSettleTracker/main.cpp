@@ -13,12 +13,63 @@
 #include <spdlog/sinks/daily_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 
 #include "ArmoryConnection.h"
 #include "BsTrackerVersion.h"
 #include "ColoredCoinServer.h"
 #include "ZMQ_BIP15X_ServerConnection.h"
 
+namespace {
+
+   const auto kArmoryConnectTimeout = std::chrono::seconds(60);
+
+   bool isArmoryConnected(ArmoryState state)
+   {
+      return (state == ArmoryState::Connected) || (state == ArmoryState::Ready);
+   }
+
+   // Wakes up main thread on armory state changes instead of polling the state
+   class TrackerACT : public ArmoryCallbackTarget
+   {
+   public:
+      ~TrackerACT() override { cleanup(); }
+
+      void onStateChanged(ArmoryState state) override
+      {
+         {
+            std::lock_guard<std::mutex> lock(mutex_);
+            state_ = state;
+         }
+         stateChanged_.notify_all();
+      }
+
+      // Returns last reported state once it matches the predicate or timeout expires
+      ArmoryState waitFor(const std::function<bool(ArmoryState)> &pred
+         , std::chrono::seconds timeout)
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         stateChanged_.wait_for(lock, timeout, [this, &pred] { return pred(state_); });
+         return state_;
+      }
+
+      ArmoryState wait(const std::function<bool(ArmoryState)> &pred)
+      {
+         std::unique_lock<std::mutex> lock(mutex_);
+         stateChanged_.wait(lock, [this, &pred] { return pred(state_); });
+         return state_;
+      }
+
+   private:
+      std::mutex              mutex_;
+      std::condition_variable stateChanged_;
+      ArmoryState             state_{ ArmoryState::Offline };
+   };
+
+} // namespace
+
 int main(int argc, char** argv) {
    auto logger = spdlog::stdout_color_mt("stdout logger");
 
@@ -114,6 +165,8 @@ int main(int argc, char** argv) {
    SPDLOG_LOGGER_INFO(logger, "own key: {}", ownKey.toHexStr());
 
    auto armory = std::make_shared<ArmoryConnection>(logger);
+   auto act = std::make_unique<TrackerACT>();
+   act->init(armory.get());
 
    auto armoryKeyCb = [logger, armoryKey, armoryKeyParsed](const BinaryData &key, const std::string &name) -> bool {
       SPDLOG_LOGGER_INFO(logger, "got new armory public key: {}", key.toHexStr());
@@ -126,12 +179,12 @@ int main(int argc, char** argv) {
    };
 
    armory->setupConnection(testnet ? NetworkType::TestNet : NetworkType::MainNet, armoryHost, std::to_string(armoryPort), ownKeyPath, {}, {}, armoryKeyCb);
-   auto now = std::chrono::steady_clock::now();
-   while (std::chrono::steady_clock::now() - now < std::chrono::seconds(60) && armory->state() != ArmoryState::Connected) {
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-   }
+   const auto armoryState = act->waitFor([](ArmoryState state) {
+      return isArmoryConnected(state) || (state == ArmoryState::Error)
+         || (state == ArmoryState::Cancelled);
+   }, kArmoryConnectTimeout);
 
-   if (armory->state() != ArmoryState::Connected) {
+   if (!isArmoryConnected(armoryState)) {
       SPDLOG_LOGGER_CRITICAL(logger, "can't connect to armory, quit now");
       exit(EXIT_FAILURE);
    }
@@ -149,12 +202,9 @@ int main(int argc, char** argv) {
       exit(EXIT_FAILURE);
    }
 
-   while (true) {
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-
-      if (armory->state() != ArmoryState::Ready && armory->state() != ArmoryState::Connected) {
-         SPDLOG_LOGGER_CRITICAL(logger, "connection to armory closed unexpectedly");
-         exit(EXIT_FAILURE);
-      }
-   }
+   act->wait([](ArmoryState state) {
+      return !isArmoryConnected(state);
+   });
+   SPDLOG_LOGGER_CRITICAL(logger, "connection to armory closed unexpectedly");
+   exit(EXIT_FAILURE);
 }
@@ -11,8 +11,10 @@
 #include "AddressDetailsWidget.h"
 #include "ui_AddressDetailsWidget.h"
 
-#include <QDateTime>
+#include <algorithm>
+#include <QSortFilterProxyModel>
 
+#include "AddressTransactionsModel.h"
 #include "AddressVerificator.h"
 #include "CheckRecipSigner.h"
 #include "ColoredCoinLogic.h"
@@ -37,12 +39,12 @@ AddressDetailsWidget::AddressDetailsWidget(QWidget *parent)
    // sets column resizing to fixed
    //ui_->treeAddressTransactions->header()->setSectionResizeMode(QHeaderView::Fixed);
 
-   // tell CustomTreeWidget for which column the cursor becomes a hand cursor
-   ui_->treeAddressTransactions->handCursorColumns_.append(colTxId);
+   // tell CustomTreeView for which column the cursor becomes a hand cursor
+   ui_->treeAddressTransactions->handCursorColumns_.append(AddressTransactionsModel::ColumnTxId);
    // allow TxId column to be copied to clipboard with right click
-   ui_->treeAddressTransactions->copyToClipboardColumns_.append(colTxId);
+   ui_->treeAddressTransactions->copyToClipboardColumns_.append(AddressTransactionsModel::ColumnTxId);
 
-   connect(ui_->treeAddressTransactions, &QTreeWidget::itemClicked,
+   connect(ui_->treeAddressTransactions, &QAbstractItemView::clicked,
            this, &AddressDetailsWidget::onTxClicked);
 }
 
@@ -59,6 +61,28 @@ void AddressDetailsWidget::init(const std::shared_ptr<ArmoryConnection> &armory
    ccResolver_ = resolver;
    walletsMgr_ = walletsMgr;
 
+   model_ = new AddressTransactionsModel(armory_, logger_, this);
+   model_->setAmountFormatter([this](const bs::TXEntry &entry, bool &isValid) {
+      if (ccFound_.security.empty()) {
+         return UiUtils::displayAmount(entry.value);
+      }
+      if (!isCcTx(entry)) {
+         // Mark invalid CC transactions
+         isValid = false;
+         return UiUtils::displayAmount(entry.value);
+      }
+      const auto ccAmount = entry.value / int64_t(ccFound_.lotSize);
+      return tr("%1 %2").arg(QString::number(ccAmount)).arg(QString::fromStdString(ccFound_.security));
+   });
+   connect(model_, &AddressTransactionsModel::pageLoaded, this, &AddressDetailsWidget::onPageLoaded);
+   connect(model_, &AddressTransactionsModel::txsResolved, this, &AddressDetailsWidget::onTxsResolved);
+
+   proxyModel_ = new QSortFilterProxyModel(this);
+   proxyModel_->setSourceModel(model_);
+   proxyModel_->setSortRole(AddressTransactionsModel::SortRole);
+   ui_->treeAddressTransactions->setModel(proxyModel_);
+   ui_->treeAddressTransactions->sortByColumn(AddressTransactionsModel::ColumnDate, Qt::DescendingOrder);
+
    act_ = make_unique<AddrDetailsACT>(this);
    act_->init(armory_.get());
 }
@@ -89,6 +113,7 @@ void AddressDetailsWidget::setQueryAddr(const bs::Address &inAddrVal)
       currentAddr_ = inAddrVal;
       currentAddrStr_ = currentAddr_.display();
    }
+   searchForGenesisAddr();
 
    // Armory can't directly take an address and return all the required data.
    // Work around this by creating a dummy wallet, adding the explorer address,
@@ -137,7 +162,7 @@ void AddressDetailsWidget::updateFields()
    ui_->addressId->setText(QString::fromStdString(currentAddrStr_));
 }
 
-void AddressDetailsWidget::searchForCC()
+void AddressDetailsWidget::searchForGenesisAddr()
 {
    for (const auto &ccSecurity : ccResolver_->securities()) {
       const auto &genesisAddr = ccResolver_->genesisAddrFor(ccSecurity);
@@ -148,11 +173,15 @@ void AddressDetailsWidget::searchForCC()
          return;
       }
    }
+}
 
+// Called for each resolved page until CC is found
+void AddressDetailsWidget::searchForCC(const AsyncClient::TxBatchResult &txs)
+{
    // If currentAddr_ was a valid CC address then it must been a valid CC outpoint at least once.
    // Collect possible candidates here.
    std::map<BinaryData, uint32_t> outPoints;
-   for (const auto &txPair : txMap_) {
+   for (const auto &txPair : txs) {
       const auto &tx = txPair.second;
       if (!tx || !tx->isInitialized()) {
          continue;
@@ -202,259 +231,138 @@ void AddressDetailsWidget::searchForAuth()
    addrVerify_->startAddressVerification();
 }
 
-// The function that gathers all the data to place in the UI.
-void AddressDetailsWidget::loadTransactions()
+bool AddressDetailsWidget::isCcTx(const bs::TXEntry &entry) const
 {
-   CustomTreeWidget *tree = ui_->treeAddressTransactions;
-   tree->clear();
-
-   uint64_t totCount = 0;
-
-   searchForCC();
-   const bool isCcAddress = !ccFound_.security.empty();
-
-   // Go through each TXEntry object and calculate all required UI data.
-   for (const auto &curTXEntry : txEntryHashSet_) {
-      QTreeWidgetItem *item = new QTreeWidgetItem(tree);
-
-      auto tx = txMap_[curTXEntry.first];
-      if (!tx || !tx->isInitialized()) {
-         SPDLOG_LOGGER_WARN(logger_, "TX with hash {} is not found or not inited"
-            , curTXEntry.first.toHexStr(true));
-         continue;
-      }
+   // isTxHashValidHistory is not absolutly accurate to detect invalid CC transactions but should be good enough
+   return !ccFound_.security.empty() && (ccFound_.isGenesisAddr
+      || (ccFound_.tracker && ccFound_.tracker->isTxHashValidHistory(entry.txHash)));
+}
 
-      // Get fees & fee/byte by looping through the prev Tx set and calculating.
-      uint64_t totIn = 0;
-      for (size_t r = 0; r < tx->getNumTxIn(); ++r) {
-         TxIn in = tx->getTxInCopy(r);
-         OutPoint op = in.getOutPoint();
-         const auto &prevTx = txMap_[op.getTxHash()];
-         if (prevTx->isInitialized()) {
-            TxOut prevOut = prevTx->getTxOutCopy(op.getTxOutIndex());
-            totIn += prevOut.getValue();
-         }
-         else {
-            SPDLOG_LOGGER_WARN(logger_, "prev TX with hash {} is not found or is notinitialized"
-               , op.getTxHash().toHexStr(true));
-         }
-      }
-      uint64_t fees = totIn - tx->getSumOfOutputs();
-      double feePerByte = (double)fees / (double)tx->getTxWeight();
-
-      // Populate the transaction entries.
-      item->setText(colDate,
-                    UiUtils::displayDateTime(QDateTime::fromTime_t(curTXEntry.second.txTime)));
-      item->setText(colTxId, // Flip Armory's TXID byte order: internal -> RPC
-                    QString::fromStdString(curTXEntry.first.toHexStr(true)));
-      item->setData(colConfs, Qt::DisplayRole, armory_->getConfirmationsNumber(curTXEntry.second.blockNum));
-      item->setText(colInputsNum, QString::number(tx->getNumTxIn()));
-      item->setText(colOutputsNum, QString::number(tx->getNumTxOut()));
-      item->setText(colFees, UiUtils::displayAmount(fees));
-      item->setText(colFeePerByte, QString::number(std::nearbyint(feePerByte)));
-      item->setText(colTxSize, QString::number(tx->getSize()));
-
-      // isTxHashValidHistory is not absolutly accurate to detect invalid CC transactions but should be good enough
-      const bool isCcTx = isCcAddress && (ccFound_.isGenesisAddr || (ccFound_.tracker && ccFound_.tracker->isTxHashValidHistory(curTXEntry.second.txHash)));
-
-      if (!isCcTx) {
-         item->setText(colOutputAmt, UiUtils::displayAmount(curTXEntry.second.value));
-      } else {
-         const auto ccAmount = curTXEntry.second.value / int64_t(ccFound_.lotSize);
-         item->setText(colOutputAmt, tr("%1 %2").arg(QString::number(ccAmount)).arg(QString::fromStdString(ccFound_.security)));
+// Check the total received or sent.
+// Account only valid TXs for CC address.
+void AddressDetailsWidget::addToTotals(const bs::TXEntry &entry)
+{
+   if (ccFound_.security.empty()) {
+      if (entry.value > 0) {
+         totalReceived_ += entry.value;
       }
-      item->setTextAlignment(colOutputAmt, Qt::AlignRight);
-
-      QFont font = item->font(colOutputAmt);
-      font.setBold(true);
-      item->setFont(colOutputAmt, font);
-
-      if (isCcAddress && !isCcTx) {
-         // Mark invalid CC transactions
-         item->setTextColor(colOutputAmt, Qt::red);
+      else {
+         totalSpent_ -= entry.value; // Negative, so fake that out.
       }
-
-      // Check the total received or sent.
-      // Account only valid TXs for CC address.
-      if (!isCcAddress) {
-         if (curTXEntry.second.value > 0) {
-            totalReceived_ += curTXEntry.second.value;
-         }
-         else {
-            totalSpent_ -= curTXEntry.second.value; // Negative, so fake that out.
-         }
-      } else if (isCcTx) {
-         if (curTXEntry.second.value > 0) {
-            totalReceived_ += curTXEntry.second.value / int64_t(ccFound_.lotSize);
-         }
-         else {
-            totalSpent_ -= curTXEntry.second.value / int64_t(ccFound_.lotSize);
-         }
+   } else if (isCcTx(entry)) {
+      if (entry.value > 0) {
+         totalReceived_ += entry.value / int64_t(ccFound_.lotSize);
       }
-      totCount++;
-
-      // Detect if this is an auth address
-      if (curTXEntry.second.value == kAuthAddrValue) {
-         for (size_t i = 0; i < tx->getNumTxOut(); ++i) {
-            const auto &txOut = tx->getTxOutCopy(static_cast<int>(i));
-            try {
-               const auto addr = bs::Address::fromTxOut(txOut);
-               if (bsAuthAddrs_.find(addr.display()) != bsAuthAddrs_.end()) {
-                  isAuthAddr_ = true;
-                  AddressDetailsWidget::searchForAuth();
-                  break;
-               }
-            } catch (const std::exception &e) {
-               SPDLOG_LOGGER_ERROR(logger_, "auth address detection failed: {}", e.what());
-            }
-         }
+      else {
+         totalSpent_ -= entry.value / int64_t(ccFound_.lotSize);
       }
-
-      setConfirmationColor(item);
-      tree->addTopLevelItem(item);
    }
+}
 
-   if (!isCcAddress) {
-      ui_->totalReceived->setText(UiUtils::displayAmount(totalReceived_));
-      ui_->totalSent->setText(UiUtils::displayAmount(totalSpent_));
-      ui_->balance->setText(UiUtils::displayAmount(totalReceived_ - totalSpent_));
-   } else {
-      ui_->totalReceived->setText(QString::number(totalReceived_));
-      ui_->totalSent->setText(QString::number(totalSpent_));
-      ui_->balance->setText(QString::number(totalReceived_ - totalSpent_));
+// Needed only once CC is detected after some pages were accounted
+void AddressDetailsWidget::recalcTotals()
+{
+   totalReceived_ = 0;
+   totalSpent_ = 0;
+   for (int i = 0; i < model_->rowCount(); ++i) {
+      addToTotals(model_->entry(i));
    }
-
-   emit finished();
-
-   // Set up the display for total rcv'd/spent.
-   ui_->transactionCount->setText(QString::number(totCount));
-
-   updateFields();
-
-   tree->resizeColumns();
 }
 
-// This function sets the confirmation column to the correct color based
-// on the number of confirmations that are set inside the column.
-void AddressDetailsWidget::setConfirmationColor(QTreeWidgetItem *item)
+void AddressDetailsWidget::updateTotals()
 {
-   auto conf = item->text(colConfs).toInt();
-   QBrush brush;
-   if (conf == 0) {
-      brush.setColor(Qt::red);
+   // Received and sent cover only loaded pages until the view is scrolled
+   // to the end, so they are marked as partial until then
+   const bool isPartial = model_->hasMorePages();
+   const auto setPartialValue = [isPartial](QLabel *label, const QString &value) {
+      label->setText(isPartial ? tr("%1+").arg(value) : value);
+      label->setToolTip(isPartial ? tr("Only loaded transactions are accounted") : QString());
+   };
+
+   if (ccFound_.security.empty()) {
+      setPartialValue(ui_->totalReceived, UiUtils::displayAmount(totalReceived_));
+      setPartialValue(ui_->totalSent, UiUtils::displayAmount(totalSpent_));
+   } else {
+      setPartialValue(ui_->totalReceived, QString::number(totalReceived_));
+      setPartialValue(ui_->totalSent, QString::number(totalSpent_));
    }
-   else if (conf >= 1 && conf <= 5) {
-      brush.setColor(Qt::darkYellow);
+
+   // Balance and TX count are exact as they come from Armory
+   if (!isBalanceLoaded_) {
+      return;
    }
-   else {
-      brush.setColor(Qt::darkGreen);
+   if (ccFound_.security.empty()) {
+      ui_->balance->setText(UiUtils::displayAmount(static_cast<int64_t>(addrBalance_)));
+   } else {
+      ui_->balance->setText(QString::number(ccFound_.lotSize ? (addrBalance_ / ccFound_.lotSize) : 0));
    }
-   item->setForeground(colConfs, brush);
+   ui_->transactionCount->setText(QString::number(addrTxN_));
 }
 
-void AddressDetailsWidget::onTxClicked(QTreeWidgetItem *item, int column)
+void AddressDetailsWidget::onPageLoaded(const std::vector<bs::TXEntry> &entries)
 {
-   // user has clicked the transaction column of the item so
-   // send a signal to ExplorerWidget to open TransactionDetailsWidget
-   if (column == colTxId) {
-      emit(transactionClicked(item->text(colTxId)));
+   for (const auto &entry : entries) {
+      addToTotals(entry);
+   }
+   updateTotals();
+   updateFields();
+
+   if (!isFirstPageLoaded_) {
+      isFirstPageLoaded_ = true;
+      if (entries.empty()) {
+         SPDLOG_LOGGER_INFO(logger_, "address participates in no TXs");
+      }
+      ui_->treeAddressTransactions->resizeColumns();
+      emit finished();
    }
 }
 
-// Used in refresh. The callback used when getting a ledger delegate (pages)
-// from Armory. Processes the data as needed.
-void AddressDetailsWidget::getTxData(const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate)
+void AddressDetailsWidget::onTxsResolved(const AsyncClient::TxBatchResult &txs)
 {
-   // The callback that handles previous Tx objects attached to the TxIn objects
-   // and processes them. Once done, the UI can be changed.
-   const auto &cbCollectPrevTXs = [this]
-      (const AsyncClient::TxBatchResult &prevTxs, std::exception_ptr)
-   {
-      txMap_.insert(prevTxs.cbegin(), prevTxs.cend());
-      // We're finally ready to display all the transactions.
-      loadTransactions();
-   };
-
-   // Callback used to process Tx objects obtained from Armory. Used primarily
-   // to obtain Tx entries for the TxIn objects we're checking.
-   const auto &cbCollectTXs = [this, cbCollectPrevTXs]
-      (const AsyncClient::TxBatchResult &txs, std::exception_ptr)
-   {
-      std::set<BinaryData> prevTxHashSet; // Prev Tx hashes for an addr (fee calc).
-      for (const auto &tx : txs) {
-         if (!tx.second) {
-            continue;
-         }
-         txMap_[tx.first] = tx.second;
-
-         // While here, we need to get the prev Tx with the UTXO being spent.
-         // This is done so that we can calculate fees later.
-         for (size_t i = 0; i < tx.second->getNumTxIn(); i++) {
-            TxIn in = tx.second->getTxInCopy(i);
-            OutPoint op = in.getOutPoint();
-            const auto &itTX = txMap_.find(op.getTxHash());
-            if (itTX == txMap_.end()) {
-               prevTxHashSet.insert(op.getTxHash());
-            }
-         }
+   if (ccFound_.security.empty()) {
+      searchForCC(txs);
+      if (!ccFound_.security.empty()) {
+         recalcTotals();
+         updateTotals();
+         updateFields();
+         model_->refreshAmounts();
       }
-      if (prevTxHashSet.empty()) {
-         SPDLOG_LOGGER_WARN(logger_, "failed to get previous TXs");
-         loadTransactions();
-      }
-      else {
-         armory_->getTXsByHash(prevTxHashSet, cbCollectPrevTXs, true);
-      }
-   };
+   }
 
-   // Callback to process ledger entries (pages) from the ledger delegate. Gets
-   // Tx entries from Armory.
-   const auto &cbLedger = [this, cbCollectTXs]
-      (ReturnMessage<std::vector<ClientClasses::LedgerEntry>> entries)
-   {
-      auto result = std::make_shared<std::vector<ClientClasses::LedgerEntry>>();
-      try {
-         *result = entries.get();
-      }
-      catch (const std::exception &e) {
-         SPDLOG_LOGGER_ERROR(logger_, "Return data error - {}", e.what());
-         return;
+   if (isAuthAddr_) {
+      return;
+   }
+   // Detect if this is an auth address
+   for (const auto &txPair : txs) {
+      const auto &tx = txPair.second;
+      const auto entry = model_->findEntry(txPair.first);
+      if (!entry || (entry->value != kAuthAddrValue) || !tx || !tx->isInitialized()) {
+         continue;
       }
-
-      // Process entries on main thread because this callback is called from background
-      QMetaObject::invokeMethod(this, [this, cbCollectTXs, result] {
-         std::set<BinaryData> txHashSet; // Hashes assoc'd with a given address.
-
-         // Get the hash and TXEntry object for each relevant Tx hash.
-         for (const auto &entry : *result) {
-            BinaryData searchHash(entry.getTxHash());
-            const auto &itTX = txMap_.find(searchHash);
-            if (itTX == txMap_.end()) {
-               txHashSet.insert(searchHash);
-               txEntryHashSet_[searchHash] = bs::TXEntry::fromLedgerEntry(entry);
+      for (size_t i = 0; i < tx->getNumTxOut(); ++i) {
+         const auto &txOut = tx->getTxOutCopy(static_cast<int>(i));
+         try {
+            const auto addr = bs::Address::fromTxOut(txOut);
+            if (bsAuthAddrs_.find(addr.display()) != bsAuthAddrs_.end()) {
+               isAuthAddr_ = true;
+               searchForAuth();
+               updateFields();
+               return;
             }
+         } catch (const std::exception &e) {
+            SPDLOG_LOGGER_ERROR(logger_, "auth address detection failed: {}", e.what());
          }
-         if (txHashSet.empty()) {
-            SPDLOG_LOGGER_INFO(logger_, "address participates in no TXs");
-            cbCollectTXs({}, nullptr);
-         } else {
-            armory_->getTXsByHash(txHashSet, cbCollectTXs, true);
-         }
-      });
-   };
-
-   const auto &cbPageCnt = [this, delegate, cbLedger] (ReturnMessage<uint64_t> pageCnt) {
-      try {
-         uint64_t inPageCnt = pageCnt.get();
-         for(uint64_t i = 0; i < inPageCnt; i++) {
-            delegate->getHistoryPage(uint32_t(i), cbLedger);
-         }
-      }
-      catch (const std::exception &e) {
-         SPDLOG_LOGGER_ERROR(logger_, "Return data error (getPageCount) - {}", e.what());
       }
-   };
-   delegate->getPageCount(cbPageCnt);
+   }
+}
+
+void AddressDetailsWidget::onTxClicked(const QModelIndex &index)
+{
+   // user has clicked the transaction column of the item so
+   // send a signal to ExplorerWidget to open TransactionDetailsWidget
+   if (index.column() == AddressTransactionsModel::ColumnTxId) {
+      emit(transactionClicked(index.data().toString()));
+   }
 }
 
 // Function that grabs the TX data for the address. Used in callback.
@@ -469,13 +377,39 @@ void AddressDetailsWidget::refresh(const std::shared_ptr<bs::sync::PlainWallet>
 
    // Process TX data for the "first" (i.e., only) address in the wallet.
    const auto &cbLedgerDelegate = [this](const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate) {
-      getTxData(delegate);
+      // Pages are loaded by the model on demand
+      QMetaObject::invokeMethod(this, [this, delegate] {
+         totalReceived_ = 0;
+         totalSpent_ = 0;
+         isFirstPageLoaded_ = false;
+         model_->setLedgerDelegate(delegate);
+      });
    };
    const auto addr = wallet->getUsedAddressList().at(0);
    if (!wallet->getLedgerDelegateForAddress(addr, cbLedgerDelegate)) {
       SPDLOG_LOGGER_DEBUG(logger_, "failed to get ledger delegate for wallet ID {} - address {}"
          , wallet->walletId(), addr.display());
    }
+
+   wallet->onBalanceAvailable([this, wallet, addr] {
+      const auto balances = wallet->getAddrBalance(addr);
+      const uint64_t balance = balances.empty() ? 0 : balances[0];
+      const uint64_t txN = wallet->getAddrTxN(addr);
+      QMetaObject::invokeMethod(this, [this, walletId = wallet->walletId(), balance, txN] {
+         // Another address could be queried meanwhile
+         const bool isCurrent = std::any_of(dummyWallets_.cbegin(), dummyWallets_.cend()
+            , [&walletId](const std::pair<const std::string, std::shared_ptr<bs::sync::PlainWallet>> &dummyWallet) {
+            return dummyWallet.second->walletId() == walletId;
+         });
+         if (!isCurrent) {
+            return;
+         }
+         addrBalance_ = balance;
+         addrTxN_ = txN;
+         isBalanceLoaded_ = true;
+         updateTotals();
+      });
+   });
 }
 
 // Called when Armory has finished registering a wallet. Kicks off the function
@@ -503,15 +437,19 @@ void AddressDetailsWidget::clear()
    }
    totalReceived_ = 0;
    totalSpent_ = 0;
+   addrBalance_ = 0;
+   addrTxN_ = 0;
+   isBalanceLoaded_ = false;
+   isFirstPageLoaded_ = false;
    dummyWallets_.clear();
-   txMap_.clear();
-   txEntryHashSet_.clear();
+   if (model_) {
+      model_->clear();
+   }
    ccFound_ = {};
    isAuthAddr_ = false;
    authAddrStates_.clear();
 
    ui_->addressId->clear();
-   ui_->treeAddressTransactions->clear();
 
    const auto &loading = tr("Loading...");
    ui_->balance->setText(loading);
@@ -28,9 +28,10 @@ namespace bs {
       class WalletsManager;
    }
 }
+class AddressTransactionsModel;
 class AddressVerificator;
 class ColoredCoinTrackerClient;
-class QTreeWidgetItem;
+class QSortFilterProxyModel;
 
 
 class AddressDetailsWidget : public QWidget
@@ -49,46 +50,33 @@ public:
    void setBSAuthAddrs(const std::unordered_set<std::string> &bsAuthAddrs);
    void clear();
 
-   enum AddressTreeColumns {
-      colDate,
-      colTxId,
-      colConfs,
-      colInputsNum,
-      colOutputsNum,
-      colOutputAmt,
-      colFees,
-      colFeePerByte,
-      colTxSize
-   };
-
 signals:
    void transactionClicked(QString txId);
    void finished() const;
 
 private slots:
-   void onTxClicked(QTreeWidgetItem *item, int column);
+   void onTxClicked(const QModelIndex &index);
    void OnRefresh(std::vector<BinaryData> ids, bool online);
    void updateFields();
+   void onPageLoaded(const std::vector<bs::TXEntry> &entries);
+   void onTxsResolved(const AsyncClient::TxBatchResult &txs);
 
 private:
-   void setConfirmationColor(QTreeWidgetItem *item);
-   void getTxData(const std::shared_ptr<AsyncClient::LedgerDelegate> &);
    void refresh(const std::shared_ptr<bs::sync::PlainWallet> &);
-   void loadTransactions();
-   void searchForCC();
+   void searchForGenesisAddr();
+   void searchForCC(const AsyncClient::TxBatchResult &txs);
    void searchForAuth();
+   bool isCcTx(const bs::TXEntry &) const;
+   void addToTotals(const bs::TXEntry &);
+   void recalcTotals();
+   void updateTotals();
 
 private:
-   // NB: Right now, the code is slightly inefficient. There are two maps with
-   // hashes for keys. One has transactions (Armory), and TXEntry objects (BS).
-   // This is due to the manner in which we retrieve data from Armory. Pages are
-   // returned for addresses, and we then retrieve the appropriate Tx objects
-   // from Armory. (Tx searches go directly to Tx object retrieval.) The thing
-   // is that the pages are what have data related to # of confs and other
-   // block-related data. The Tx objects from Armory don't have block-related
-   // data that we need. So, we need two maps, at least for now.
+   // Ledger pages and their TXs are loaded by AddressTransactionsModel as the
+   // view scrolls, so received and spent totals cover the pages loaded so
+   // far. Balance and TX count are obtained from Armory for the whole address.
    //
-   // In addition, note that the TX hashes returned by Armory are in "internal"
+   // Note that the TX hashes returned by Armory are in "internal"
    // byte order, whereas the displayed values need to be in "RPC" byte order.
    // (Look at the BinaryTXID class comments for more info on this phenomenon.)
    // The only time we care about this is when displaying data to the user; the
@@ -109,9 +97,13 @@ private:
    std::string    currentAddrStr_;
    std::int64_t totalSpent_{};
    std::int64_t totalReceived_{};
+   uint64_t       addrBalance_{};
+   uint64_t       addrTxN_{};
+   bool           isBalanceLoaded_{false};
+   bool           isFirstPageLoaded_{false};
    std::unordered_map<std::string, std::shared_ptr<bs::sync::PlainWallet>> dummyWallets_;
-   AsyncClient::TxBatchResult txMap_; // A wallet's Tx hash / Tx map.
-   std::map<BinaryData, bs::TXEntry> txEntryHashSet_; // A wallet's Tx hash / Tx entry map.
+   AddressTransactionsModel   *model_{};
+   QSortFilterProxyModel      *proxyModel_{};
 
    std::shared_ptr<ArmoryConnection>   armory_;
    std::shared_ptr<spdlog::logger>     logger_;
@@ -13,9 +13,20 @@
 #include <QApplication>
 #include <QColor>
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "Wallets/SyncWalletsManager.h"
 #include "UiUtils.h"
 
+namespace {
+   // Wallets with more used addresses than this are shown in lazy mode
+   const size_t kLazyModeThreshold = 5000;
+
+   // Number of materialized rows kept - should cover a few screens of the view
+   const size_t kRowCacheSize = 512;
+}
+
 bool AddressListModel::AddressRow::isMultiLineComment() const
 {
    const auto commentLines = comment.split(QLatin1Char('\n'));
@@ -39,13 +50,39 @@ QString AddressListModel::AddressRow::getAddress() const
    return UiUtils::displayAddress(displayedAddress);
 }
 
+std::string AddressListModel::AddressRow::key() const
+{
+   std::string result = wallet ? wallet->walletId() : std::string{};
+   result.push_back(':');
+   if (address.isValid()) {
+      result.append(address.prefixed().toBinStr());
+   }
+   return result;
+}
+
+void AddressListModel::AddressRow::fillStrings()
+{
+   if (!wallet) {
+      return;
+   }
+   if (wltType == bs::core::wallet::Type::Authentication) {
+      comment = AddressListModel::tr("Authentication PubKey");
+      const BinaryData rootId;
+      displayedAddress = rootId.empty() ? AddressListModel::tr("empty") : QString::fromStdString(BtcUtils::base58_encode(rootId));
+   }
+   else {
+      comment = QString::fromStdString(wallet->getAddressComment(address));
+      displayedAddress = QString::fromStdString(address.display());
+      walletName = QString::fromStdString(wallet->shortName());
+      walletId = QString::fromStdString(wallet->walletId());
+   }
+}
+
 bool AddressListModel::AddressRow::operator==(const AddressRow& other) const
 {
    return  wallet.get() == other.wallet.get() &&
       address == other.address &&
       bytes == other.bytes &&
-      transactionCount == other.transactionCount &&
-      balance == other.balance &&
       comment == other.comment &&
       displayedAddress == other.displayedAddress &&
       walletName == other.walletName &&
@@ -94,21 +131,14 @@ AddressListModel::AddressRow AddressListModel::createRow(const bs::Address &addr
    row.address = addr;
    row.transactionCount = -1;
    row.balance = 0;
+   row.wltType = wallet->type();
 
-   if (wallet->type() == bs::core::wallet::Type::Authentication) {
-      row.comment = tr("Authentication PubKey");
-      const BinaryData rootId;
-      row.displayedAddress = rootId.empty() ? tr("empty") : QString::fromStdString(BtcUtils::base58_encode(rootId));
+   if (row.wltType == bs::core::wallet::Type::Authentication) {
       row.isExternal = true;
    }
    else {
-      row.comment = QString::fromStdString(wallet->getAddressComment(addr));
-      row.displayedAddress = QString::fromStdString(addr.display());
-      row.walletName = QString::fromStdString(wallet->shortName());
-      row.walletId = QString::fromStdString(wallet->walletId());
       row.isExternal = wallet->isExternalAddress(addr);
    }
-   row.wltType = wallet->type();
    return row;
 }
 
@@ -130,16 +160,100 @@ void AddressListModel::updateData(const std::string &walletId)
       updateWallet(wallet, newAddresses);
    }
 
-   if (addressRows_.size() != newAddresses.size() || 
-      !std::equal(addressRows_.begin(), addressRows_.end(), newAddresses.begin())) {
-      
+   const bool lazyMode = (newAddresses.size() > kLazyModeThreshold);
+   const bool lazyModeChanged = (lazyMode != lazyMode_);
+   lazyMode_ = lazyMode;
+   if (!lazyMode_) {
+      for (auto &row : newAddresses) {
+         row.fillStrings();
+      }
+   }
+
+   applyRows(std::move(newAddresses), lazyModeChanged);
+   if (lazyMode_) {
+      refreshRowCache();
+   }
+   else {
+      clearRowCache();
+   }
+   updateWalletData();
+
+   processing_.store(false);
+}
+
+void AddressListModel::applyRows(std::vector<AddressRow> &&newRows, bool forceReset)
+{
+   std::unordered_map<std::string, size_t> newPos;
+   newPos.reserve(newRows.size());
+   for (size_t i = 0; i < newRows.size(); ++i) {
+      newPos[newRows[i].key()] = i;
+   }
+
+   size_t nbRetained = 0;
+   bool isOrdered = true;
+   size_t prevPos = 0;
+   for (const auto &row : addressRows_) {
+      const auto itPos = newPos.find(row.key());
+      if (itPos == newPos.end()) {
+         continue;
+      }
+      // Remaining rows are expected to keep their relative order (new addresses
+      // are only appended to address chains)
+      if (nbRetained && (itPos->second <= prevPos)) {
+         isOrdered = false;
+      }
+      prevPos = itPos->second;
+      ++nbRetained;
+   }
+
+   // Reset if there's little to keep (initial load, wallet selection changed)
+   // or the order differs, but keep already known balances until fresh ones arrive
+   if (forceReset || !isOrdered || (nbRetained * 2 < addressRows_.size()) || addressRows_.empty()) {
+      std::unordered_map<std::string, std::pair<int, uint64_t>> known;
+      for (const auto &row : addressRows_) {
+         known[row.key()] = { row.transactionCount, row.balance };
+      }
+      for (auto &row : newRows) {
+         const auto itKnown = known.find(row.key());
+         if (itKnown != known.end()) {
+            row.transactionCount = itKnown->second.first;
+            row.balance = itKnown->second.second;
+         }
+      }
       beginResetModel();
-      addressRows_ = std::move(newAddresses);
+      addressRows_ = std::move(newRows);
       endResetModel();
-      updateWalletData();
+      return;
    }
 
-   processing_.store(false);
+   for (size_t i = addressRows_.size(); i > 0; --i) {
+      const int row = static_cast<int>(i - 1);
+      if (newPos.find(addressRows_[row].key()) == newPos.end()) {
+         beginRemoveRows(QModelIndex(), row, row);
+         addressRows_.erase(addressRows_.begin() + row);
+         endRemoveRows();
+      }
+   }
+
+   // Merge: each row is either already at its place or is a new one
+   for (size_t i = 0; i < newRows.size(); ++i) {
+      auto &newRow = newRows[i];
+      const int row = static_cast<int>(i);
+      if ((i < addressRows_.size()) && (addressRows_[i].key() == newRow.key())) {
+         auto &curRow = addressRows_[i];
+         newRow.transactionCount = curRow.transactionCount;
+         newRow.balance = curRow.balance;
+         if (!(curRow == newRow)) {
+            curRow = std::move(newRow);
+            emit dataChanged(index(row, 0), index(row, ColumnsNbMultiple - 1));
+         }
+      }
+      else {
+         beginInsertRows(QModelIndex(), row, row);
+         addressRows_.insert(addressRows_.begin() + row, std::move(newRow));
+         endInsertRows();
+      }
+   }
 }
 
 void AddressListModel::updateWallet(const std::shared_ptr<bs::sync::Wallet> &wallet, std::vector<AddressRow> &addresses)
@@ -178,7 +292,6 @@ void AddressListModel::updateWallet(const std::shared_ptr<bs::sync::Wallet> &wal
 
          auto row = createRow(addr, wallet);
          row.addrIndex = i;
-         row.comment = QString::fromStdString(wallet->getAddressComment(addr));
 
          addresses.emplace_back(std::move(row));
       }
@@ -187,78 +300,91 @@ void AddressListModel::updateWallet(const std::shared_ptr<bs::sync::Wallet> &wal
 
 void AddressListModel::updateWalletData()
 {
-   auto nbTxNs = std::make_shared<int>((int)addressRows_.size());
-   auto nbBalances = std::make_shared<int>((int)addressRows_.size());
-
-   auto addrTxNs = std::make_shared<std::vector<uint32_t>>();
-   addrTxNs->resize(addressRows_.size());
-   auto addrBalances = std::make_shared<std::vector<uint64_t>>();
-   addrBalances->resize(addressRows_.size());
+   // Balances and #tx are fetched per wallet in one go and applied to the model
+   // in a single GUI thread pass instead of 2 queued calls per address
+   std::map<std::shared_ptr<bs::sync::Wallet>, std::pair<std::vector<bs::Address>
+      , std::vector<std::string>>> walletAddresses;
+   for (const auto &row : addressRows_) {
+      if (!row.wallet) {
+         continue;
+      }
+      auto &addrList = walletAddresses[row.wallet];
+      addrList.first.push_back(row.address);
+      addrList.second.push_back(row.key());
+   }
 
-   for (size_t i = 0; i < addressRows_.size(); ++i) {
-      // Callback for address's # of TXs.
-      const auto &cbTxN = [this, addrTxNs, i, nbTxNs](uint64_t txn) {
-         QMetaObject::invokeMethod(qApp, [this, handle = validityFlag_.handle(), i, nbTxNs, addrTxNs, txn] {
-            --(*nbTxNs);
-            if (i >= addressRows_.size()) {
-               return;
-            }
-            (*addrTxNs)[i] = txn;
-
-            // On the final address, set the TX count for all addresses and emit
-            // any required signals.
-            if (*nbTxNs <= 0) {
-               for (size_t j = 0; j < std::min(addressRows_.size(), addrTxNs->size()); ++j) {
-                  addressRows_[j].transactionCount = (*addrTxNs)[j];
-               }
-               emit dataChanged(index(0, ColumnTxCount)
-                  , index(addressRows_.size() - 1, ColumnTxCount));
-            }
-         });
-      };
+   for (auto &walletAddrs : walletAddresses) {
+      const auto wallet = walletAddrs.first;
+      auto addresses = std::make_shared<std::vector<bs::Address>>(std::move(walletAddrs.second.first));
+      auto keys = std::make_shared<std::vector<std::string>>(std::move(walletAddrs.second.second));
+
+      wallet->onBalanceAvailable([this, handle = validityFlag_.handle(), wallet, addresses, keys]() mutable {
+         auto txns = std::make_shared<std::vector<uint32_t>>();
+         auto balances = std::make_shared<std::vector<uint64_t>>();
+         txns->reserve(addresses->size());
+         balances->reserve(addresses->size());
+         for (const auto &address : *addresses) {
+            txns->push_back(static_cast<uint32_t>(wallet->getAddrTxN(address)));
+            const auto addrBalances = wallet->getAddrBalance(address);
+            balances->push_back((addrBalances.size() == 3) ? addrBalances[0] : 0);
+         }
 
-      // Callback for address's balance.
-      const auto &cbBalance = [this, handle = validityFlag_.handle(), addrBalances, i, nbBalances](std::vector<uint64_t> balances) {
-         QMetaObject::invokeMethod(qApp, [this, handle, balances, addrBalances, i, nbBalances] {
+         QMetaObject::invokeMethod(qApp, [this, handle, wallet, keys, txns, balances] {
             if (!handle.isValid()) {
                return;
             }
-            --(*nbBalances);
-            if (i >= addressRows_.size()) {
-               return;
-            }
-            if (balances.size() == 3) {
-               (*addrBalances)[i] = balances[0];
-            }
-            else {
-               (*addrBalances)[i] = 0;
-            }
-
-            // On the final address, set the balance for all addresses and emit
-            // any required signals.
-            if (*nbBalances <= 0) {
-               for (size_t j = 0;
-                    j < std::min(addressRows_.size(), addrBalances->size());
-                    ++j) {
-                  addressRows_[j].balance = (*addrBalances)[j];
-               }
-               emit dataChanged(index(0, ColumnBalance)
-                  , index(static_cast<int>(addressRows_.size()) - 1, ColumnBalance));
-            }
+            applyBalances(wallet, *keys, *txns, *balances);
          });
-      };
+      });
+   }
+}
 
-      // Get an address's balance & # of TXs from Armory via the wallet.
-      const auto &wallet = addressRows_[i].wallet;
-      const auto &address = addressRows_[i].address;
-      if (!wallet) {
-         return;
+void AddressListModel::applyBalances(const std::shared_ptr<bs::sync::Wallet> &wallet
+   , const std::vector<std::string> &keys, const std::vector<uint32_t> &txns
+   , const std::vector<uint64_t> &balances)
+{
+   // Rows could have been changed since the request was sent - match them by key
+   std::unordered_map<std::string, size_t> values;
+   values.reserve(keys.size());
+   for (size_t i = 0; i < keys.size(); ++i) {
+      values[keys[i]] = i;
+   }
+
+   // Changed rows are notified in contiguous runs, so that proxies re-filter
+   // only the rows that actually changed
+   int firstRow = -1;
+   int lastRow = -1;
+   const auto flushChanged = [this, &firstRow, &lastRow] {
+      if (firstRow >= 0) {
+         emit dataChanged(index(firstRow, ColumnTxCount), index(lastRow, ColumnBalance));
       }
-      wallet->onBalanceAvailable([wallet, address, cbTxN, cbBalance] {
-         cbTxN(wallet->getAddrTxN(address));
-         cbBalance(wallet->getAddrBalance(address));
-      });
+      firstRow = lastRow = -1;
+   };
+   for (size_t i = 0; i < addressRows_.size(); ++i) {
+      auto &row = addressRows_[i];
+      if (row.wallet != wallet) {
+         continue;
+      }
+      const auto itValue = values.find(row.key());
+      if (itValue == values.end()) {
+         continue;
+      }
+      const int txn = static_cast<int>(txns[itValue->second]);
+      const auto balance = balances[itValue->second];
+      if ((row.transactionCount == txn) && (row.balance == balance)) {
+         continue;
+      }
+      row.transactionCount = txn;
+      row.balance = balance;
+      if ((firstRow >= 0) && (lastRow + 1 != static_cast<int>(i))) {
+         flushChanged();
+      }
+      if (firstRow < 0) {
+         firstRow = static_cast<int>(i);
+      }
+      lastRow = static_cast<int>(i);
    }
+   flushChanged();
 }
 
 void AddressListModel::removeEmptyIntAddresses()
@@ -291,6 +417,85 @@ void AddressListModel::removeEmptyIntAddresses()
    processing_.store(false);
 }
 
+AddressListModel::AddressRow AddressListModel::rowAt(int row) const
+{
+   auto result = addressRows_[row];
+   if (!lazyMode_) {
+      return result;
+   }
+
+   const auto key = result.key();
+   const auto itCache = rowCacheIndex_.find(key);
+   if (itCache != rowCacheIndex_.end()) {
+      rowCache_.splice(rowCache_.begin(), rowCache_, itCache->second);
+   }
+   else {
+      result.fillStrings();
+      rowCache_.emplace_front(key, RowStrings{ result.comment, result.displayedAddress
+         , result.walletName, result.walletId });
+      rowCacheIndex_[key] = rowCache_.begin();
+      if (rowCache_.size() > kRowCacheSize) {
+         rowCacheIndex_.erase(rowCache_.back().first);
+         rowCache_.pop_back();
+      }
+      return result;
+   }
+
+   const auto &strings = rowCache_.front().second;
+   result.comment = strings.comment;
+   result.displayedAddress = strings.displayedAddress;
+   result.walletName = strings.walletName;
+   result.walletId = strings.walletId;
+   return result;
+}
+
+void AddressListModel::clearRowCache()
+{
+   rowCache_.clear();
+   rowCacheIndex_.clear();
+}
+
+void AddressListModel::refreshRowCache()
+{
+   // Comments could have been changed - refetch strings of materialized rows
+   // only and notify about the cells that actually differ
+   if (rowCache_.empty()) {
+      return;
+   }
+   for (size_t i = 0; i < addressRows_.size(); ++i) {
+      const auto itCache = rowCacheIndex_.find(addressRows_[i].key());
+      if (itCache == rowCacheIndex_.end()) {
+         continue;
+      }
+      auto row = addressRows_[i];
+      row.fillStrings();
+      auto &strings = itCache->second->second;
+
+      int firstColumn = -1;
+      int lastColumn = -1;
+      const auto markChanged = [&firstColumn, &lastColumn](int column) {
+         if ((firstColumn < 0) || (column < firstColumn)) {
+            firstColumn = column;
+         }
+         lastColumn = std::max(lastColumn, column);
+      };
+      if (strings.displayedAddress != row.displayedAddress) {
+         markChanged(ColumnAddress);
+      }
+      if (strings.comment != row.comment) {
+         markChanged(ColumnComment);
+      }
+      if (strings.walletName != row.walletName) {
+         markChanged(ColumnWallet);
+      }
+      if (firstColumn < 0) {
+         continue;
+      }
+      strings = RowStrings{ row.comment, row.displayedAddress, row.walletName, row.walletId };
+      emit dataChanged(index(static_cast<int>(i), firstColumn), index(static_cast<int>(i), lastColumn));
+   }
+}
+
 int AddressListModel::columnCount(const QModelIndex &) const
 {
    if (wallets_.empty()) {
@@ -388,7 +593,36 @@ QVariant AddressListModel::data(const QModelIndex& index, int role) const
       return {};
    }
 
-   const auto row = addressRows_[index.row()];
+   // Roles used to filter and sort every row are served from raw fields
+   // without materializing row strings in lazy mode
+   const auto &rawRow = addressRows_[index.row()];
+   switch (role) {
+      case TxCountRole:
+         return rawRow.transactionCount;
+
+      case BalanceRole:
+         return QVariant::fromValue<qlonglong>(rawRow.balance);
+
+      case AddrIndexRole:
+         return static_cast<unsigned int>(rawRow.addrIndex);
+
+      case IsExternalRole:
+         return rawRow.isExternal;
+
+      case SortRole:
+         if (index.column() == ColumnBalance) {
+            return QVariant::fromValue<qlonglong>(rawRow.balance);
+         }
+         else if (index.column() == ColumnTxCount) {
+            return rawRow.transactionCount;
+         }
+         break;
+
+      default:
+         break;
+   }
+
+   const auto row = rowAt(index.row());
 
    switch (role) {
       case Qt::DisplayRole:
@@ -397,12 +631,6 @@ QVariant AddressListModel::data(const QModelIndex& index, int role) const
       case WalletIdRole:
          return row.walletId;
 
-      case AddrIndexRole:
-         return static_cast<unsigned int>(row.addrIndex);
-
-      case IsExternalRole:
-         return row.isExternal;
-
       case AddressRole:
          return row.displayedAddress;
 
@@ -413,13 +641,7 @@ QVariant AddressListModel::data(const QModelIndex& index, int role) const
          break;
 
       case SortRole:
-         if (index.column() == ColumnBalance) {
-            return QVariant::fromValue<qlonglong>(row.balance);
-         }
-         else {
-            return dataForRow(row, index.column());
-         }
-         break;
+         return dataForRow(row, index.column());
 
       case Qt::TextColorRole:
 /*         if (!row.isExternal) {
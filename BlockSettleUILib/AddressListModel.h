@@ -11,8 +11,10 @@
 #ifndef ADDRESSLISTMODEL_H
 #define ADDRESSLISTMODEL_H
 
+#include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <QAbstractTableModel>
 #include "CoreWallet.h"
 #include "ValidityFlag.h"
@@ -38,6 +40,7 @@ public:
       QByteArray bytes;
       int transactionCount = 0;
       uint64_t balance = 0;
+      // String fields below are left empty in lazy mode until the row is materialized
       QString  comment;
       QString  displayedAddress;
       QString  walletName;
@@ -50,6 +53,11 @@ public:
       QString getComment() const;
       QString getAddress() const;
 
+      // Row identity: wallet and address only, regardless of balance or comment
+      std::string key() const;
+      void fillStrings();
+
+      // Compares everything that doesn't come from Armory (balance and #tx)
       bool operator==(const AddressRow& other) const;
    };
 
@@ -70,7 +78,9 @@ public:
       WalletIdRole,
       AddrIndexRole,
       AddressRole,
-      IsExternalRole
+      IsExternalRole,
+      TxCountRole,
+      BalanceRole
    };
 
    enum AddressType {
@@ -108,9 +118,30 @@ private:
    bool filterBtcOnly_{false};
    ValidityFlag validityFlag_;
 
+   // Lazy mode is used for huge wallets: rows keep only numeric data and
+   // display strings/comments are fetched on demand for visible rows only
+   struct RowStrings
+   {
+      QString  comment;
+      QString  displayedAddress;
+      QString  walletName;
+      QString  walletId;
+   };
+   using RowCache = std::list<std::pair<std::string, RowStrings>>;
+   bool lazyMode_{ false };
+   mutable RowCache  rowCache_;
+   mutable std::unordered_map<std::string, RowCache::iterator>   rowCacheIndex_;
+
 private:
    void updateWallet(const std::shared_ptr<bs::sync::Wallet> &wallet, std::vector<AddressRow> &addresses);
    void updateWalletData();
+   void applyRows(std::vector<AddressRow> &&, bool forceReset);
+   AddressRow rowAt(int row) const;
+   void clearRowCache();
+   void refreshRowCache();
+   void applyBalances(const std::shared_ptr<bs::sync::Wallet> &
+      , const std::vector<std::string> &keys, const std::vector<uint32_t> &txns
+      , const std::vector<uint64_t> &balances);
    AddressRow createRow(const bs::Address &, const std::shared_ptr<bs::sync::Wallet> &) const;
    QVariant dataForRow(const AddressListModel::AddressRow &row, int column) const;
 };
@@ -0,0 +1,457 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "AddressTransactionsModel.h"
+
+#include <cmath>
+#include <set>
+#include <QColor>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFont>
+#include <spdlog/spdlog.h>
+#include "TxCache.h"
+#include "UiUtils.h"
+
+AddressTransactionsModel::AddressTransactionsModel(const std::shared_ptr<ArmoryConnection> &armory
+   , const std::shared_ptr<spdlog::logger> &logger, QObject *parent)
+   : QAbstractTableModel(parent)
+   , armory_(armory)
+   , logger_(logger)
+{}
+
+void AddressTransactionsModel::setLedgerDelegate(const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate)
+{
+   clear();
+   delegate_ = delegate;
+   if (!delegate_) {
+      return;
+   }
+
+   const auto cbPageCnt = [this, logger = logger_, gen = generation_, handle = validityFlag_.handle()]
+      (ReturnMessage<uint64_t> pageCnt) mutable
+   {
+      uint32_t count = 0;
+      try {
+         count = static_cast<uint32_t>(pageCnt.get());
+      }
+      catch (const std::exception &e) {
+         SPDLOG_LOGGER_ERROR(logger, "Return data error (getPageCount) - {}", e.what());
+      }
+      QMetaObject::invokeMethod(qApp, [this, handle, gen, count] {
+         if (!handle.isValid() || (gen != generation_)) {
+            return;
+         }
+         pageCount_ = count;
+         pageCountKnown_ = true;
+         if (pageCount_ == 0) {
+            emit pageLoaded({});
+            return;
+         }
+         loadPage(0);
+      });
+   };
+   delegate_->getPageCount(cbPageCnt);
+}
+
+void AddressTransactionsModel::setAmountFormatter(const AmountFormatter &formatter)
+{
+   amountFormatter_ = formatter;
+   refreshAmounts();
+}
+
+void AddressTransactionsModel::refreshAmounts()
+{
+   if (rows_.empty()) {
+      return;
+   }
+   emit dataChanged(index(0, ColumnOutputAmt), index(rowCount() - 1, ColumnOutputAmt));
+}
+
+void AddressTransactionsModel::clear()
+{
+   beginResetModel();
+   rows_.clear();
+   rowByHash_.clear();
+   pageCount_ = 0;
+   nextPage_ = 0;
+   pageCountKnown_ = false;
+   pageRequested_ = false;
+   ++generation_;
+   delegate_.reset();
+   endResetModel();
+}
+
+bool AddressTransactionsModel::hasMorePages() const
+{
+   return !pageCountKnown_ || (nextPage_ < pageCount_);
+}
+
+const bs::TXEntry *AddressTransactionsModel::findEntry(const BinaryData &txHash) const
+{
+   const auto it = rowByHash_.find(txHash);
+   if (it == rowByHash_.end()) {
+      return nullptr;
+   }
+   return &rows_[size_t(it->second)].entry;
+}
+
+int AddressTransactionsModel::rowCount(const QModelIndex &parent) const
+{
+   if (parent.isValid()) {
+      return 0;
+   }
+   return static_cast<int>(rows_.size());
+}
+
+int AddressTransactionsModel::columnCount(const QModelIndex &) const
+{
+   return ColumnCount;
+}
+
+bool AddressTransactionsModel::canFetchMore(const QModelIndex &parent) const
+{
+   if (parent.isValid() || !delegate_) {
+      return false;
+   }
+   return pageCountKnown_ && !pageRequested_ && (nextPage_ < pageCount_);
+}
+
+void AddressTransactionsModel::fetchMore(const QModelIndex &parent)
+{
+   if (!canFetchMore(parent)) {
+      return;
+   }
+   loadPage(nextPage_);
+}
+
+void AddressTransactionsModel::loadPage(uint32_t page)
+{
+   pageRequested_ = true;
+
+   const auto cbLedger = [this, page, logger = logger_, gen = generation_, handle = validityFlag_.handle()]
+      (ReturnMessage<std::vector<ClientClasses::LedgerEntry>> ledgerEntries) mutable
+   {
+      std::vector<bs::TXEntry> entries;
+      try {
+         const auto &result = ledgerEntries.get();
+         entries.reserve(result.size());
+         for (const auto &entry : result) {
+            entries.push_back(bs::TXEntry::fromLedgerEntry(entry));
+         }
+      }
+      catch (const std::exception &e) {
+         SPDLOG_LOGGER_ERROR(logger, "Return data error (page {}) - {}", page, e.what());
+      }
+      // Callback is called from background
+      QMetaObject::invokeMethod(qApp, [this, handle, gen, page, entries] {
+         if (!handle.isValid() || (gen != generation_)) {
+            return;
+         }
+         onPageLoaded(page, entries);
+      });
+   };
+   delegate_->getHistoryPage(page, cbLedger);
+}
+
+void AddressTransactionsModel::onPageLoaded(uint32_t page, const std::vector<bs::TXEntry> &entries)
+{
+   pageRequested_ = false;
+   // Failed page is skipped to not get stuck on it while scrolling
+   nextPage_ = page + 1;
+
+   std::vector<bs::TXEntry> newEntries;
+   newEntries.reserve(entries.size());
+   for (const auto &entry : entries) {
+      if (rowByHash_.find(entry.txHash) == rowByHash_.end()) {
+         rowByHash_[entry.txHash] = static_cast<int>(rows_.size() + newEntries.size());
+         newEntries.push_back(entry);
+      }
+   }
+
+   if (!newEntries.empty()) {
+      const int first = rowCount();
+      const int last = first + static_cast<int>(newEntries.size()) - 1;
+      beginInsertRows({}, first, last);
+      for (const auto &entry : newEntries) {
+         rows_.push_back({ entry });
+      }
+      endInsertRows();
+      resolvePage(first, last);
+   }
+
+   emit pageLoaded(newEntries);
+}
+
+void AddressTransactionsModel::resolvePage(int first, int last)
+{
+   std::set<BinaryData> txHashes;
+   for (int i = first; i <= last; ++i) {
+      txHashes.insert(rows_[size_t(i)].entry.txHash);
+   }
+
+   // Callbacks below could be called from background - model members other
+   // than the handle-protected ones are not accessed there
+   const auto handle = validityFlag_.handle();
+   const auto gen = generation_;
+   const auto armory = armory_;
+   const auto logger = logger_;
+   const auto cbTXs = [this, handle, gen, armory, logger, first, last, txHashes]
+      (const AsyncClient::TxBatchResult &txs, std::exception_ptr)
+   {
+      const auto cbDone = [this, handle, gen, logger, first, last, txHashes, txs]
+         (const AsyncClient::TxBatchResult &prevTxs, std::exception_ptr) mutable
+      {
+         std::map<BinaryData, TxDetails> details;
+         for (const auto &txHash : txHashes) {
+            details[txHash] = txDetails(logger, txHash, txs, prevTxs);
+         }
+         QMetaObject::invokeMethod(qApp, [this, handle, gen, first, last, txs, details] {
+            if (!handle.isValid() || (gen != generation_)) {
+               return;
+            }
+            onPageResolved(first, last, txs, details);
+         });
+      };
+
+      // Inputs value could be already known from earlier browsing - prev TXs
+      // are needed only for TXs which fees were not calculated yet
+      std::set<BinaryData> prevTxHashes;
+      for (const auto &tx : txs) {
+         uint64_t inputsValue = 0;
+         if (!tx.second || !tx.second->isInitialized()
+            || bs::TxCache::instance().getInputsValue(tx.first, inputsValue)) {
+            continue;
+         }
+         for (size_t i = 0; i < tx.second->getNumTxIn(); ++i) {
+            const auto &op = tx.second->getTxInCopy(i).getOutPoint();
+            if (txs.find(op.getTxHash()) == txs.end()) {
+               prevTxHashes.insert(op.getTxHash());
+            }
+         }
+      }
+      if (prevTxHashes.empty()) {
+         cbDone({}, nullptr);
+      }
+      else {
+         bs::TxCache::instance().getTXsByHash(armory.get(), prevTxHashes, cbDone);
+      }
+   };
+   bs::TxCache::instance().getTXsByHash(armory_.get(), txHashes, cbTXs);
+}
+
+AddressTransactionsModel::TxDetails AddressTransactionsModel::txDetails(const std::shared_ptr<spdlog::logger> &logger
+   , const BinaryData &hash, const AsyncClient::TxBatchResult &txs
+   , const AsyncClient::TxBatchResult &prevTxs)
+{
+   TxDetails result;
+   const auto itTx = txs.find(hash);
+   if ((itTx == txs.end()) || !itTx->second || !itTx->second->isInitialized()) {
+      SPDLOG_LOGGER_WARN(logger, "TX with hash {} is not found or not inited"
+         , hash.toHexStr(true));
+      return result;
+   }
+   const auto &tx = itTx->second;
+
+   // Get fees & fee/byte by looping through the prev Tx set and calculating.
+   uint64_t totIn = 0;
+   if (!bs::TxCache::instance().getInputsValue(hash, totIn)) {
+      bool allInputsResolved = true;
+      for (size_t r = 0; r < tx->getNumTxIn(); ++r) {
+         const auto &op = tx->getTxInCopy(r).getOutPoint();
+         // Previous TX could be on the same page
+         bs::TxCache::TxPtr prevTx;
+         auto itPrevTx = prevTxs.find(op.getTxHash());
+         if (itPrevTx != prevTxs.end()) {
+            prevTx = itPrevTx->second;
+         }
+         else if ((itPrevTx = txs.find(op.getTxHash())) != txs.end()) {
+            prevTx = itPrevTx->second;
+         }
+         if (prevTx && prevTx->isInitialized()) {
+            totIn += prevTx->getTxOutCopy(op.getTxOutIndex()).getValue();
+         }
+         else {
+            allInputsResolved = false;
+            SPDLOG_LOGGER_WARN(logger, "prev TX with hash {} is not found or is notinitialized"
+               , op.getTxHash().toHexStr(true));
+         }
+      }
+      if (allInputsResolved) {
+         bs::TxCache::instance().setInputsValue(hash, totIn);
+      }
+   }
+
+   result.nbInputs = static_cast<uint32_t>(tx->getNumTxIn());
+   result.nbOutputs = static_cast<uint32_t>(tx->getNumTxOut());
+   result.fees = totIn - tx->getSumOfOutputs();
+   result.feePerByte = (double)result.fees / (double)tx->getTxWeight();
+   result.size = static_cast<uint32_t>(tx->getSize());
+   return result;
+}
+
+void AddressTransactionsModel::onPageResolved(int first, int last
+   , const AsyncClient::TxBatchResult &txs, const std::map<BinaryData, TxDetails> &details)
+{
+   for (int i = first; i <= last; ++i) {
+      auto &row = rows_[size_t(i)];
+      const auto itDetails = details.find(row.entry.txHash);
+      const auto itTx = txs.find(row.entry.txHash);
+      if ((itDetails == details.end()) || (itTx == txs.end()) || !itTx->second) {
+         continue;
+      }
+      row.details = itDetails->second;
+      row.resolved = true;
+   }
+   emit dataChanged(index(first, 0), index(last, ColumnCount - 1));
+   emit txsResolved(txs);
+}
+
+QVariant AddressTransactionsModel::data(const QModelIndex &index, int role) const
+{
+   if (!index.isValid() || (index.row() >= rowCount())) {
+      return {};
+   }
+   const auto &row = rows_[size_t(index.row())];
+
+   if (role == SortRole) {
+      return sortData(row, index.column());
+   }
+
+   switch (role) {
+   case Qt::DisplayRole:
+      switch (index.column()) {
+      case ColumnDate:
+         return UiUtils::displayDateTime(QDateTime::fromTime_t(row.entry.txTime));
+      case ColumnTxId:  // Flip Armory's TXID byte order: internal -> RPC
+         return QString::fromStdString(row.entry.txHash.toHexStr(true));
+      case ColumnConfs:
+         return armory_->getConfirmationsNumber(row.entry.blockNum);
+      case ColumnOutputAmt:
+         if (amountFormatter_) {
+            bool isValid = true;
+            return amountFormatter_(row.entry, isValid);
+         }
+         return UiUtils::displayAmount(row.entry.value);
+      default:
+         break;
+      }
+
+      if (!row.resolved) {
+         return {};
+      }
+      switch (index.column()) {
+      case ColumnInputsNum:
+         return QString::number(row.details.nbInputs);
+      case ColumnOutputsNum:
+         return QString::number(row.details.nbOutputs);
+      case ColumnFees:
+         return UiUtils::displayAmount(row.details.fees);
+      case ColumnFeePerByte:
+         return QString::number(std::nearbyint(row.details.feePerByte));
+      case ColumnTxSize:
+         return QString::number(row.details.size);
+      default:
+         break;
+      }
+      break;
+
+   case Qt::TextAlignmentRole:
+      if (index.column() == ColumnOutputAmt) {
+         return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+      }
+      break;
+
+   case Qt::FontRole:
+      if (index.column() == ColumnOutputAmt) {
+         QFont font;
+         font.setBold(true);
+         return font;
+      }
+      break;
+
+   case Qt::ForegroundRole:
+      if (index.column() == ColumnConfs) {
+         const auto conf = armory_->getConfirmationsNumber(row.entry.blockNum);
+         if (conf == 0) {
+            return QColor(Qt::red);
+         }
+         if (conf <= 5) {
+            return QColor(Qt::darkYellow);
+         }
+         return QColor(Qt::darkGreen);
+      }
+      if ((index.column() == ColumnOutputAmt) && amountFormatter_) {
+         // Mark invalid CC transactions
+         bool isValid = true;
+         amountFormatter_(row.entry, isValid);
+         if (!isValid) {
+            return QColor(Qt::red);
+         }
+      }
+      break;
+
+   default:
+      break;
+   }
+   return {};
+}
+
+QVariant AddressTransactionsModel::sortData(const Row &row, int column) const
+{
+   switch (column) {
+   case ColumnDate:
+      return row.entry.txTime;
+   case ColumnTxId:
+      return QString::fromStdString(row.entry.txHash.toHexStr(true));
+   case ColumnConfs:
+      return armory_->getConfirmationsNumber(row.entry.blockNum);
+   case ColumnOutputAmt:
+      return static_cast<qlonglong>(row.entry.value);
+   default:
+      break;
+   }
+   if (!row.resolved) {
+      return {};
+   }
+   switch (column) {
+   case ColumnInputsNum:
+      return row.details.nbInputs;
+   case ColumnOutputsNum:
+      return row.details.nbOutputs;
+   case ColumnFees:
+      return static_cast<qulonglong>(row.details.fees);
+   case ColumnFeePerByte:
+      return row.details.feePerByte;
+   case ColumnTxSize:
+      return row.details.size;
+   default:
+      return {};
+   }
+}
+
+QVariant AddressTransactionsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+   if ((orientation != Qt::Horizontal) || (role != Qt::DisplayRole)) {
+      return {};
+   }
+   switch (section) {
+   case ColumnDate:        return tr("Date");
+   case ColumnTxId:        return tr("Transaction ID");
+   case ColumnConfs:       return tr("Confirmations");
+   case ColumnInputsNum:   return tr("Inputs #");
+   case ColumnOutputsNum:  return tr("Outputs #");
+   case ColumnOutputAmt:   return tr("Amount");
+   case ColumnFees:        return tr("Fees");
+   case ColumnFeePerByte:  return tr("Fee per byte");
+   case ColumnTxSize:      return tr("Size (B)");
+   default:                return {};
+   }
+}
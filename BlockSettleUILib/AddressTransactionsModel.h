@@ -0,0 +1,131 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef ADDRESS_TRANSACTIONS_MODEL_H
+#define ADDRESS_TRANSACTIONS_MODEL_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include <QAbstractTableModel>
+#include "ArmoryConnection.h"
+#include "ValidityFlag.h"
+#include "Wallets/SyncWallet.h"
+
+namespace spdlog {
+   class logger;
+}
+
+// Transactions of a single address for the blockchain explorer. Ledger pages
+// are requested from the delegate one by one as the view scrolls down
+// (canFetchMore/fetchMore) and TXs with their previous TXs are resolved only
+// for the page that was just loaded.
+class AddressTransactionsModel : public QAbstractTableModel
+{
+   Q_OBJECT
+
+public:
+   enum Columns
+   {
+      ColumnDate,
+      ColumnTxId,
+      ColumnConfs,
+      ColumnInputsNum,
+      ColumnOutputsNum,
+      ColumnOutputAmt,
+      ColumnFees,
+      ColumnFeePerByte,
+      ColumnTxSize,
+      ColumnCount
+   };
+
+   enum Role
+   {
+      SortRole = Qt::UserRole
+   };
+
+   // Returns amount text for the entry, clears isValid to mark the entry
+   // as invalid (e.g. non-CC TX on CC address)
+   using AmountFormatter = std::function<QString(const bs::TXEntry &, bool &isValid)>;
+
+   AddressTransactionsModel(const std::shared_ptr<ArmoryConnection> &
+      , const std::shared_ptr<spdlog::logger> &, QObject *parent = nullptr);
+   ~AddressTransactionsModel() noexcept override = default;
+
+   // Resets the model and loads the first page from the delegate
+   void setLedgerDelegate(const std::shared_ptr<AsyncClient::LedgerDelegate> &);
+   void setAmountFormatter(const AmountFormatter &);
+   void refreshAmounts();
+   void clear();
+
+   bool hasMorePages() const;
+   const bs::TXEntry &entry(int row) const { return rows_.at(size_t(row)).entry; }
+   const bs::TXEntry *findEntry(const BinaryData &txHash) const;
+
+   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+   int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+   QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+   bool canFetchMore(const QModelIndex &parent) const override;
+   void fetchMore(const QModelIndex &parent) override;
+
+signals:
+   // Emitted for each loaded page (also with empty entries if address has no TXs)
+   void pageLoaded(const std::vector<bs::TXEntry> &entries);
+   void txsResolved(const AsyncClient::TxBatchResult &txs);
+
+private:
+   struct TxDetails
+   {
+      uint32_t nbInputs{ 0 };
+      uint32_t nbOutputs{ 0 };
+      uint64_t fees{ 0 };
+      double   feePerByte{ 0 };
+      uint32_t size{ 0 };
+   };
+
+   struct Row
+   {
+      bs::TXEntry entry;
+      bool        resolved{ false };
+      TxDetails   details;
+   };
+
+   void loadPage(uint32_t page);
+   void onPageLoaded(uint32_t page, const std::vector<bs::TXEntry> &);
+   void resolvePage(int first, int last);
+   void onPageResolved(int first, int last, const AsyncClient::TxBatchResult &txs
+      , const std::map<BinaryData, TxDetails> &);
+   static TxDetails txDetails(const std::shared_ptr<spdlog::logger> &
+      , const BinaryData &hash, const AsyncClient::TxBatchResult &txs
+      , const AsyncClient::TxBatchResult &prevTxs);
+   QVariant sortData(const Row &, int column) const;
+
+private:
+   std::shared_ptr<ArmoryConnection>   armory_;
+   std::shared_ptr<spdlog::logger>     logger_;
+   std::shared_ptr<AsyncClient::LedgerDelegate> delegate_;
+   AmountFormatter   amountFormatter_;
+
+   std::vector<Row>  rows_;
+   std::map<BinaryData, int>  rowByHash_;
+
+   uint32_t pageCount_{ 0 };
+   uint32_t nextPage_{ 0 };
+   bool     pageCountKnown_{ false };
+   bool     pageRequested_{ false };
+   // Bumped on each reset to drop replies for the previous delegate
+   uint32_t generation_{ 0 };
+
+   ValidityFlag validityFlag_;
+};
+
+#endif // ADDRESS_TRANSACTIONS_MODEL_H
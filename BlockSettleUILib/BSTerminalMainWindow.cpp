@@ -12,6 +12,8 @@
 
 #include <QApplication>
 #include <QCloseEvent>
+#include <QDir>
+#include <QFileDialog>
 #include <QGuiApplication>
 #include <QIcon>
 #include <QShortcut>
@@ -20,6 +22,7 @@
 #include <QToolBar>
 #include <QTreeView>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <thread>
 
 #include "ArmoryServersProvider.h"
@@ -65,8 +68,10 @@
 #include "StatusBarView.h"
 #include "SystemFileUtils.h"
 #include "TabWithShortcut.h"
+#include "TraceProfiler.h"
 #include "TransactionsViewModel.h"
 #include "TransactionsWidget.h"
+#include "TxCache.h"
 #include "UiUtils.h"
 #include "UserScriptRunner.h"
 #include "UtxoReservationManager.h"
@@ -75,6 +80,11 @@
 
 #include "ui_BSTerminalMainWindow.h"
 
+namespace {
+   // ZCs received within this interval are shown as one notification per wallet
+   const int kZcNotificationIntervalMs = 1000;
+}
+
 BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSettings>& settings
    , BSTerminalSplashScreen& splashScreen, QLockFile &lockFile, QWidget* parent)
    : QMainWindow(parent)
@@ -82,12 +92,21 @@ BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSett
    , applicationSettings_(settings)
    , lockFile_(lockFile)
 {
+   startupTimer_.start();
+#ifdef BS_TRACING
+   bs::trace::Profiler::instance().setThreadName("GUI");
+#endif
+   BS_TRACE_SCOPE("BSTerminalMainWindow");
    UiUtils::SetupLocale();
 
    ui_->setupUi(this);
 
    setupShortcuts();
 
+   zcNotifyTimer_.setSingleShot(true);
+   zcNotifyTimer_.setInterval(kZcNotificationIntervalMs);
+   connect(&zcNotifyTimer_, &QTimer::timeout, this, &BSTerminalMainWindow::flushZcNotifications);
+
    loginButtonText_ = tr("Login");
 
    armoryServersProvider_= std::make_shared<ArmoryServersProvider>(applicationSettings_);
@@ -109,6 +128,7 @@ BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSett
    logMgr_->add(applicationSettings_->GetLogsConfig());
 
    logMgr_->logger()->debug("Settings loaded from {}", applicationSettings_->GetSettingsPath().toStdString());
+   logStartupStep("settings loaded");
 
    bs::UtxoReservation::init(logMgr_->logger());
 
@@ -136,6 +156,7 @@ BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSett
    }
 
    InitAssets();
+   logStartupStep("assets loaded");
    InitSigningContainer();
    InitAuthManager();
    initUtxoReservationManager();
@@ -156,16 +177,20 @@ BSTerminalMainWindow::BSTerminalMainWindow(const std::shared_ptr<ApplicationSett
    connectArmory();
    connectCcClient();
 
-   InitChartsView();
-
+   connect(ui_->tabWidget, &QTabWidget::currentChanged, this, [this](int index) {
+      ensureTabInitialized(ui_->tabWidget->widget(index));
+   });
    ui_->tabWidget->setCurrentIndex(settings->get<int>(ApplicationSettings::GUI_main_tab));
 
+   addDeferredTabInit(ui_->widgetChart, [this] { InitChartsView(); });
+
    UpdateMainWindowAppearence();
    setWidgetsAuthorized(false);
 
    updateControlEnabledState();
 
    InitWidgets();
+   logStartupStep("main window created");
 }
 
 void BSTerminalMainWindow::onNetworkSettingsRequired(NetworkSettingsClient client)
@@ -237,6 +262,77 @@ void BSTerminalMainWindow::postSplashscreenActions()
    if (applicationSettings_->get<bool>(ApplicationSettings::SubscribeToMDOnStart)) {
       mdProvider_->SubscribeToMD();
    }
+
+   // Called after the window is shown: zero timer fires once pending
+   // show/paint events are processed
+   QTimer::singleShot(0, this, [this] { onStartupCompleted(); });
+}
+
+void BSTerminalMainWindow::logStartupStep(const char *step)
+{
+   if (logMgr_) {
+      logMgr_->logger()->debug("[startup] {}: {} ms", step, startupTimer_.elapsed());
+   }
+}
+
+void BSTerminalMainWindow::onStartupCompleted()
+{
+   if (startupCompleted_) {
+      return;
+   }
+   startupCompleted_ = true;
+   if (logMgr_) {
+      logMgr_->logger()->info("[startup] interactive in {} ms, {} tab[s] left to initialize"
+         , startupTimer_.elapsed(), deferredTabInits_.size());
+   }
+   initNextDeferredTab();
+}
+
+void BSTerminalMainWindow::addDeferredTabInit(QWidget *tab, const std::function<void()> &cb)
+{
+   if (ui_->tabWidget->currentWidget() == tab) {
+      cb();
+      return;
+   }
+   deferredTabInits_.emplace_back(tab, cb);
+}
+
+void BSTerminalMainWindow::ensureTabInitialized(QWidget *tab)
+{
+   BS_TRACE_FUNCTION();
+   const auto it = std::find_if(deferredTabInits_.begin(), deferredTabInits_.end()
+      , [tab](const std::pair<QWidget *, std::function<void()>> &deferred) {
+      return (deferred.first == tab);
+   });
+   if (it == deferredTabInits_.end()) {
+      return;
+   }
+   const auto cb = std::move(it->second);
+   deferredTabInits_.erase(it);
+   cb();
+   if (logMgr_) {
+      logMgr_->logger()->debug("[startup] tab {} initialized at {} ms"
+         , tab->objectName().toStdString(), startupTimer_.elapsed());
+   }
+}
+
+bool BSTerminalMainWindow::isTabInitialized(QWidget *tab) const
+{
+   return std::none_of(deferredTabInits_.cbegin(), deferredTabInits_.cend()
+      , [tab](const std::pair<QWidget *, std::function<void()>> &deferred) {
+      return (deferred.first == tab);
+   });
+}
+
+void BSTerminalMainWindow::initNextDeferredTab()
+{
+   if (deferredTabInits_.empty()) {
+      return;
+   }
+   ensureTabInitialized(deferredTabInits_.front().first);
+
+   // One tab per event loop iteration to keep UI responsive
+   QTimer::singleShot(0, this, [this] { initNextDeferredTab(); });
 }
 
 void BSTerminalMainWindow::loadPositionAndShow()
@@ -429,6 +525,7 @@ void BSTerminalMainWindow::initConnections()
 
 void BSTerminalMainWindow::LoadWallets()
 {
+   BS_TRACE_FUNCTION();
    logMgr_->logger()->debug("Loading wallets");
 
    connect(walletsMgr_.get(), &bs::sync::WalletsManager::walletsReady, this, [this] {
@@ -473,6 +570,7 @@ void BSTerminalMainWindow::LoadWallets()
 
 void BSTerminalMainWindow::InitAuthManager()
 {
+   BS_TRACE_FUNCTION();
    authManager_ = std::make_shared<AuthAddressManager>(logMgr_->logger(), armory_);
    authManager_->init(applicationSettings_, walletsMgr_, signContainer_);
 
@@ -606,6 +704,7 @@ std::shared_ptr<WalletSignerContainer> BSTerminalMainWindow::createLocalSigner()
 
 bool BSTerminalMainWindow::InitSigningContainer()
 {
+   BS_TRACE_FUNCTION();
    signContainer_ = createSigner();
 
    if (!signContainer_) {
@@ -723,6 +822,7 @@ bool BSTerminalMainWindow::showStartupDialog()
 
 void BSTerminalMainWindow::InitAssets()
 {
+   BS_TRACE_FUNCTION();
    ccFileManager_ = std::make_shared<CCFileManager>(logMgr_->logger(), applicationSettings_);
    assetManager_ = std::make_shared<AssetManager>(logMgr_->logger(), walletsMgr_
       , mdCallbacks_, celerConnection_);
@@ -745,6 +845,7 @@ void BSTerminalMainWindow::InitAssets()
 
 void BSTerminalMainWindow::InitPortfolioView()
 {
+   BS_TRACE_FUNCTION();
    portfolioModel_ = std::make_shared<CCPortfolioModel>(walletsMgr_, assetManager_, this);
    ui_->widgetPortfolio->init(applicationSettings_, mdProvider_, mdCallbacks_
       , portfolioModel_, signContainer_, armory_, utxoReservationMgr_, logMgr_->logger("ui"), walletsMgr_);
@@ -752,6 +853,7 @@ void BSTerminalMainWindow::InitPortfolioView()
 
 void BSTerminalMainWindow::InitWalletsView()
 {
+   BS_TRACE_FUNCTION();
    ui_->widgetWallets->init(logMgr_->logger("ui"), walletsMgr_, signContainer_
       , applicationSettings_, connectionManager_, assetManager_, authManager_, armory_);
    connect(ui_->widgetWallets, &WalletsWidget::newWalletCreationRequest, this, &BSTerminalMainWindow::onInitWalletDialogWasShown);
@@ -853,6 +955,7 @@ void BSTerminalMainWindow::tryGetChatKeys()
 
 void BSTerminalMainWindow::InitChartsView()
 {
+   BS_TRACE_FUNCTION();
    ui_->widgetChart->init(applicationSettings_, mdProvider_, mdCallbacks_
       , connectionManager_, logMgr_->logger("ui"));
 }
@@ -860,13 +963,21 @@ void BSTerminalMainWindow::InitChartsView()
 // Initialize widgets related to transactions.
 void BSTerminalMainWindow::InitTransactionsView()
 {
-   ui_->widgetExplorer->init(armory_, logMgr_->logger(), walletsMgr_, ccFileManager_, authManager_);
+   BS_TRACE_FUNCTION();
+   addDeferredTabInit(ui_->widgetExplorer, [this] {
+      ui_->widgetExplorer->init(armory_, logMgr_->logger(), walletsMgr_, ccFileManager_, authManager_);
+   });
+   if (startupCompleted_) {
+      QTimer::singleShot(0, this, [this] { initNextDeferredTab(); });
+   }
    ui_->widgetTransactions->init(walletsMgr_, armory_, utxoReservationMgr_, signContainer_, applicationSettings_
                                 , logMgr_->logger("ui"));
    ui_->widgetTransactions->setEnabled(true);
 
    ui_->widgetTransactions->SetTransactionsModel(transactionsModel_);
-   ui_->widgetPortfolio->SetTransactionsModel(transactionsModel_);
+   if (isTabInitialized(ui_->widgetPortfolio)) {
+      ui_->widgetPortfolio->SetTransactionsModel(transactionsModel_);
+   }
 }
 
 void BSTerminalMainWindow::MainWinACT::onStateChanged(ArmoryState state)
@@ -904,6 +1015,7 @@ void BSTerminalMainWindow::MainWinACT::onStateChanged(ArmoryState state)
 
 void BSTerminalMainWindow::CompleteUIOnlineView()
 {
+   BS_TRACE_FUNCTION();
    if (!transactionsModel_) {
       transactionsModel_ = std::make_shared<TransactionsViewModel>(armory_
          , walletsMgr_, logMgr_->logger("ui"), this);
@@ -1290,6 +1402,11 @@ void BSTerminalMainWindow::setupMenu()
    connect(ui_->actionGuides, &QAction::triggered, supportDlgCb(0));
    connect(ui_->actionContact, &QAction::triggered, supportDlgCb(1));
 
+#ifdef BS_TRACING
+   const auto actionSaveTrace = ui_->menu_Help->addAction(tr("Save Trace..."));
+   connect(actionSaveTrace, &QAction::triggered, this, &BSTerminalMainWindow::saveTrace);
+#endif
+
    onUserLoggedOut();
 
 #ifndef Q_OS_MAC
@@ -1309,6 +1426,19 @@ void BSTerminalMainWindow::setupMenu()
    });
 }
 
+void BSTerminalMainWindow::saveTrace()
+{
+   const auto fileName = QFileDialog::getSaveFileName(this, tr("Save Trace")
+      , QDir(QDir::homePath()).filePath(QStringLiteral("terminal_trace.json"))
+      , tr("Chrome trace files (*.json)"));
+   if (fileName.isEmpty()) {
+      return;
+   }
+   if (!bs::trace::Profiler::instance().saveChromeJson(fileName.toStdString())) {
+      showError(tr("Save Trace"), tr("Failed to write %1").arg(fileName));
+   }
+}
+
 void BSTerminalMainWindow::openAuthManagerDialog()
 {
    allowAuthAddressDialogShow_ = false;
@@ -1544,7 +1674,9 @@ void BSTerminalMainWindow::onLogout()
    if (chatClientServicePtr_) {
       chatClientServicePtr_->LogoutFromServer();
    }
-   ui_->widgetChart->disconnect();
+   if (isTabInitialized(ui_->widgetChart)) {
+      ui_->widgetChart->disconnect();
+   }
 
    if (celerConnection_->IsConnected()) {
       celerConnection_->CloseConnection();
@@ -1680,6 +1812,7 @@ void BSTerminalMainWindow::createAuthWallet(const std::function<void()> &cb)
 }
 
 struct BSTerminalMainWindow::TxInfo {
+   BinaryData  txHash;
    Tx       tx;
    uint32_t txTime{};
    int64_t  value{};
@@ -1694,24 +1827,58 @@ void BSTerminalMainWindow::onZCreceived(const std::vector<bs::TXEntry> &entries)
       return;
    }
    for (const auto &entry : walletsMgr_->mergeEntries(entries)) {
-      const auto &cbTx = [this, entry] (const Tx &tx)
-      {
-         std::shared_ptr<bs::sync::Wallet> wallet;
-         for (const auto &walletId : entry.walletIds) {
-            wallet = walletsMgr_->getWalletById(walletId);
-            if (wallet) {
-               break;
-            }
-         }
-         if (!wallet) {
-            return;
+      for (const auto &walletId : entry.walletIds) {
+         if (walletsMgr_->getWalletById(walletId)) {
+            pendingZCs_[walletId].push_back(entry);
+            break;
          }
+      }
+   }
+   if (!pendingZCs_.empty() && !zcNotifyTimer_.isActive()) {
+      zcNotifyTimer_.start();
+   }
+}
+
+void BSTerminalMainWindow::flushZcNotifications()
+{
+   BS_TRACE_FUNCTION();
+   const auto pendingZCs = std::move(pendingZCs_);
+   pendingZCs_.clear();
+
+   // Bursts are summarized from ledger entries only - TXs are fetched (all in
+   // one request) just for wallets with a single ZC to show its details
+   std::vector<std::shared_ptr<TxInfo>> txInfos;
+   std::set<BinaryData> txHashes;
+   for (const auto &pending : pendingZCs) {
+      const auto wallet = walletsMgr_->getWalletById(pending.first);
+      if (!wallet) {
+         continue;
+      }
+      if (pending.second.size() > 1) {
+         showZcSummaryNotification(wallet, pending.second);
+         continue;
+      }
+      const auto &entry = pending.second.front();
+      auto txInfo = std::make_shared<TxInfo>();
+      txInfo->txHash = entry.txHash;
+      txInfo->txTime = entry.txTime;
+      txInfo->value = entry.value;
+      txInfo->wallet = wallet;
+      txInfos.push_back(txInfo);
+      txHashes.insert(entry.txHash);
+   }
+   if (txInfos.empty()) {
+      return;
+   }
 
-         auto txInfo = std::make_shared<TxInfo>();
-         txInfo->tx = tx;
-         txInfo->txTime = entry.txTime;
-         txInfo->value = entry.value;
-         txInfo->wallet = wallet;
+   const auto &cbTXs = [this, txInfos] (const AsyncClient::TxBatchResult &txs, std::exception_ptr)
+   {
+      for (const auto &txInfo : txInfos) {
+         const auto itTx = txs.find(txInfo->txHash);
+         if ((itTx == txs.end()) || !itTx->second) {
+            continue;
+         }
+         txInfo->tx = *itTx->second;
 
          const auto &cbDir = [this, txInfo] (bs::sync::Transaction::Direction dir, const std::vector<bs::Address> &) {
             txInfo->direction = dir;
@@ -1727,11 +1894,12 @@ void BSTerminalMainWindow::onZCreceived(const std::vector<bs::TXEntry> &entries)
             }
          };
 
-         walletsMgr_->getTransactionDirection(tx, wallet->walletId(), cbDir);
-         walletsMgr_->getTransactionMainAddress(tx, wallet->walletId(), (entry.value > 0), cbMainAddr);
-      };
-      armory_->getTxByHash(entry.txHash, cbTx, true);
-   }
+         walletsMgr_->getTransactionDirection(txInfo->tx, txInfo->wallet->walletId(), cbDir);
+         walletsMgr_->getTransactionMainAddress(txInfo->tx, txInfo->wallet->walletId()
+            , (txInfo->value > 0), cbMainAddr);
+      }
+   };
+   bs::TxCache::instance().getTXsByHash(armory_.get(), txHashes, cbTXs);
 }
 
 void BSTerminalMainWindow::showZcNotification(const TxInfo &txInfo)
@@ -1744,7 +1912,32 @@ void BSTerminalMainWindow::showZcNotification(const TxInfo &txInfo)
    lines << txInfo.mainAddress;
 
    const auto &title = tr("New blockchain transaction");
-   NotificationCenter::notify(bs::ui::NotifyType::BlockchainTX, { title, lines.join(tr("\n")) });
+   NotificationCenter::notify(bs::ui::NotifyType::BlockchainTX, { title, lines.join(tr("\n")), 1 });
+}
+
+void BSTerminalMainWindow::showZcSummaryNotification(const std::shared_ptr<bs::sync::Wallet> &wallet
+   , const std::vector<bs::TXEntry> &entries)
+{
+   uint32_t txTime = 0;
+   int64_t total = 0;
+   int nbReceived = 0;
+   for (const auto &entry : entries) {
+      txTime = std::max(txTime, static_cast<uint32_t>(entry.txTime));
+      total += entry.value;
+      if (entry.value > 0) {
+         ++nbReceived;
+      }
+   }
+
+   QStringList lines;
+   lines << tr("Date: %1").arg(UiUtils::displayDateTime(txTime));
+   lines << tr("TXs: %1 received, %2 sent").arg(nbReceived).arg(int(entries.size()) - nbReceived);
+   lines << tr("Total: %1 %2").arg(wallet->displayTxValue(total)).arg(wallet->displaySymbol());
+   lines << tr("Wallet: %1").arg(QString::fromStdString(wallet->name()));
+
+   const auto &title = tr("New blockchain transactions");
+   NotificationCenter::notify(bs::ui::NotifyType::BlockchainTX, { title, lines.join(tr("\n"))
+      , static_cast<int>(entries.size()) });
 }
 
 void BSTerminalMainWindow::onNodeStatus(NodeStatus nodeStatus, bool isSegWitEnabled, RpcStatus rpcStatus)
@@ -1990,6 +2183,7 @@ void BSTerminalMainWindow::onTabWidgetCurrentChanged(const int &index)
 
 void BSTerminalMainWindow::onSyncWallets()
 {
+   BS_TRACE_FUNCTION();
    if (walletsMgr_->isSynchronising()) {
       return;
    }
@@ -2012,11 +2206,17 @@ void BSTerminalMainWindow::onSignerVisibleChanged()
 
 void BSTerminalMainWindow::InitWidgets()
 {
+   BS_TRACE_FUNCTION();
    authAddrDlg_ = std::make_shared<AuthAddressDialog>(logMgr_->logger(), authManager_
       , assetManager_, applicationSettings_, this);
 
    InitWalletsView();
-   InitPortfolioView();
+   addDeferredTabInit(ui_->widgetPortfolio, [this] {
+      InitPortfolioView();
+      if (transactionsModel_) {
+         ui_->widgetPortfolio->SetTransactionsModel(transactionsModel_);
+      }
+   });
 
    ui_->widgetRFQ->initWidgets(mdProvider_, mdCallbacks_, applicationSettings_);
 
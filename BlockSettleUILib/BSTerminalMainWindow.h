@@ -11,10 +11,15 @@
 #ifndef __BS_TERMINAL_MAIN_WINDOW_H__
 #define __BS_TERMINAL_MAIN_WINDOW_H__
 
+#include <QElapsedTimer>
 #include <QMainWindow>
 #include <QStandardItemModel>
+#include <QTimer>
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "ApplicationSettings.h"
@@ -116,6 +121,16 @@ private:
    void InitWalletsView();
    void InitChartsView();
 
+   // Tab is initialised when it's shown for the first time or when the event
+   // loop gets idle after startup, whichever comes first
+   void addDeferredTabInit(QWidget *tab, const std::function<void()> &);
+   void ensureTabInitialized(QWidget *tab);
+   bool isTabInitialized(QWidget *tab) const;
+   void initNextDeferredTab();
+
+   void logStartupStep(const char *step);
+   void onStartupCompleted();
+
    void tryInitChatView();
    void tryLoginIntoChat();
    void resetChatKeys();
@@ -220,9 +235,13 @@ private slots:
    void openConfigDialog(bool showInNetworkPage = false);
    void openAccountInfoDialog();
    void openCCTokenDialog();
+   void saveTrace();
 
    void onZCreceived(const std::vector<bs::TXEntry> &);
+   void flushZcNotifications();
    void showZcNotification(const TxInfo &);
+   void showZcSummaryNotification(const std::shared_ptr<bs::sync::Wallet> &
+      , const std::vector<bs::TXEntry> &);
    void onNodeStatus(NodeStatus, bool isSegWitEnabled, RpcStatus);
 
    void onLogin();
@@ -311,6 +330,14 @@ private:
    std::queue<std::function<void(void)>> deferredDialogs_;
    bool deferredDialogRunning_ = false;
 
+   // ZC entries waiting for notification, grouped by wallet ID
+   std::map<std::string, std::vector<bs::TXEntry>> pendingZCs_;
+   QTimer zcNotifyTimer_;
+
+   std::vector<std::pair<QWidget *, std::function<void()>>> deferredTabInits_;
+   QElapsedTimer startupTimer_;
+   bool startupCompleted_ = false;
+
    class MainWinACT : public ArmoryCallbackTarget
    {
    public:
@@ -20,6 +20,21 @@
 #include <stdexcept>
 #include <unordered_map>
 
+namespace {
+   // Price ticks for all products are coalesced into one revaluation per interval
+   const int kRevaluationIntervalMs = 250;
+
+   void extendRange(int &firstRow, int &lastRow, int row)
+   {
+      if ((firstRow < 0) || (row < firstRow)) {
+         firstRow = row;
+      }
+      if (row > lastRow) {
+         lastRow = row;
+      }
+   }
+}
+
 class AssetNode
 {
 public:
@@ -584,6 +599,10 @@ CCPortfolioModel::CCPortfolioModel(const std::shared_ptr<bs::sync::WalletsManage
 {
    root_ = std::make_shared<RootAssetGroupNode>(tr("XBT"), tr("Private Shares"), tr("Cash"));
 
+   revaluationTimer_.setSingleShot(true);
+   revaluationTimer_.setInterval(kRevaluationIntervalMs);
+   connect(&revaluationTimer_, &QTimer::timeout, this, &CCPortfolioModel::revalue);
+
    connect(assetManager_.get(), &AssetManager::fxBalanceLoaded
       , this, &CCPortfolioModel::onFXBalanceLoaded, Qt::QueuedConnection);
    connect(assetManager_.get(), &AssetManager::fxBalanceCleared
@@ -765,6 +784,7 @@ void CCPortfolioModel::onFXBalanceLoaded()
 
       const double balance = assetManager_->getBalance(symbolName);
       const double price = assetManager_->getPrice(symbolName);
+      prices_[symbolName] = price;
 
       auto fxNode = fxGroup->GetFXNode(symbolName);
       fxNode->SetFXAmount(balance);
@@ -781,68 +801,29 @@ void CCPortfolioModel::onFXBalanceCleared()
       root_->RemoveFXGroup();
       endResetModel();
    }
+   dirtyFX_.clear();
 }
 
 void CCPortfolioModel::onXBTPriceChanged(const std::string& currency)
 {
-   if (root_->HaveFXGroup()) {
-      auto fxGroup = root_->GetFXGroup();
-
-      auto fxNode = fxGroup->GetFXNode(currency);
-//!      assert(fxNode != nullptr);    // produces crash on login to Celer
-      if (!fxNode) {    //! workaround
-         return;
-      }
-
-      const double balance = assetManager_->getBalance(currency);
-      const double price = assetManager_->getPrice(currency);
-      const bool priceChanged = fxNode->SetPrice(price);
-      const bool balanceChanged = fxNode->SetFXAmount(balance);
-
-      if (fxNode->HasXBTValue() && (priceChanged || balanceChanged)) {
-         dataChanged(index(fxGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , index(fxGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , {Qt::DisplayRole});
-
-         auto parentIndex = createIndex(fxGroup->getRow(), 0, static_cast<void*>(fxGroup));
-
-         dataChanged(index(fxNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-            , index(fxNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-            , {Qt::DisplayRole});
-      }
-   }
+   prices_[currency] = assetManager_->getPrice(currency);
+   dirtyFX_.insert(currency);
+   scheduleRevaluation();
 }
 
 void CCPortfolioModel::onFXBalanceChanged(const std::string& currency)
 {
    if (currency != bs::network::XbtCurrency) {
-      onXBTPriceChanged(currency);
+      dirtyFX_.insert(currency);
+      scheduleRevaluation();
    }
 }
 
 void CCPortfolioModel::onCCPriceChanged(const std::string& currency)
 {
-   if (root_->HaveCCGroup()) {
-      auto ccGroup = root_->GetCCGroup();
-      auto ccNode = ccGroup->GetCCNode(currency);
-
-      if (ccNode != nullptr) {
-         const double newPrice = assetManager_->getPrice(currency);
-         const bool priceChanged = ccNode->SetPrice(newPrice);
-
-         if (priceChanged) {
-            dataChanged(index(ccGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , index(ccGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , {Qt::DisplayRole});
-
-            auto parentIndex = createIndex(ccGroup->getRow(), 0, static_cast<void*>(ccGroup));
-
-            dataChanged(index(ccNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-               , index(ccNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-               , {Qt::DisplayRole});
-         }
-      }
-   }
+   prices_[currency] = assetManager_->getPrice(currency);
+   dirtyCC_.insert(currency);
+   scheduleRevaluation();
 }
 
 void CCPortfolioModel::reloadXBTWalletsList()
@@ -901,41 +882,17 @@ void CCPortfolioModel::reloadXBTWalletsList()
 
    reloadCCWallets();
 
-   updateXBTBalance();
+   // Newly added nodes should get their values right away
+   xbtDirty_ = true;
+   ccBalancesDirty_ = true;
+   revalue();
 }
 
 void CCPortfolioModel::updateXBTBalance()
 {
-   if (root_->HaveXBTGroup()) {
-      auto xbtGroup = root_->GetXBTGroup();
-
-      bool balanceUpdated = false;
-
-      auto parentIndex = createIndex(xbtGroup->getRow(), 0, static_cast<void*>(xbtGroup));
-
-      for (const auto &hdWallet : walletsManager_->hdWallets()) {
-         const auto walletId = hdWallet->walletId();
-         const auto xbtNode = xbtGroup->GetXBTNode(walletId);
-         if (xbtNode != nullptr) {
-            const double balance = hdWallet->getTotalBalance();
-            if (xbtNode->SetXBTAmount(balance)) {
-               dataChanged(index(xbtNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-                  , index(xbtNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-                  , {Qt::DisplayRole});
-
-               balanceUpdated = true;
-            }
-         }
-      }
-
-      if (balanceUpdated) {
-         dataChanged(index(xbtGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , index(xbtGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , {Qt::DisplayRole});
-      }
-   }
-
-   updateCCBalance();
+   xbtDirty_ = true;
+   ccBalancesDirty_ = true;
+   scheduleRevaluation();
 }
 
 void CCPortfolioModel::reloadCCWallets()
@@ -991,34 +948,137 @@ void CCPortfolioModel::reloadCCWallets()
 
 void CCPortfolioModel::updateCCBalance()
 {
-   if (root_->HaveCCGroup()) {
-      auto ccGroup = root_->GetCCGroup();
+   ccBalancesDirty_ = true;
+   scheduleRevaluation();
+}
 
-      bool balanceUpdated = false;
+void CCPortfolioModel::scheduleRevaluation()
+{
+   if (!revaluationTimer_.isActive()) {
+      revaluationTimer_.start();
+   }
+}
 
-      auto parentIndex = createIndex(ccGroup->getRow(), 0, static_cast<void*>(ccGroup));
+double CCPortfolioModel::cachedPrice(const std::string &currency)
+{
+   const auto it = prices_.find(currency);
+   if (it != prices_.end()) {
+      return it->second;
+   }
+   const double price = assetManager_->getPrice(currency);
+   prices_[currency] = price;
+   return price;
+}
 
-      const auto privateShares = assetManager_->privateShares();
+void CCPortfolioModel::revalue()
+{
+   revaluationTimer_.stop();
 
-      for (const auto &ccName : privateShares) {
-         auto ccNode = ccGroup->GetCCNode(ccName);
-         if (ccNode != nullptr) {
-            const double balance = assetManager_->getBalance(ccName);
+   revalueXBT();
+   revalueCC();
+   revalueFX();
+}
 
-            if (ccNode->SetCCAmount(balance)) {
-               dataChanged(index(ccNode->getRow(), PortfolioColumns::BalanceColumn, parentIndex)
-                  , index(ccNode->getRow(), PortfolioColumns::XBTValueColumn, parentIndex)
-                  , {Qt::DisplayRole});
+void CCPortfolioModel::emitGroupChanged(AssetGroupNode *group, int firstRow, int lastRow)
+{
+   if (firstRow < 0) {
+      return;
+   }
+   const auto parentIndex = createIndex(group->getRow(), 0, static_cast<void*>(group));
+   emit dataChanged(index(firstRow, PortfolioColumns::BalanceColumn, parentIndex)
+      , index(lastRow, PortfolioColumns::XBTValueColumn, parentIndex)
+      , {Qt::DisplayRole});
+   emit dataChanged(index(group->getRow(), PortfolioColumns::XBTValueColumn)
+      , index(group->getRow(), PortfolioColumns::XBTValueColumn)
+      , {Qt::DisplayRole});
+}
 
-               balanceUpdated = true;
-            }
-         }
+void CCPortfolioModel::revalueFX()
+{
+   if (dirtyFX_.empty()) {
+      return;
+   }
+   if (!root_->HaveFXGroup()) {
+      dirtyFX_.clear();
+      return;
+   }
+
+   auto fxGroup = root_->GetFXGroup();
+   int firstRow = -1;
+   int lastRow = -1;
+
+   for (const auto &currency : dirtyFX_) {
+      auto fxNode = fxGroup->GetFXNode(currency);
+      if (!fxNode) {
+         continue;
+      }
+      const bool balanceChanged = fxNode->SetFXAmount(assetManager_->getBalance(currency));
+      const bool priceChanged = fxNode->SetPrice(cachedPrice(currency));
+      if (balanceChanged || priceChanged) {
+         extendRange(firstRow, lastRow, fxNode->getRow());
       }
+   }
+   dirtyFX_.clear();
+
+   emitGroupChanged(fxGroup, firstRow, lastRow);
+}
 
-      if (balanceUpdated) {
-         dataChanged(index(ccGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , index(ccGroup->getRow(), PortfolioColumns::XBTValueColumn)
-            , {Qt::DisplayRole});
+void CCPortfolioModel::revalueCC()
+{
+   if (ccBalancesDirty_) {
+      for (const auto &ccName : assetManager_->privateShares()) {
+         dirtyCC_.insert(ccName);
+      }
+      ccBalancesDirty_ = false;
+   }
+   if (dirtyCC_.empty()) {
+      return;
+   }
+   if (!root_->HaveCCGroup()) {
+      dirtyCC_.clear();
+      return;
+   }
+
+   auto ccGroup = root_->GetCCGroup();
+   int firstRow = -1;
+   int lastRow = -1;
+
+   for (const auto &ccName : dirtyCC_) {
+      auto ccNode = ccGroup->GetCCNode(ccName);
+      if (!ccNode) {
+         continue;
+      }
+      const bool balanceChanged = ccNode->SetCCAmount(assetManager_->getBalance(ccName));
+      const bool priceChanged = ccNode->SetPrice(cachedPrice(ccName));
+      if (balanceChanged || priceChanged) {
+         extendRange(firstRow, lastRow, ccNode->getRow());
       }
    }
+   dirtyCC_.clear();
+
+   emitGroupChanged(ccGroup, firstRow, lastRow);
+}
+
+void CCPortfolioModel::revalueXBT()
+{
+   if (!xbtDirty_) {
+      return;
+   }
+   xbtDirty_ = false;
+   if (!root_->HaveXBTGroup()) {
+      return;
+   }
+
+   auto xbtGroup = root_->GetXBTGroup();
+   int firstRow = -1;
+   int lastRow = -1;
+
+   for (const auto &hdWallet : walletsManager_->hdWallets()) {
+      const auto xbtNode = xbtGroup->GetXBTNode(hdWallet->walletId());
+      if ((xbtNode != nullptr) && xbtNode->SetXBTAmount(hdWallet->getTotalBalance())) {
+         extendRange(firstRow, lastRow, xbtNode->getRow());
+      }
+   }
+
+   emitGroupChanged(xbtGroup, firstRow, lastRow);
 }
@@ -12,7 +12,11 @@
 #define __CC_PORTFOLIO_MODEL__
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <QAbstractItemModel>
+#include <QTimer>
 
 namespace bs {
    namespace sync {
@@ -79,11 +83,30 @@ private slots:
    void reloadCCWallets();
    void updateCCBalance();
 
+   void revalue();
+
+private:
+   void scheduleRevaluation();
+   double cachedPrice(const std::string &currency);
+   void revalueFX();
+   void revalueCC();
+   void revalueXBT();
+   void emitGroupChanged(AssetGroupNode *group, int firstRow, int lastRow);
+
 private:
    std::shared_ptr<AssetManager>             assetManager_;
    std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
 
    std::shared_ptr<RootAssetGroupNode> root_ = nullptr;
+
+   // Price and balance updates only mark assets dirty, all of them are
+   // revalued at once when revaluationTimer_ fires
+   QTimer                                    revaluationTimer_;
+   std::unordered_map<std::string, double>   prices_;
+   std::unordered_set<std::string>           dirtyFX_;
+   std::unordered_set<std::string>           dirtyCC_;
+   bool                                      ccBalancesDirty_ = false;
+   bool                                      xbtDirty_ = false;
 };
 
 #endif // __CC_PORTFOLIO_MODEL__
\ No newline at end of file
@@ -12,10 +12,23 @@
 
 #include "OtcClient.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 using namespace bs::network;
 
 namespace {
    const auto kTogglingIntervalMs = std::chrono::milliseconds(250);
+
+   bool isDescendantOf(const PartyTreeItem* item, const PartyTreeItem* parent)
+   {
+      for (; item; item = item->parent()) {
+         if (item == parent) {
+            return true;
+         }
+      }
+      return false;
+   }
 }
 
 ChatPartiesTreeModel::ChatPartiesTreeModel(const Chat::ChatClientServicePtr& chatClientServicePtr, OtcClient *otcClient, QObject* parent)
@@ -36,71 +49,237 @@ ChatPartiesTreeModel::~ChatPartiesTreeModel() = default;
 void ChatPartiesTreeModel::onPartyModelChanged()
 {
    Chat::ClientPartyModelPtr clientPartyModelPtr = chatClientServicePtr_->getClientPartyModelPtr();
-   
-   // Save unseen state first
-   const auto reusableItemData = collectReusableData(rootItem_);
-
-   beginResetModel();
 
-   rootItem_->removeAll();
-   otcWatchIndx_.clear();
-
-   std::unique_ptr<PartyTreeItem> globalSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabGlobal, UI::ElementType::Container, rootItem_);
-   std::unique_ptr<PartyTreeItem> otcGlobalSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabOTCIdentifier, UI::ElementType::Container, rootItem_);
-   std::unique_ptr<PartyTreeItem> privateSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabPrivate, UI::ElementType::Container, rootItem_);
-   std::unique_ptr<PartyTreeItem> requestSection = std::make_unique<PartyTreeItem>(ChatModelNames::ContainerTabContactRequest, UI::ElementType::Container, rootItem_);
-
-   auto insertChild = [](PartyTreeItem* section, QVariant stored) -> PartyTreeItem* {
-      std::unique_ptr<PartyTreeItem> partyTreeItem = std::make_unique<PartyTreeItem>(stored, UI::ElementType::Party, section);
-      PartyTreeItem* pTreeItem = partyTreeItem.get();
-      section->insertChildren(std::move(partyTreeItem));
-      return pTreeItem;
-   };
+   createSections();
 
    const auto idPartyList = clientPartyModelPtr->getIdPartyList();
    const auto clientPartyPtrList = clientPartyModelPtr->getClientPartyListFromIdPartyList(idPartyList);
 
+   // Only changed parties are touched, so selection and unseen counters are kept
+   std::unordered_set<std::string> actualIds;
+   bool isStructureChanged = false;
    for (const auto& clientPartyPtr : clientPartyPtrList) {
       assert(clientPartyPtr);
 
-      QVariant stored;
-      stored.setValue(clientPartyPtr);
+      PartyTreeItem* section = sectionForParty(clientPartyPtr);
+      if (!section) {
+         continue;
+      }
+      actualIds.insert(clientPartyPtr->id());
 
-      if (clientPartyPtr->isGlobalOTC()) {
-         insertChild(otcGlobalSection.get(), stored);
+      auto it = partyItems_.find(clientPartyPtr->id());
+      if (it == partyItems_.end()) {
+         insertParty(section, clientPartyPtr);
+         isStructureChanged = true;
+         continue;
       }
-      else if (clientPartyPtr->isGlobal()) {
-         insertChild(globalSection.get(), stored);
+
+      PartyEntry& entry = it->second;
+      if (entry.item->parent() != section) {
+         moveParty(entry.item, section);
+         isStructureChanged = true;
       }
-      else if (clientPartyPtr->isPrivateStandard()) {
-         if (clientPartyPtr->partyState() == Chat::PartyState::REJECTED) {
-            continue;
-         }
 
-         PartyTreeItem* parentSection = clientPartyPtr->partyState() == Chat::PartyState::INITIALIZED ? privateSection.get() : requestSection.get();
-         PartyTreeItem* newChild = insertChild(parentSection, stored);
+      bool isItemChanged = (entry.state != clientPartyPtr->partyState());
+      if (entry.item->data().value<Chat::ClientPartyPtr>() != clientPartyPtr) {
+         QVariant stored;
+         stored.setValue(clientPartyPtr);
+         entry.item->setData(stored);
+         isItemChanged = true;
+      }
+      entry.state = clientPartyPtr->partyState();
 
-         assert(newChild);
-         auto it = reusableItemData.find(clientPartyPtr->id());
-         if (it != reusableItemData.end()) {
-            newChild->applyReusableData(it.value());
-         }
+      if (isItemChanged) {
+         const QModelIndex partyIndex = itemIndex(entry.item);
+         emit dataChanged(partyIndex, partyIndex);
       }
    }
 
-   rootItem_->insertChildren(std::move(globalSection));
-   rootItem_->insertChildren(std::move(otcGlobalSection));
-   rootItem_->insertChildren(std::move(privateSection));
-   rootItem_->insertChildren(std::move(requestSection));
+   for (auto it = partyItems_.begin(); it != partyItems_.end(); ) {
+      if (actualIds.find(it->first) != actualIds.end()) {
+         ++it;
+         continue;
+      }
+      removeParty(it->second.item);
+      it = partyItems_.erase(it);
+      isStructureChanged = true;
+   }
 
-   endResetModel();
-   emit restoreSelectedIndex();
+   if (updateOTCParties()) {
+      isStructureChanged = true;
+   }
 
-   if (!reusableItemData.isEmpty()) {
-      resetOTCUnseen({});
+   if (isStructureChanged) {
+      emit restoreSelectedIndex();
    }
+}
 
-   onGlobalOTCChanged(reusableItemData);
+void ChatPartiesTreeModel::createSections()
+{
+   if (rootItem_->childCount() != 0) {
+      return;
+   }
+
+   auto addSection = [this](const QString& name) -> PartyTreeItem* {
+      std::unique_ptr<PartyTreeItem> section = std::make_unique<PartyTreeItem>(name, UI::ElementType::Container, rootItem_);
+      PartyTreeItem* pSection = section.get();
+      rootItem_->insertChildren(std::move(section));
+      return pSection;
+   };
+
+   beginInsertRows({}, 0, 3);
+   globalSection_ = addSection(ChatModelNames::ContainerTabGlobal);
+   otcGlobalSection_ = addSection(ChatModelNames::ContainerTabOTCIdentifier);
+   privateSection_ = addSection(ChatModelNames::ContainerTabPrivate);
+   requestSection_ = addSection(ChatModelNames::ContainerTabContactRequest);
+   endInsertRows();
+}
+
+PartyTreeItem* ChatPartiesTreeModel::sectionForParty(const Chat::ClientPartyPtr& clientPartyPtr) const
+{
+   if (clientPartyPtr->isGlobalOTC()) {
+      return otcGlobalSection_;
+   }
+   if (clientPartyPtr->isGlobal()) {
+      return globalSection_;
+   }
+   if (clientPartyPtr->isPrivateStandard()) {
+      if (clientPartyPtr->partyState() == Chat::PartyState::REJECTED) {
+         return nullptr;
+      }
+      return clientPartyPtr->partyState() == Chat::PartyState::INITIALIZED ? privateSection_ : requestSection_;
+   }
+   return nullptr;
+}
+
+void ChatPartiesTreeModel::insertParty(PartyTreeItem* section, const Chat::ClientPartyPtr& clientPartyPtr)
+{
+   QVariant stored;
+   stored.setValue(clientPartyPtr);
+   std::unique_ptr<PartyTreeItem> partyTreeItem = std::make_unique<PartyTreeItem>(stored, UI::ElementType::Party, section);
+   partyItems_[clientPartyPtr->id()] = { partyTreeItem.get(), clientPartyPtr->partyState() };
+
+   const int row = section->childCount();
+   beginInsertRows(itemIndex(section), row, row);
+   section->insertChildren(std::move(partyTreeItem));
+   endInsertRows();
+}
+
+void ChatPartiesTreeModel::moveParty(PartyTreeItem* item, PartyTreeItem* section)
+{
+   PartyTreeItem* oldSection = item->parent();
+   const int row = item->childNumber();
+   const int newRow = section->childCount();
+
+   beginMoveRows(itemIndex(oldSection), row, row, itemIndex(section), newRow);
+   section->insertChildren(oldSection->takeChild(row));
+   endMoveRows();
+}
+
+void ChatPartiesTreeModel::removeParty(PartyTreeItem* item)
+{
+   resetOTCUnseen(itemIndex(item), false, false);
+   for (auto it = otcPartyItems_.begin(); it != otcPartyItems_.end(); ) {
+      if (isDescendantOf(it->second, item)) {
+         it = otcPartyItems_.erase(it);
+      }
+      else {
+         ++it;
+      }
+   }
+
+   PartyTreeItem* section = item->parent();
+   const int row = item->childNumber();
+   beginRemoveRows(itemIndex(section), row, row);
+   section->takeChild(row);
+   endRemoveRows();
+}
+
+bool ChatPartiesTreeModel::updateOTCParties()
+{
+   const QModelIndex otcGlobalModelIndex = getOTCGlobalRoot();
+   if (!otcGlobalModelIndex.isValid()) {
+      return false;
+   }
+
+   // Sent and received sections are created once global OTC party appears
+   PartyTreeItem* otcParty = static_cast<PartyTreeItem*>(otcGlobalModelIndex.internalPointer());
+   if (otcParty->childCount() != 2) {
+      onGlobalOTCChanged();
+      return false;
+   }
+
+   Chat::ClientPartyModelPtr clientPartyModelPtr = chatClientServicePtr_->getClientPartyModelPtr();
+   bool isStructureChanged = false;
+
+   // Peer parties are added, removed or replaced in place, other items are left untouched
+   const auto updateSection = [this, &clientPartyModelPtr, &isStructureChanged]
+      (PartyTreeItem* section, const otc::Peers &peers, otc::PeerType peerType, bool skipIdle)
+   {
+      std::vector<Chat::ClientPartyPtr> actualParties;
+      for (const auto &peer : peers) {
+         if (skipIdle && (peer->state == otc::State::Idle)) {
+            continue;
+         }
+         Chat::ClientPartyPtr otcPartyPtr = clientPartyModelPtr->getOtcPartyForUsers(currentUser(), peer->contactId);
+         if (otcPartyPtr) {
+            actualParties.push_back(otcPartyPtr);
+         }
+      }
+      const auto findActual = [&actualParties](const std::string &partyId) {
+         return std::find_if(actualParties.begin(), actualParties.end()
+            , [&partyId](const Chat::ClientPartyPtr &party) { return party->id() == partyId; });
+      };
+
+      for (int row = section->childCount() - 1; row >= 0; --row) {
+         PartyTreeItem* item = section->child(row);
+         const auto storedPartyPtr = item->data().value<Chat::ClientPartyPtr>();
+         const auto itActual = findActual(storedPartyPtr->id());
+         if (itActual != actualParties.end()) {
+            if (*itActual != storedPartyPtr) {
+               QVariant stored;
+               stored.setValue(*itActual);
+               item->setData(stored);
+               const QModelIndex partyIndex = itemIndex(item);
+               emit dataChanged(partyIndex, partyIndex);
+            }
+            actualParties.erase(itActual);
+            continue;
+         }
+
+         resetOTCUnseen(itemIndex(item), false, false);
+         for (auto it = otcPartyItems_.lower_bound(storedPartyPtr->id());
+            (it != otcPartyItems_.end()) && (it->first == storedPartyPtr->id()); ++it) {
+            if (it->second == item) {
+               otcPartyItems_.erase(it);
+               break;
+            }
+         }
+         beginRemoveRows(itemIndex(section), row, row);
+         section->takeChild(row);
+         endRemoveRows();
+         isStructureChanged = true;
+      }
+
+      for (const auto &otcPartyPtr : actualParties) {
+         QVariant stored;
+         stored.setValue(otcPartyPtr);
+         std::unique_ptr<PartyTreeItem> otcItem = std::make_unique<PartyTreeItem>(stored, UI::ElementType::Party, section);
+         otcItem->peerType = peerType;
+         otcPartyItems_.emplace(otcPartyPtr->id(), otcItem.get());
+
+         const int row = section->childCount();
+         beginInsertRows(itemIndex(section), row, row);
+         section->insertChildren(std::move(otcItem));
+         endInsertRows();
+         isStructureChanged = true;
+      }
+   };
+
+   // Show only responded requests in sent section
+   updateSection(otcParty->child(0), otcClient_->requests(), otc::PeerType::Request, true);
+   updateSection(otcParty->child(1), otcClient_->responses(), otc::PeerType::Response, false);
+   return isStructureChanged;
 }
 
 void ChatPartiesTreeModel::onGlobalOTCChanged(QMap<std::string, ReusableItemData> reusableItemData /* = {} */)
@@ -116,6 +295,7 @@ void ChatPartiesTreeModel::onGlobalOTCChanged(QMap<std::string, ReusableItemData
    }
 
    resetOTCUnseen(otcGlobalModelIndex, false, false);
+   otcPartyItems_.clear();
    if (otcParty->childCount() > 0) {
       beginRemoveRows(otcGlobalModelIndex, 0, otcParty->childCount() - 1);
       otcParty->removeAll();
@@ -139,6 +319,7 @@ void ChatPartiesTreeModel::onGlobalOTCChanged(QMap<std::string, ReusableItemData
          otcItem->applyReusableData(it.value());
       }
 
+      otcPartyItems_.emplace(otcPartyPtr->id(), otcItem.get());
       section->insertChildren(std::move(otcItem));
    };
 
@@ -171,6 +352,13 @@ void ChatPartiesTreeModel::onCleanModel()
 {
    beginResetModel();
    rootItem_->removeAll();
+   globalSection_ = nullptr;
+   otcGlobalSection_ = nullptr;
+   privateSection_ = nullptr;
+   requestSection_ = nullptr;
+   partyItems_.clear();
+   otcPartyItems_.clear();
+   otcWatchIndx_.clear();
    endResetModel();
 }
 
@@ -234,53 +422,38 @@ void ChatPartiesTreeModel::onUpdateOTCAwaitingColor()
 
 const QModelIndex ChatPartiesTreeModel::getPartyIndexById(const std::string& partyId, const QModelIndex parent) const
 {
-   PartyTreeItem* parentItem = nullptr;
-   if (parent.isValid()) {
-      parentItem = static_cast<PartyTreeItem*>(parent.internalPointer());
-   } 
-   else {
-      parentItem = rootItem_;
-   }
+   const PartyTreeItem* parentItem = getItem(parent);
    Q_ASSERT(parentItem);
 
-   QList<QPair<QModelIndex, PartyTreeItem*>> itemsToCheck;
-   itemsToCheck.push_back({ parent , parentItem });
-
-   QPair<QModelIndex, PartyTreeItem*> currentPair;
-   while (!itemsToCheck.isEmpty()) {
-      currentPair = itemsToCheck[0];
-      itemsToCheck.pop_front();
-
-      QModelIndex iterModelIndex = currentPair.first;
-      PartyTreeItem* iterItem= currentPair.second;
-
-
-      for (int iChild = 0; iChild < iterItem->childCount(); ++iChild) {
-         auto* child = iterItem->child(iChild);
-
-         auto childIndex = index(iChild, 0, iterModelIndex);
-         if (child->modelType() == UI::ElementType::Container && child->data().canConvert<QString>()) {
-            if (child->data().toString().toStdString() == partyId) {
-               return childIndex;
-            }
-         }
-         else if (child->modelType() == UI::ElementType::Party && child->data().canConvert<Chat::ClientPartyPtr>()) {
-            const Chat::ClientPartyPtr clientPtr = child->data().value<Chat::ClientPartyPtr>();
-            
-            if (!clientPtr) {
-               return {};
-            }
+   const auto itParty = partyItems_.find(partyId);
+   if ((itParty != partyItems_.end()) && isDescendantOf(itParty->second.item, parentItem)) {
+      return itemIndex(itParty->second.item);
+   }
 
-            if (clientPtr->id() == partyId) {
-               return childIndex;
-            }
-         }
+   for (auto itOtc = otcPartyItems_.lower_bound(partyId); (itOtc != otcPartyItems_.end()) && (itOtc->first == partyId); ++itOtc) {
+      if (isDescendantOf(itOtc->second, parentItem)) {
+         return itemIndex(itOtc->second);
+      }
+   }
 
-         if (child->childCount() != 0) {
-            itemsToCheck.push_back({ childIndex , child });
+   // Containers are identified by their names
+   const auto &findContainer = [this, &partyId, parentItem](PartyTreeItem* item) -> QModelIndex {
+      for (int iChild = 0; iChild < item->childCount(); ++iChild) {
+         PartyTreeItem* child = item->child(iChild);
+         if ((child->modelType() == UI::ElementType::Container) && isDescendantOf(child, parentItem)
+            && (child->data().toString().toStdString() == partyId)) {
+            return itemIndex(child);
          }
       }
-
+      return {};
+   };
+   const QModelIndex sectionIndex = findContainer(rootItem_);
+   if (sectionIndex.isValid()) {
+      return sectionIndex;
+   }
+   const QModelIndex otcGlobalIndex = getOTCGlobalRoot();
+   if (otcGlobalIndex.isValid()) {
+      return findContainer(static_cast<PartyTreeItem*>(otcGlobalIndex.internalPointer()));
    }
 
    return {};
@@ -298,54 +471,29 @@ PartyTreeItem* ChatPartiesTreeModel::getItem(const QModelIndex& index) const
    return rootItem_;
 }
 
-void ChatPartiesTreeModel::forAllPartiesInModel(PartyTreeItem* parent,
-   std::function<void(const PartyTreeItem*)>&& applyFunc) const
+QModelIndex ChatPartiesTreeModel::itemIndex(PartyTreeItem* item) const
 {
-   QList<PartyTreeItem*> itemsToCheck;
-   itemsToCheck.push_back(parent ? parent : rootItem_);
-
-   while (!itemsToCheck.isEmpty()) {
-      PartyTreeItem* item = itemsToCheck[0];
-      itemsToCheck.pop_front();
-
-      applyFunc(item);
-
-      for (int i = 0; i < item->childCount(); ++i) {
-         itemsToCheck.push_back(item->child(i));
-      }
+   if (!item || (item == rootItem_)) {
+      return {};
    }
+   return createIndex(item->childNumber(), 0, item);
 }
 
-void ChatPartiesTreeModel::forAllIndexesInModel(const QModelIndex& parentIndex,
-   std::function<void(const QModelIndex&)>&& applyFunc) const
+void ChatPartiesTreeModel::forAllPartiesInModel(const PartyTreeItem* parent,
+   std::function<void(PartyTreeItem*)>&& applyFunc) const
 {
-   PartyTreeItem* item = nullptr;
-   if (!parentIndex.isValid()) {
-      item = rootItem_;
-   }
-   else {
-      item = static_cast<PartyTreeItem*>(parentIndex.internalPointer());
+   if (!parent) {
+      parent = rootItem_;
    }
 
-   QList<QModelIndex> itemsToCheck;
-   if (parentIndex.isValid()) {
-      itemsToCheck.push_back(parentIndex);
-   }
-   else { // root item
-      for (int i = 0; i < rootItem_->childCount(); ++i) {
-         itemsToCheck.push_back(index(i, 0));
+   for (const auto& party : partyItems_) {
+      if (isDescendantOf(party.second.item, parent)) {
+         applyFunc(party.second.item);
       }
    }
-
-   while (!itemsToCheck.isEmpty()) {
-      QModelIndex itemIndex = std::move(itemsToCheck[0]);
-      itemsToCheck.pop_front();
-
-      applyFunc(itemIndex);
-
-      item = static_cast<PartyTreeItem*>(itemIndex.internalPointer());
-      for (int i = 0; i < item->childCount(); ++i) {
-         itemsToCheck.push_back(index(i, 0, itemIndex));
+   for (const auto& otcParty : otcPartyItems_) {
+      if (isDescendantOf(otcParty.second, parent)) {
+         applyFunc(otcParty.second);
       }
    }
 }
@@ -354,10 +502,6 @@ QMap<std::string, ReusableItemData> ChatPartiesTreeModel::collectReusableData(Pa
 {
    QMap<std::string, ReusableItemData> reusableData;
    forAllPartiesInModel(parent, [&](const PartyTreeItem* party) {
-      if (party->modelType() != UI::ElementType::Party) {
-         return;
-      }
-
       const Chat::ClientPartyPtr clientPtr = party->data().value<Chat::ClientPartyPtr>();
 
       if (party->unseenCount() != 0) {
@@ -375,20 +519,17 @@ void ChatPartiesTreeModel::resetOTCUnseen(const QModelIndex& parentIndex,
       otcWatchIndx_.clear();
    }
 
-   forAllIndexesInModel(parentIndex, [&](const QModelIndex& index) {
-      PartyTreeItem* item = static_cast<PartyTreeItem*>(index.internalPointer());
-      if (item->modelType() != UI::ElementType::Party) {
+   forAllPartiesInModel(getItem(parentIndex), [&](PartyTreeItem* item) {
+      if (!item->isOTCTogglingMode()) {
          return;
       }
 
-      if (item->isOTCTogglingMode()) {
-         if (isAddChildren) {
-            otcWatchIndx_.insert({ index });
-         }
-         else {
-            otcWatchIndx_.remove({ index });
-         }
-         
+      const QPersistentModelIndex index(itemIndex(item));
+      if (isAddChildren) {
+         otcWatchIndx_.insert(index);
+      }
+      else {
+         otcWatchIndx_.remove(index);
       }
    });
 }
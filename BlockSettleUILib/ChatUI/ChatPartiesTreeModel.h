@@ -11,6 +11,8 @@
 #ifndef CHATPARTYLISTMODEL_H
 #define CHATPARTYLISTMODEL_H
 
+#include <map>
+#include <unordered_map>
 #include <QAbstractItemModel>
 #include "ChatProtocol/ChatClientService.h"
 #include "PartyTreeItem.h"
@@ -49,13 +51,36 @@ private slots:
    void onUpdateOTCAwaitingColor();
 
 private:
+   struct PartyEntry
+   {
+      PartyTreeItem* item{};
+      Chat::PartyState state{};
+   };
+
    PartyTreeItem* getItem(const QModelIndex& index) const;
-   void forAllPartiesInModel(PartyTreeItem* parent, std::function<void(const PartyTreeItem*)>&& applyFunc) const;
-   void forAllIndexesInModel(const QModelIndex& parent, std::function<void(const QModelIndex&)>&& applyFunc) const;
+   QModelIndex itemIndex(PartyTreeItem* item) const;
+   void forAllPartiesInModel(const PartyTreeItem* parent, std::function<void(PartyTreeItem*)>&& applyFunc) const;
    QMap<std::string, ReusableItemData> collectReusableData(PartyTreeItem* parent);
    void resetOTCUnseen(const QModelIndex& parentIndex, bool isAddChildren = true, bool isClearAll = true);
 
+   void createSections();
+   PartyTreeItem* sectionForParty(const Chat::ClientPartyPtr& clientPartyPtr) const;
+   void insertParty(PartyTreeItem* section, const Chat::ClientPartyPtr& clientPartyPtr);
+   void moveParty(PartyTreeItem* item, PartyTreeItem* section);
+   void removeParty(PartyTreeItem* item);
+   // Returns true if OTC peer parties were added or removed
+   bool updateOTCParties();
+
    PartyTreeItem* rootItem_{};
+   PartyTreeItem* globalSection_{};
+   PartyTreeItem* otcGlobalSection_{};
+   PartyTreeItem* privateSection_{};
+   PartyTreeItem* requestSection_{};
+
+   // Parties of top-level sections by party id
+   std::unordered_map<std::string, PartyEntry> partyItems_;
+   // Parties under global OTC, the same party could be both in sent and received sections
+   std::multimap<std::string, PartyTreeItem*> otcPartyItems_;
 
    Chat::ChatClientServicePtr chatClientServicePtr_;
    OtcClient* otcClient_{};
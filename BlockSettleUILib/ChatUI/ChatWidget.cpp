@@ -193,7 +193,9 @@ void ChatWidget::init(const std::shared_ptr<ConnectionManager>& connectionManage
    connect(otcHelper_->client(), &OtcClient::sendPublicMessage, this, &ChatWidget::onSendOtcPublicMessage);
    connect(otcHelper_->client(), &OtcClient::peerUpdated, this, &ChatWidget::onOtcUpdated);
    connect(otcHelper_->client(), &OtcClient::publicUpdated, this, &ChatWidget::onOtcPublicUpdated);
-   connect(otcHelper_->client(), &OtcClient::publicUpdated, otcRequestViewModel_, &OTCRequestViewModel::onRequestsUpdated);
+   connect(otcHelper_->client(), &OtcClient::publicRequestAdded, otcRequestViewModel_, &OTCRequestViewModel::onRequestAdded);
+   connect(otcHelper_->client(), &OtcClient::publicRequestUpdated, otcRequestViewModel_, &OTCRequestViewModel::onRequestUpdated);
+   connect(otcHelper_->client(), &OtcClient::publicRequestRemoved, otcRequestViewModel_, &OTCRequestViewModel::onRequestRemoved);
    connect(otcHelper_->client(), &OtcClient::peerError, this, &ChatWidget::onOTCPeerError);
 
 
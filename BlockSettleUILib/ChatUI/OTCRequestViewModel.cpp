@@ -13,6 +13,8 @@
 #include "OtcClient.h"
 #include "OtcTypes.h"
 
+#include <algorithm>
+
 using namespace bs::network;
 
 namespace {
@@ -36,7 +38,17 @@ OTCRequestViewModel::OTCRequestViewModel(OtcClient *otcClient, QObject* parent)
    connect(&updateDurationTimer_, &QTimer::timeout, this, &OTCRequestViewModel::onUpdateDuration);
 
    updateDurationTimer_.setInterval(kUpdateTimerInterval);
-   updateDurationTimer_.start();
+
+   for (const auto &peer : otcClient_->requests()) {
+      onRequestAdded(peer->contactId, peer->request, peer->isOwnRequest);
+   }
+}
+
+OTCRequestViewModel::~OTCRequestViewModel()
+{
+   for (auto &request : request_) {
+      cancelExpiry(request);
+   }
 }
 
 int OTCRequestViewModel::rowCount(const QModelIndex &parent) const
@@ -102,23 +114,93 @@ QVariant OTCRequestViewModel::headerData(int section, Qt::Orientation orientatio
 
 QModelIndex OTCRequestViewModel::getIndexByTimestamp(QDateTime timeStamp)
 {
-   for (int iReq = 0; iReq < request_.size(); ++iReq) {
-      if (timeStamp == request_[iReq].request_.timestamp) {
-         return index(iReq, 0);
+   const auto it = idByTimestamp_.find(timeStamp);
+   if (it == idByTimestamp_.end()) {
+      return {};
+   }
+   const int row = rowById(it->second);
+   if (row < 0) {
+      return {};
+   }
+   return index(row, 0);
+}
+
+void OTCRequestViewModel::onRequestAdded(const std::string &requestId
+   , const otc::QuoteRequest &request, bool isOwnRequest)
+{
+   if (rowById(requestId) >= 0) {
+      onRequestUpdated(requestId, request, isOwnRequest);
+      return;
+   }
+
+   const int row = rowCount();
+   beginInsertRows({}, row, row);
+   request_.push_back({ requestId, request, isOwnRequest });
+   rowById_[requestId] = row;
+   idByTimestamp_.emplace(request.timestamp, requestId);
+   scheduleExpiry(request_.back());
+   endInsertRows();
+
+   if (!updateDurationTimer_.isActive()) {
+      updateDurationTimer_.start();
+   }
+}
+
+void OTCRequestViewModel::onRequestUpdated(const std::string &requestId
+   , const otc::QuoteRequest &request, bool isOwnRequest)
+{
+   const int row = rowById(requestId);
+   if (row < 0) {
+      onRequestAdded(requestId, request, isOwnRequest);
+      return;
+   }
+
+   auto &item = request_[size_t(row)];
+   if (item.request_.timestamp != request.timestamp) {
+      auto range = idByTimestamp_.equal_range(item.request_.timestamp);
+      for (auto it = range.first; it != range.second; ++it) {
+         if (it->second == requestId) {
+            idByTimestamp_.erase(it);
+            break;
+         }
       }
+      idByTimestamp_.emplace(request.timestamp, requestId);
    }
+   item.request_ = request;
+   item.isOwnRequest_ = isOwnRequest;
+   scheduleExpiry(item);
 
-   return {};
+   emit dataChanged(index(row, 0), index(row, static_cast<int>(Columns::Latest)));
 }
 
-void OTCRequestViewModel::onRequestsUpdated()
+void OTCRequestViewModel::onRequestRemoved(const std::string &requestId)
 {
-   beginResetModel();
-   request_.clear();
-   for (const auto &peer : otcClient_->requests()) {
-      request_.push_back({ peer->request, peer->isOwnRequest });
+   const int row = rowById(requestId);
+   if (row < 0) {
+      return;
+   }
+
+   auto &item = request_[size_t(row)];
+   cancelExpiry(item);
+   auto range = idByTimestamp_.equal_range(item.request_.timestamp);
+   for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == requestId) {
+         idByTimestamp_.erase(it);
+         break;
+      }
+   }
+
+   beginRemoveRows({}, row, row);
+   request_.erase(request_.begin() + row);
+   rowById_.erase(requestId);
+   for (int i = row; i < rowCount(); ++i) {
+      rowById_[request_[size_t(i)].id_] = i;
+   }
+   endRemoveRows();
+
+   if (request_.empty()) {
+      updateDurationTimer_.stop();
    }
-   endResetModel();
    emit restoreSelectedIndex();
 }
 
@@ -128,20 +210,40 @@ void OTCRequestViewModel::onUpdateDuration()
       return;
    }
 
-   const qint64 timeout = QDateTime::currentDateTime().toSecsSinceEpoch() - std::chrono::duration_cast<std::chrono::seconds>(
-      bs::network::otc::publicRequestTimeout()).count();
+   // Progress is calculated by OTCRequestsProgressDelegate from the timestamp,
+   // expired requests are removed by their own deadlines
+   emit dataChanged(index(0, static_cast<int>(Columns::Duration)),
+      index(rowCount() - 1, static_cast<int>(Columns::Duration)), { Qt::DisplayRole });
+}
+
+int OTCRequestViewModel::rowById(const std::string &requestId) const
+{
+   const auto it = rowById_.find(requestId);
+   return (it == rowById_.end()) ? -1 : it->second;
+}
 
-   auto it = std::remove_if(request_.begin(), request_.end(), [&](const OTCRequest& req) {
-      return req.request_.timestamp.toSecsSinceEpoch() < timeout;
+void OTCRequestViewModel::scheduleExpiry(OTCRequest &item)
+{
+   cancelExpiry(item);
+
+   const auto expiry = item.request_.timestamp.addSecs(std::chrono::duration_cast<std::chrono::seconds>(
+      otc::publicRequestTimeout()).count());
+   const auto timeLeft = std::chrono::milliseconds(std::max<qint64>(0
+      , QDateTime::currentDateTime().msecsTo(expiry)));
+   item.expiryId_ = bs::DeadlineScheduler::instance().schedule(bs::DeadlineScheduler::Clock::now() + timeLeft
+      , [this, requestId = item.id_] {
+      const int row = rowById(requestId);
+      if (row >= 0) {
+         request_[size_t(row)].expiryId_ = 0;
+      }
+      onRequestRemoved(requestId);
    });
+}
 
-   if (it != request_.end()) {
-      const int startIndex = std::distance(request_.begin(), it);
-      beginRemoveRows({}, startIndex, request_.size() - 1);
-      request_.erase(it, request_.end());
-      endRemoveRows();
+void OTCRequestViewModel::cancelExpiry(OTCRequest &item)
+{
+   if (item.expiryId_) {
+      bs::DeadlineScheduler::instance().cancel(item.expiryId_);
+      item.expiryId_ = 0;
    }
-
-   emit dataChanged(index(0, static_cast<int>(Columns::Duration)),
-      index(rowCount() - 1, static_cast<int>(Columns::Duration)), { Qt::DisplayRole });
 }
@@ -11,9 +11,12 @@
 #ifndef __OTC_REQUEST_VIEW_MODEL_H__
 #define __OTC_REQUEST_VIEW_MODEL_H__
 
+#include <map>
+#include <unordered_map>
 #include <QAbstractTableModel>
 #include <QTimer>
 
+#include "DeadlineScheduler.h"
 #include "OtcTypes.h"
 
 class OtcClient;
@@ -30,7 +33,7 @@ class OTCRequestViewModel : public QAbstractTableModel
 
 public:
    OTCRequestViewModel(OtcClient *otcClient, QObject* parent = nullptr);
-   ~OTCRequestViewModel() override = default;
+   ~OTCRequestViewModel() override;
 
    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -52,7 +55,9 @@ public:
    };
 
 public slots:
-   void onRequestsUpdated();
+   void onRequestAdded(const std::string &requestId, const bs::network::otc::QuoteRequest &request, bool isOwnRequest);
+   void onRequestUpdated(const std::string &requestId, const bs::network::otc::QuoteRequest &request, bool isOwnRequest);
+   void onRequestRemoved(const std::string &requestId);
 
 private slots:
    void onUpdateDuration();
@@ -63,10 +68,19 @@ signals:
 private:
    struct OTCRequest
    {
+      std::string id_;
       bs::network::otc::QuoteRequest request_;
       bool isOwnRequest_;
+      bs::DeadlineScheduler::Id expiryId_{};
    };
+
+   int rowById(const std::string &requestId) const;
+   void scheduleExpiry(OTCRequest &);
+   void cancelExpiry(OTCRequest &);
+
    std::vector<OTCRequest> request_;
+   std::unordered_map<std::string, int> rowById_;
+   std::multimap<QDateTime, std::string> idByTimestamp_;
 
    OtcClient *otcClient_{};
    QTimer updateDurationTimer_;
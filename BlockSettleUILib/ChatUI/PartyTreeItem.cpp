@@ -44,15 +44,30 @@ QVariant PartyTreeItem::data() const
 
 bool PartyTreeItem::insertChildren(std::unique_ptr<PartyTreeItem>&& item)
 {
+   item->parentItem_ = this;
    childItems_.push_back(std::move(item));
    return true;
 }
 
+std::unique_ptr<PartyTreeItem> PartyTreeItem::takeChild(int number)
+{
+   Q_ASSERT(number >= 0 && number < childItems_.size());
+   auto item = std::move(childItems_[number]);
+   childItems_.erase(childItems_.begin() + number);
+   item->parentItem_ = nullptr;
+   return item;
+}
+
 PartyTreeItem* PartyTreeItem::parent()
 {
    return parentItem_;
 }
 
+const PartyTreeItem* PartyTreeItem::parent() const
+{
+   return parentItem_;
+}
+
 void PartyTreeItem::removeAll()
 {
    childItems_.clear();
@@ -55,7 +55,9 @@ public:
    QVariant data() const;
 
    bool insertChildren(std::unique_ptr<PartyTreeItem>&& item);
+   std::unique_ptr<PartyTreeItem> takeChild(int number);
    PartyTreeItem* parent();
+   const PartyTreeItem* parent() const;
    void removeAll();
    int childNumber() const;
    bool setData(const QVariant& value);
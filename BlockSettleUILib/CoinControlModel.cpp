@@ -9,6 +9,9 @@
 
 */
 #include "CoinControlModel.h"
+#include <algorithm>
+#include <future>
+#include <thread>
 #include <QColor>
 #include <QList>
 #include <QString>
@@ -54,6 +57,7 @@ public:
    CoinControlNode& operator = (CoinControlNode&&) = delete;
 
    int getRow() const { return row_; }
+   void setRow(int row) { row_ = row; }
 
    QString getName() const { return name_; }
    QString getComment() const { return comment_; }
@@ -316,29 +320,29 @@ private:
 
 
 void CoinControlNode::sort(int column, Qt::SortOrder order) {
-   qSort(std::begin(children_), std::end(children_)
-      , [column, order](CoinControlNode* left, CoinControlNode* right) {
-      bool res = true;
+   const auto lessThan = [column](CoinControlNode* left, CoinControlNode* right) {
       switch(column){
       case 0:
-         res = (left->type_ != right->type_) ? (left->type_ < right->type_) : (left->getName().compare(right->getName()) < 0);
-         break;
+         return (left->type_ != right->type_) ? (left->type_ < right->type_) : (left->name_.compare(right->name_) < 0);
       case 1:
-         res = left->getUtxoCount() < right->getUtxoCount();
-         break;
+         return left->getUtxoCount() < right->getUtxoCount();
       case 2:
-         res = left->getComment().compare(right->getComment()) < 0;
-         break;
+         return left->comment_.compare(right->comment_) < 0;
       default:
-         res = ((TransactionNode*)left)->getTotalAmount() < ((TransactionNode*)right)->getTotalAmount();
-         break;
+         return left->getTotalAmount() < right->getTotalAmount();
       }
+   };
+   if (order == Qt::DescendingOrder) {
+      std::stable_sort(std::begin(children_), std::end(children_)
+         , [lessThan](CoinControlNode* left, CoinControlNode* right) { return lessThan(right, left); });
+   }
+   else {
+      std::stable_sort(std::begin(children_), std::end(children_), lessThan);
+   }
 
-      if (order == Qt::DescendingOrder)
-         return !res;
-
-      return res;
-   });
+   for (int i = 0; i < children_.size(); ++i) {
+      children_[i]->setRow(i);
+   }
 }
 
 CoinControlModel::CoinControlModel(const std::shared_ptr<SelectedTransactionInputs> &selectedInputs, QObject* parent)
@@ -396,7 +400,9 @@ bool CoinControlModel::setData(const QModelIndex& index, const QVariant& value,
       }
       node->setCheckedState(value.toInt());
 
-      emit layoutChanged();
+      // Selection totals are propagated up the tree incrementally by nodes
+      // themselves - only the affected rows need to be repainted
+      emitNodeChanged(node);
       emit selectionChanged();
       return true;
    }
@@ -516,6 +522,37 @@ CoinControlNode* CoinControlModel::getNodeByIndex(const QModelIndex& index) cons
    return static_cast<CoinControlNode*>(index.internalPointer());
 }
 
+QModelIndex CoinControlModel::indexForNode(CoinControlNode *node, int column) const
+{
+   if (!node || (node == root_.get())) {
+      return QModelIndex();
+   }
+   return createIndex(node->getRow(), column, static_cast<void*>(node));
+}
+
+void CoinControlModel::emitSubtreeChanged(CoinControlNode *node)
+{
+   if (!node->hasChildren()) {
+      return;
+   }
+   const auto parentIdx = indexForNode(node);
+   const int nbChildren = static_cast<int>(node->nbChildren());
+   emit dataChanged(index(0, 0, parentIdx)
+      , index(nbChildren - 1, ColumnsCount - 1, parentIdx));
+   for (int i = 0; i < nbChildren; ++i) {
+      emitSubtreeChanged(node->getChild(i));
+   }
+}
+
+void CoinControlModel::emitNodeChanged(CoinControlNode *node)
+{
+   // Check state propagates to all descendants, not only direct children
+   emitSubtreeChanged(node);
+   for (auto n = node; n && (n != root_.get()); n = n->getParent()) {
+      emit dataChanged(indexForNode(n), indexForNode(n, ColumnsCount - 1));
+   }
+}
+
 static int addressWeight(const bs::Address &addr)
 {
    if (!addr.isValid()) {
@@ -531,84 +568,127 @@ static int addressWeight(const bs::Address &addr)
    }
 }
 
-void CoinControlModel::loadInputs(const std::shared_ptr<SelectedTransactionInputs>& selectedInputs)
-{
-   struct InputKey {
-      UTXO  utxo;
-      int   index;
+namespace {
+   // Everything derived from UTXO that is needed for sorting and grouping is
+   // calculated once per input instead of on each comparison
+   struct PreparedInput {
+      UTXO        utxo;
+      int         index;
+      bool        selected;
+      bs::Address address;
+      std::string addrStr;
+      int         weight;
+   };
 
-      bool operator<(const InputKey &other) const
-      {
-         const auto aw1 = addressWeight(bs::Address::fromUTXO(utxo));
-         const auto aw2 = addressWeight(bs::Address::fromUTXO(other.utxo));
-         if (aw1 != aw2) {
-            return aw1 < aw2;
-         }
-         if (index != other.index) {
-            return (index < other.index);
+   const size_t kParallelPrepareThreshold = 2048;
+
+   void prepareInputs(std::vector<PreparedInput> &inputs)
+   {
+      const auto prepareRange = [&inputs](size_t start, size_t end) {
+         for (size_t i = start; i < end; ++i) {
+            auto &input = inputs[i];
+            input.address = bs::Address::fromUTXO(input.utxo);
+            input.addrStr = input.address.display();
+            input.weight = addressWeight(input.address);
          }
-         return (utxo < other.utxo);
+      };
+
+      const size_t nbThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+      if ((inputs.size() < kParallelPrepareThreshold) || (nbThreads == 1)) {
+         prepareRange(0, inputs.size());
+         return;
+      }
+
+      const size_t chunkSize = (inputs.size() + nbThreads - 1) / nbThreads;
+      std::vector<std::future<void>> futures;
+      for (size_t start = chunkSize; start < inputs.size(); start += chunkSize) {
+         futures.emplace_back(std::async(std::launch::async, prepareRange
+            , start, std::min(start + chunkSize, inputs.size())));
+      }
+      prepareRange(0, std::min(chunkSize, inputs.size()));
+      for (auto &future : futures) {
+         future.get();
       }
-   };
-   struct UtxoState {
-      bool selected;
-      bool enabled;
-   };
-   std::map<InputKey, UtxoState> inputs;
-   for (int i = 0; i < selectedInputs->GetTransactionsCount(); ++i) {
-      inputs[{selectedInputs->GetTransaction(i), i}] = {
-         selectedInputs->IsTransactionSelected(i), true };
    }
+}
+
+void CoinControlModel::loadInputs(const std::shared_ptr<SelectedTransactionInputs>& selectedInputs)
+{
+   const auto wallet = selectedInputs->GetWallet();
+   const auto incompleteUtxos = selectedInputs->getIncompleteUTXOs();
 
-   for (const auto &utxo : selectedInputs->getIncompleteUTXOs()) {
-      inputs[{utxo, -1}] = { false, false };
+   std::vector<PreparedInput> inputs;
+   inputs.reserve(selectedInputs->GetTransactionsCount() + incompleteUtxos.size());
+   for (int i = 0; i < selectedInputs->GetTransactionsCount(); ++i) {
+      inputs.push_back({ selectedInputs->GetTransaction(i), i
+         , selectedInputs->IsTransactionSelected(i) });
+   }
+   for (const auto &utxo : incompleteUtxos) {
+      inputs.push_back({ utxo, -1, false });
    }
+   prepareInputs(inputs);
 
-   for (const auto &input : inputs) {
-      const auto address = bs::Address::fromUTXO(input.first.utxo);
-      const auto addrStr = address.display();
+   const auto inputLess = [](const PreparedInput &a, const PreparedInput &b) {
+      if (a.weight != b.weight) {
+         return a.weight < b.weight;
+      }
+      if (a.index != b.index) {
+         return (a.index < b.index);
+      }
+      return (a.utxo < b.utxo);
+   };
+   std::sort(inputs.begin(), inputs.end(), inputLess);
+   inputs.erase(std::unique(inputs.begin(), inputs.end()
+      , [inputLess](const PreparedInput &a, const PreparedInput &b) {
+         return !inputLess(a, b) && !inputLess(b, a);
+      }), inputs.end());
 
-      auto addressIt = addressNodes_.find(addrStr);
+   addressNodes_.reserve(inputs.size());
+   for (const auto &input : inputs) {
+      auto addressIt = addressNodes_.find(input.addrStr);
       AddressNode *addressNode = nullptr;
 
       if (addressIt == addressNodes_.end()) {
-         auto wallet = selectedInputs->GetWallet();
-         auto comment = wallet ? wallet->getAddressComment(bs::Address::fromHash(input.first.utxo.getRecipientScrAddr())) : "";
-         addressNode = new AddressNode(CoinControlNode::detectType(address), QString::fromStdString(address.display())
+         auto comment = wallet ? wallet->getAddressComment(bs::Address::fromHash(input.utxo.getRecipientScrAddr())) : "";
+         addressNode = new AddressNode(CoinControlNode::detectType(input.address), QString::fromStdString(input.addrStr)
             , QString::fromStdString(comment), (int)addressNodes_.size(), root_.get());
          root_->appendChildNode(addressNode);
-         addressNodes_.emplace(addrStr, addressNode);
+         addressNodes_.emplace(input.addrStr, addressNode);
       } else {
          addressNode = static_cast<AddressNode*>(addressIt->second);
       }
-      addressNode->addTransaction(new TransactionNode(input.second.selected
-         , input.first.index, input.first.utxo, selectedInputs->GetWallet(), addressNode));    //TODO: Add TX comment
+      addressNode->addTransaction(new TransactionNode(input.selected
+         , input.index, input.utxo, wallet, addressNode));    //TODO: Add TX comment
    }
 
    const auto cpfpList = selectedInputs->GetCPFPInputs();
    if (!cpfpList.empty()) {
+      std::vector<PreparedInput> cpfpInputs;
+      cpfpInputs.reserve(cpfpList.size());
+      for (size_t i = 0; i < cpfpList.size(); i++) {
+         const auto isSel = selectedInputs->IsTransactionSelected(i + selectedInputs->GetTransactionsCount());
+         cpfpInputs.push_back({ cpfpList[i], static_cast<int>(i), isSel });
+      }
+      prepareInputs(cpfpInputs);
+
       cpfp_ = std::make_shared<AddressNode>(CoinControlNode::Type::CpfpRoot, tr("CPFP Eligible Outputs"), tr("Child-Pays-For-Parent transactions")
          , addressNodes_.size(), root_.get());
       root_->appendChildNode(cpfp_.get());
-      for (size_t i = 0; i < cpfpList.size(); i++) {
-         const auto &input = cpfpList[i];
-         const auto address = bs::Address::fromUTXO(input);
-         const auto addrStr = address.display();
+      for (const auto &input : cpfpInputs) {
          AddressNode *addressNode = nullptr;
-         const auto itAddr = cpfpNodes_.find(addrStr);
+         const auto itAddr = cpfpNodes_.find(input.addrStr);
 
          if (itAddr == cpfpNodes_.end()) {
             const int row = cpfpNodes_.size();
-            addressNode = new AddressNode(CoinControlNode::Type::DoesNotMatter, QString::fromStdString(address.display())
-               , QString::fromStdString(selectedInputs->GetWallet()->getAddressComment(bs::Address::fromHash(input.getRecipientScrAddr()))), row, cpfp_.get());
+            addressNode = new AddressNode(CoinControlNode::Type::DoesNotMatter, QString::fromStdString(input.addrStr)
+               , QString::fromStdString(wallet->getAddressComment(bs::Address::fromHash(input.utxo.getRecipientScrAddr()))), row, cpfp_.get());
             cpfp_->appendChildNode(addressNode);
-            cpfpNodes_[addrStr] = addressNode;
+            cpfpNodes_[input.addrStr] = addressNode;
          }
          else {
             addressNode = static_cast<AddressNode *>(itAddr->second);
          }
-         const auto isSel = selectedInputs->IsTransactionSelected(i + selectedInputs->GetTransactionsCount());
-         addressNode->addTransaction(new CPFPTransactionNode(isSel, i, input, selectedInputs->GetWallet(), addressNode));
+         addressNode->addTransaction(new CPFPTransactionNode(input.selected, input.index, input.utxo, wallet, addressNode));
       }
    }
 }
@@ -632,7 +712,23 @@ void CoinControlModel::selectAll(int sel)
 }
 
 void CoinControlModel::sort(int column, Qt::SortOrder order){
+   if ((column == sortColumn_) && (order == sortOrder_)) {
+      return;
+   }
+   emit layoutAboutToBeChanged();
+   const auto oldIndices = persistentIndexList();
+   // Re-sort even if only the order was flipped: reversing would also swap
+   // rows that compare equal, and stable_sort keeps them in place
    root_->sort(column, order);
+   sortColumn_ = column;
+   sortOrder_ = order;
+
+   QModelIndexList newIndices;
+   newIndices.reserve(oldIndices.size());
+   for (const auto &idx : oldIndices) {
+      newIndices.push_back(indexForNode(getNodeByIndex(idx), idx.column()));
+   }
+   changePersistentIndexList(oldIndices, newIndices);
    emit layoutChanged();
    emit selectionChanged();
 }
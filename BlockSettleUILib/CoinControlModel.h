@@ -74,6 +74,9 @@ public slots:
 
 private:
    CoinControlNode* getNodeByIndex(const QModelIndex& index) const;
+   QModelIndex indexForNode(CoinControlNode *node, int column = 0) const;
+   void emitNodeChanged(CoinControlNode *node);
+   void emitSubtreeChanged(CoinControlNode *node);
 
    void loadInputs(const std::shared_ptr<SelectedTransactionInputs> &selectedInputs);
 
@@ -81,6 +84,8 @@ private:
    std::shared_ptr<CoinControlNode>    root_, cpfp_;
    std::shared_ptr<bs::sync::Wallet>   wallet_;
    std::unordered_map<std::string, CoinControlNode*> addressNodes_, cpfpNodes_;
+   int            sortColumn_{ -1 };
+   Qt::SortOrder  sortOrder_{ Qt::AscendingOrder };
 };
 
 #endif // __COIN_CONTROL_MODEL_H__
@@ -0,0 +1,84 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "CustomTreeView.h"
+#include <QMouseEvent>
+#include <QHeaderView>
+#include <QClipboard>
+#include <QToolTip>
+
+CustomTreeView::CustomTreeView(QWidget *parent)
+   : QTreeView(parent)
+   , cursorHand_(false)
+{
+   setMouseTracking(true);
+
+   connect(this, &QAbstractItemView::entered, this, &CustomTreeView::onEntered);
+   connect(header(), &QHeaderView::entered, this, [this] { resetCursor(); });
+}
+
+void CustomTreeView::mouseReleaseEvent(QMouseEvent *ev)
+{
+   if (ev->button() == Qt::RightButton) {
+      const auto index = indexAt(ev->pos());
+      if (index.isValid() && copyToClipboardColumns_.contains(index.column())) {
+         const auto text = index.data().toString();
+         QApplication::clipboard()->setText(text);
+         QPoint p = ev->pos();
+         p.setY(p.y() + 3);
+         // placing the tooltip in a timer because mouseReleaseEvent messes with it otherwise
+         QTimer::singleShot(50, this, [this, p, text] {
+            QToolTip::showText(viewport()->mapToGlobal(p), tr("Copied '") + text + tr("' to clipboard."), this);
+         });
+      }
+   }
+   QTreeView::mouseReleaseEvent(ev);
+}
+
+void CustomTreeView::leaveEvent(QEvent *ev)
+{
+   // reset the mouse cursor when it leaves the tree
+   resetCursor();
+   QTreeView::leaveEvent(ev);
+}
+
+void CustomTreeView::mouseMoveEvent(QMouseEvent *ev)
+{
+   if (!indexAt(ev->pos()).isValid()) {
+      // reset the mouse cursor when it's not hovering over an item
+      resetCursor();
+   }
+   QTreeView::mouseMoveEvent(ev);
+}
+
+void CustomTreeView::onEntered(const QModelIndex &index)
+{
+   if (handCursorColumns_.contains(index.column())) {
+      setHandCursor();
+   }
+   else {
+      resetCursor();
+   }
+}
+
+// Resizes each column based on its current data width with 5px margin
+void CustomTreeView::resizeColumns()
+{
+   if (!model()) {
+      return;
+   }
+   const int count = model()->columnCount();
+   for (int i = 0; i < count; ++i) {
+      resizeColumnToContents(i);
+      if (i < count - 1) {
+         setColumnWidth(i, columnWidth(i) + 5);
+      }
+   }
+}
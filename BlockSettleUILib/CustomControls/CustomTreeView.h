@@ -0,0 +1,51 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef CUSTOMTREEVIEW_H
+#define CUSTOMTREEVIEW_H
+
+#include <QTreeView>
+#include <QApplication>
+#include <QTimer>
+
+// Model-based counterpart of CustomTreeWidget
+class CustomTreeView : public QTreeView
+{
+   Q_OBJECT
+public:
+   CustomTreeView(QWidget *parent = nullptr);
+   QList<int> handCursorColumns_;
+   QList<int> copyToClipboardColumns_;
+   void resizeColumns();
+
+protected slots:
+   void onEntered(const QModelIndex &);
+
+protected:
+   void mouseReleaseEvent(QMouseEvent *ev) override;
+   void leaveEvent(QEvent *ev) override;
+   void mouseMoveEvent(QMouseEvent *ev) override;
+   bool cursorHand_;
+
+   void resetCursor() {
+      if (cursorHand_) {
+         QApplication::restoreOverrideCursor();
+         cursorHand_ = false;
+      }
+   }
+   void setHandCursor() {
+      if (!cursorHand_) {
+         QApplication::setOverrideCursor(QCursor(Qt::PointingHandCursor));
+         cursorHand_ = true;
+      }
+   }
+};
+
+#endif // CUSTOMTREEVIEW_H
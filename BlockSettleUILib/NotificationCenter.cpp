@@ -14,23 +14,174 @@
 #include "BSMessageBox.h"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+
 #if defined (Q_OS_WIN)
 #include <shellapi.h>
 #else
 #include <stdlib.h>
 #endif
 
+namespace {
+   const auto kCoalescingWindow = std::chrono::milliseconds(500);
+   const auto kPopupInterval = std::chrono::seconds(2);
+   const size_t kMaxQueuedPopups = 3;
+}
+
 static std::shared_ptr<NotificationCenter> globalInstance = nullptr;
 
-NotificationCenter::NotificationCenter(const std::shared_ptr<spdlog::logger> &logger
-   , const std::shared_ptr<ApplicationSettings> &appSettings
-   , const Ui::BSTerminalMainWindow *mainWinUi
-   , const std::shared_ptr<QSystemTrayIcon> &trayIcon, QObject *parent)
+using namespace bs::ui;
+
+NotificationCoalescer::NotificationCoalescer(std::chrono::milliseconds window
+   , const Callback &cb, QObject *parent)
+   : QObject(parent)
+   , cb_(cb)
+   , window_(window)
+{
+   timer_.setSingleShot(true);
+   connect(&timer_, &QTimer::timeout, this, &NotificationCoalescer::flush);
+}
+
+void NotificationCoalescer::push(NotifyType nt, const NotifyMessage &msg)
+{
+   QString target;
+   if ((window_.count() <= 0) || !isCoalesced(nt, msg, target)) {
+      flush();
+      cb_(nt, msg);
+      return;
+   }
+
+   // BlockchainTX could carry number of TXs it reports as 3rd item
+   const int nbItems = ((nt == NotifyType::BlockchainTX) && (msg.size() > 2)) ? std::max(1, msg[2].toInt()) : 1;
+   for (auto &bucket : buckets_) {
+      if ((bucket.type == nt) && (bucket.target == target)) {
+         bucket.last = msg;
+         bucket.count++;
+         bucket.nbItems += nbItems;
+         return;
+      }
+   }
+   buckets_.push_back({ nt, target, msg, 1, nbItems });
+   if (!timer_.isActive()) {
+      timer_.start(static_cast<int>(window_.count()));
+   }
+}
+
+void NotificationCoalescer::flush()
+{
+   timer_.stop();
+   const auto buckets = std::move(buckets_);
+   buckets_.clear();
+   for (const auto &bucket : buckets) {
+      cb_(bucket.type, (bucket.count == 1) ? bucket.last : summary(bucket));
+   }
+}
+
+bool NotificationCoalescer::isCoalesced(NotifyType nt, const NotifyMessage &msg, QString &target) const
+{
+   switch (nt) {
+   case NotifyType::BlockchainTX:
+   case NotifyType::DealerQuotes:
+      return true;
+
+   case NotifyType::UpdateUnreadMessage:
+      if (msg.size() != 4) {
+         return false;
+      }
+      target = msg[2].toString();
+      return true;
+
+   case NotifyType::CelerOrder:
+      if (msg.size() < 2) {
+         return false;
+      }
+      target = msg[0].toString() + QLatin1Char(':') + msg[1].toString();
+      return true;
+
+   case NotifyType::AuthAddress:
+      if (msg.empty()) {
+         return false;
+      }
+      target = msg[0].toString();
+      return true;
+
+   default:
+      return false;
+   }
+}
+
+NotifyMessage NotificationCoalescer::summary(const Bucket &bucket) const
+{
+   switch (bucket.type) {
+   case NotifyType::BlockchainTX:
+      return { QObject::tr("New blockchain transactions")
+         , QObject::tr("%1 new transactions").arg(bucket.nbItems), bucket.nbItems };
+
+   case NotifyType::UpdateUnreadMessage: {
+      auto msg = bucket.last;
+      msg[1] = QObject::tr("%1 new messages").arg(bucket.count);
+      return msg;
+   }
+
+   default:    // the latest state is enough
+      return bucket.last;
+   }
+}
+
+
+CallRateLimiter::CallRateLimiter(std::chrono::milliseconds interval, size_t maxQueued
+   , QObject *parent)
+   : QObject(parent)
+   , interval_(interval)
+   , maxQueued_(maxQueued)
+{
+   timer_.setSingleShot(true);
+   connect(&timer_, &QTimer::timeout, this, &CallRateLimiter::onTimeout);
+}
+
+void CallRateLimiter::call(const std::function<void()> &f)
+{
+   if (!timer_.isActive()) {
+      f();
+      timer_.start(static_cast<int>(interval_.count()));
+      return;
+   }
+   queue_.push_back(f);
+   while (queue_.size() > maxQueued_) {
+      queue_.pop_front();
+      nbDropped_++;
+   }
+}
+
+void CallRateLimiter::onTimeout()
+{
+   if (queue_.empty()) {
+      return;
+   }
+   const auto f = std::move(queue_.front());
+   queue_.pop_front();
+   f();
+   timer_.start(static_cast<int>(interval_.count()));
+}
+
+
+NotificationCenter::NotificationCenter(const std::shared_ptr<spdlog::logger> &logger, QObject *parent)
    : QObject(parent)
+   , logger_(logger)
+   , coalescer_(kCoalescingWindow, [this](NotifyType nt, const NotifyMessage &msg) {
+         emit notifyEndpoint(nt, msg);
+      })
 {
    qRegisterMetaType<bs::ui::NotifyType>("NotifyType");
    qRegisterMetaType<bs::ui::NotifyMessage>("NotifyMessage");
+}
 
+NotificationCenter::NotificationCenter(const std::shared_ptr<spdlog::logger> &logger
+   , const std::shared_ptr<ApplicationSettings> &appSettings
+   , const Ui::BSTerminalMainWindow *mainWinUi
+   , const std::shared_ptr<QSystemTrayIcon> &trayIcon, QObject *parent)
+   : NotificationCenter(logger, parent)
+{
    addResponder(std::make_shared<NotificationTabResponder>(mainWinUi, appSettings, this));
    addResponder(std::make_shared<NotificationTrayIconResponder>(logger, mainWinUi, trayIcon, appSettings, this));
 }
@@ -61,7 +212,10 @@ void NotificationCenter::notify(bs::ui::NotifyType nt, const bs::ui::NotifyMessa
 
 void NotificationCenter::enqueue(bs::ui::NotifyType nt, const bs::ui::NotifyMessage &msg)
 {
-   emit notifyEndpoint(nt, msg);
+   // Coalescer's timer lives in the GUI thread
+   QMetaObject::invokeMethod(this, [this, nt, msg] {
+      coalescer_.push(nt, msg);
+   });
 }
 
 void NotificationCenter::addResponder(const std::shared_ptr<NotificationResponder> &responder)
@@ -122,6 +276,7 @@ NotificationTrayIconResponder::NotificationTrayIconResponder(const std::shared_p
    , logger_(logger)
    , mainWinUi_(mainWinUi)
    , trayIcon_(trayIcon)
+   , popupLimiter_(kPopupInterval, kMaxQueuedPopups)
    , appSettings_(appSettings)
    , notifMode_(QSystemTray)
 #ifdef BS_USE_DBUS
@@ -150,10 +305,10 @@ void NotificationTrayIconResponder::respond(bs::ui::NotifyType nt, bs::ui::Notif
    QSystemTrayIcon::MessageIcon icon = QSystemTrayIcon::Information;
    QString title, text, userId;
    int msecs = 10000;
-   newVersionMessage_ = false;
-   newChatMessage_ = false;
-   newChatId_ = QString();
-   
+   bool newVersionMessage = false;
+   bool newChatMessage = false;
+   QString newChatId;
+
    const int chatIndex = mainWinUi_->tabWidget->indexOf(mainWinUi_->widgetChat);
    const bool isChatTabActive = mainWinUi_->tabWidget->currentIndex() == chatIndex && QApplication::activeWindow();
    auto updateChatIconAndCheckChatTab = [&]() -> bool {
@@ -213,7 +368,7 @@ void NotificationTrayIconResponder::respond(bs::ui::NotifyType nt, bs::ui::Notif
       title = tr("New Terminal version: %1").arg(msg[0].toString());
       text = tr("Click this message to download it from BlockSettle's official site");
       msecs = 30000;
-      newVersionMessage_ = true;
+      newVersionMessage = true;
       break;
 
    case bs::ui::NotifyType::UpdateUnreadMessage: {
@@ -234,8 +389,8 @@ void NotificationTrayIconResponder::respond(bs::ui::NotifyType nt, bs::ui::Notif
          return;
       }
 
-      newChatMessage_ = true;
-      newChatId_ = userId;
+      newChatMessage = true;
+      newChatId = userId;
       break;
    }
    case bs::ui::NotifyType::FriendRequest:
@@ -296,13 +451,26 @@ void NotificationTrayIconResponder::respond(bs::ui::NotifyType nt, bs::ui::Notif
 
    SPDLOG_LOGGER_INFO(logger_, "notification: {} ({}) {}", title.toStdString(), text.toStdString(), userId.toStdString());
 
+   const Popup popup{ icon, title, text, msecs, newVersionMessage, newChatMessage, newChatId };
+   popupLimiter_.call([this, popup] {
+      showPopup(popup);
+   });
+}
+
+void NotificationTrayIconResponder::showPopup(const Popup &popup)
+{
+   // Click handling refers to the popup shown last
+   newVersionMessage_ = popup.newVersion;
+   newChatMessage_ = popup.newChat;
+   newChatId_ = popup.chatId;
+
    if (notifMode_ == QSystemTray) {
-      //trayIcon_->showMessage(title, text, icon, msecs);
-      trayIcon_->showMessage(title, text, QIcon(QLatin1String(":/resources/login-logo.png")), msecs);
+      //trayIcon_->showMessage(popup.title, popup.text, popup.icon, popup.msecs);
+      trayIcon_->showMessage(popup.title, popup.text, QIcon(QLatin1String(":/resources/login-logo.png")), popup.msecs);
    }
 #ifdef BS_USE_DBUS
    else {
-      dbus_->notifyDBus(icon, title, text, QIcon(), msecs,
+      dbus_->notifyDBus(popup.icon, popup.title, popup.text, QIcon(), popup.msecs,
          (newVersionMessage_ ? c_newVersionAction : QString()),
          (newVersionMessage_ ? tr("Update") : QString()));
    }
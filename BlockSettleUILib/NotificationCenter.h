@@ -12,14 +12,18 @@
 #define __NOTIFICATION_CENTER_H__
 
 #include <atomic>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <vector>
 #include <QMetaType>
 #include <QObject>
 #include <QList>
 #include <QVariant>
 #include <QIcon>
 #include <QSystemTrayIcon>
+#include <QTimer>
 
 #ifdef BS_USE_DBUS
 #include "DBusNotification.h"
@@ -57,6 +61,69 @@ namespace bs {
 
       using NotifyMessage = QList<QVariant>;
 
+      // Merges notifications of the same type and target arriving within
+      // a window. Single notification is delivered as is, several ones are
+      // replaced with a summary (e.g. "12 new transactions") or with the latest
+      // one for state-like notifications. Types that are not coalesced are
+      // delivered immediately, after all pending ones to keep the order.
+      class NotificationCoalescer : public QObject
+      {
+      public:
+         using Callback = std::function<void(NotifyType, const NotifyMessage &)>;
+
+         NotificationCoalescer(std::chrono::milliseconds window, const Callback &
+            , QObject *parent = nullptr);
+
+         void setWindow(std::chrono::milliseconds window) { window_ = window; }
+         std::chrono::milliseconds window() const { return window_; }
+
+         void push(NotifyType, const NotifyMessage &);
+         void flush();
+         size_t nbPending() const { return buckets_.size(); }
+
+      private:
+         struct Bucket
+         {
+            NotifyType     type;
+            QString        target;
+            NotifyMessage  last;
+            int            count;
+            int            nbItems;
+         };
+
+         bool isCoalesced(NotifyType, const NotifyMessage &, QString &target) const;
+         NotifyMessage summary(const Bucket &) const;
+
+      private:
+         Callback                   cb_;
+         std::chrono::milliseconds  window_;
+         QTimer                     timer_;
+         std::vector<Bucket>        buckets_;
+      };
+
+      // Passes at most one call per interval, the rest are postponed.
+      // When too many calls are waiting, the oldest ones are dropped.
+      class CallRateLimiter : public QObject
+      {
+      public:
+         CallRateLimiter(std::chrono::milliseconds interval, size_t maxQueued
+            , QObject *parent = nullptr);
+
+         void call(const std::function<void()> &);
+         size_t nbQueued() const { return queue_.size(); }
+         size_t nbDropped() const { return nbDropped_; }
+
+      private:
+         void onTimeout();
+
+      private:
+         const std::chrono::milliseconds  interval_;
+         const size_t   maxQueued_;
+         QTimer         timer_;
+         std::deque<std::function<void()>>   queue_;
+         size_t         nbDropped_{};
+      };
+
    }  // namespace ui
 }  // namespace bs
 Q_DECLARE_METATYPE(bs::ui::NotifyType)
@@ -80,6 +147,8 @@ class NotificationCenter : public QObject
 public:
    NotificationCenter(const std::shared_ptr<spdlog::logger> &, const std::shared_ptr<ApplicationSettings> &
       , const Ui::BSTerminalMainWindow *, const std::shared_ptr<QSystemTrayIcon> &, QObject *parent = nullptr);
+   // No responders are created, they should be added with addResponder
+   explicit NotificationCenter(const std::shared_ptr<spdlog::logger> &, QObject *parent = nullptr);
    ~NotificationCenter() noexcept = default;
 
    static void createInstance(const std::shared_ptr<spdlog::logger> &logger, const std::shared_ptr<ApplicationSettings> &, const Ui::BSTerminalMainWindow *
@@ -88,16 +157,17 @@ public:
    static void destroyInstance();
    static void notify(bs::ui::NotifyType, const bs::ui::NotifyMessage &);
 
+   void enqueue(bs::ui::NotifyType, const bs::ui::NotifyMessage &);
+   void addResponder(const std::shared_ptr<NotificationResponder> &);
+   std::chrono::milliseconds coalescingWindow() const { return coalescer_.window(); }
+
 signals:
    void notifyEndpoint(bs::ui::NotifyType, const bs::ui::NotifyMessage &);
    void newChatMessageClick(const QString &chatId);
 
-private:
-   void enqueue(bs::ui::NotifyType, const bs::ui::NotifyMessage &);
-   void addResponder(const std::shared_ptr<NotificationResponder> &);
-
 private:
    std::shared_ptr<spdlog::logger> logger_;
+   bs::ui::NotificationCoalescer   coalescer_;
    std::vector<std::shared_ptr<NotificationResponder>>   responders_;
 };
 
@@ -141,10 +211,24 @@ private slots:
    void notificationAction(const QString &action);
 #endif // BS_USE_DBUS
 
+private:
+   struct Popup
+   {
+      QSystemTrayIcon::MessageIcon icon;
+      QString  title;
+      QString  text;
+      int      msecs;
+      bool     newVersion;
+      bool     newChat;
+      QString  chatId;
+   };
+   void showPopup(const Popup &);
+
 private:
    std::shared_ptr<spdlog::logger> logger_;
    const Ui::BSTerminalMainWindow * mainWinUi_{};
    std::shared_ptr<QSystemTrayIcon>       trayIcon_;
+   bs::ui::CallRateLimiter                popupLimiter_;
    std::shared_ptr<ApplicationSettings>   appSettings_;
    bool  newVersionMessage_ = false;
    bool  newChatMessage_ = false;
@@ -374,7 +374,7 @@ void OrderListModel::setOrderStatus(Group *group, int index, const bs::network::
    bool isStatusChanged = false;
 
    auto setNewStatusIfNeeded = [&](QString &&newStatus, QColor newColor) {
-      isStatusChanged = rowData->status_ != newStatus;
+      isStatusChanged = (rowData->status_ != newStatus) || (rowData->statusColor_ != newColor);
       if (isStatusChanged) {
          rowData->status_ = std::move(newStatus);
          rowData->statusColor_ = newColor;
@@ -417,6 +417,11 @@ void OrderListModel::setOrderStatus(Group *group, int index, const bs::network::
       emit dataChanged(idx, idx);
    }
 
+   // Existing rows are re-applied on every snapshot, nothing to notify if unchanged
+   if (emitUpdate && !isStatusChanged) {
+      return;
+   }
+
    if (!latestOrderTimestamp_.isValid() || order.dateTime > latestOrderTimestamp_) {
       latestOrderTimestamp_ = order.dateTime;
       emit newOrder(persistentIdx);
@@ -447,58 +452,91 @@ OrderListModel::StatusGroup::Type OrderListModel::getStatusGroup(const bs::netwo
    return StatusGroup::last;
 }
 
-std::pair<OrderListModel::Group*, int> OrderListModel::findItem(const bs::network::Order &order)
+OrderListModel::StatusGroup *OrderListModel::statusGroup(StatusGroup::Type type) const
 {
-   const auto itGroups = groups_.find(order.exchOrderId.toStdString());
-   const auto assetGrpName = tr(bs::network::Asset::toString(order.assetType));
-   StatusGroup *sg = nullptr;
+   return (type == StatusGroup::UnSettled ? unsettled_.get() : settled_.get());
+}
 
-   if (itGroups != groups_.end()) {
-      sg = (itGroups->second == StatusGroup::UnSettled ? unsettled_.get() : settled_.get());
+OrderListModel::Market *OrderListModel::findMarketByType(StatusGroup *sg
+   , bs::network::Asset::Type assetType)
+{
+   const auto it = sg->marketIndex_.find(static_cast<int>(assetType));
+   return (it != sg->marketIndex_.end()) ? it->second : nullptr;
+}
 
-      auto it = std::find_if(sg->rows_.cbegin(), sg->rows_.cend(),
-         [assetGrpName] (const std::unique_ptr<Market> & m) { return (m->name_ == assetGrpName); });
+OrderListModel::Group *OrderListModel::findGroupBySecurity(Market *market
+   , const std::string &security)
+{
+   const auto it = market->groupIndex_.find(security);
+   return (it != market->groupIndex_.end()) ? it->second : nullptr;
+}
 
-      if (it != sg->rows_.cend()) {
-         auto git = std::find_if((*it)->rows_.cbegin(), (*it)->rows_.cend(),
-            [&order] (const std::unique_ptr<Group> &g)
-               { return (order.security == g->security_.toStdString()); } );
+int OrderListModel::findRow(Group *group, const std::string &id)
+{
+   const auto it = group->rowIndex_.find(id);
+   if (it == group->rowIndex_.end()) {
+      return -1;
+   }
+   return static_cast<int>(it->second->pos_ - group->frontPos_);
+}
 
-         if (git != (*it)->rows_.cend()) {
-            auto dit = std::find_if((*git)->rows_.cbegin(), (*git)->rows_.cend(),
-               [&order] (const std::unique_ptr<Data> &d) { return (d->id_ == order.exchOrderId); });
+std::pair<OrderListModel::Group*, int> OrderListModel::findItem(const bs::network::Order &order)
+{
+   const auto itOrder = orders_.find(order.exchOrderId.toStdString());
 
-            if (dit != (*git)->rows_.cend()) {
-               return std::make_pair(git->get(),
-                  static_cast<int>(std::distance((*git)->rows_.cbegin(), dit)));
-            } else {
-               return std::make_pair(git->get(), -1);
-            }
-         } else {
-            return std::make_pair(nullptr, -1);
-         }
-      } else {
+   if (itOrder != orders_.end()) {
+      auto market = findMarketByType(statusGroup(itOrder->second.statusGroup), order.assetType);
+      if (!market) {
          return std::make_pair(nullptr, -1);
       }
+      auto group = findGroupBySecurity(market, order.security);
+      if (!group) {
+         return std::make_pair(nullptr, -1);
+      }
+      return std::make_pair(group, findRow(group, order.exchOrderId.toStdString()));
    }
 
-   sg = (getStatusGroup(order) == StatusGroup::UnSettled ? unsettled_.get() : settled_.get());
-
-   auto it = std::find_if(sg->rows_.cbegin(), sg->rows_.cend(),
-      [assetGrpName] (const std::unique_ptr<Market> & g) { return (g->name_ == assetGrpName); });
-
-   if (it != sg->rows_.cend()) {
-      auto git = std::find_if((*it)->rows_.cbegin(), (*it)->rows_.cend(),
-         [&order] (const std::unique_ptr<Group> &g)
-            { return (order.security == g->security_.toStdString()); } );
+   auto market = findMarketByType(statusGroup(getStatusGroup(order)), order.assetType);
+   if (!market) {
+      return std::make_pair(nullptr, -1);
+   }
+   return std::make_pair(findGroupBySecurity(market, order.security), -1);
+}
 
-      if (git != (*it)->rows_.cend()) {
-         return std::make_pair(git->get(), -1);
-      } else {
-         return std::make_pair(nullptr, -1);
+void OrderListModel::eraseRow(StatusGroup *sg, Market *market, Group *group, int row)
+{
+   const auto groupRow = findGroup(market, group);
+
+   beginRemoveRows(createIndex(groupRow, 0, &group->idx_), row, row);
+   group->rowIndex_.erase(group->rows_[static_cast<std::size_t>(row)]->id_.toStdString());
+   // Shift positions of the shorter side so the following rows move up by one
+   if (row < static_cast<int>(group->rows_.size()) / 2) {
+      for (int i = 0; i < row; ++i) {
+         ++group->rows_[static_cast<std::size_t>(i)]->pos_;
       }
+      ++group->frontPos_;
    } else {
-      return std::make_pair(nullptr, -1);
+      for (std::size_t i = static_cast<std::size_t>(row) + 1; i < group->rows_.size(); ++i) {
+         --group->rows_[i]->pos_;
+      }
+   }
+   group->rows_.erase(group->rows_.begin() + row);
+   endRemoveRows();
+
+   const auto marketRow = findMarket(sg, market);
+
+   if (group->rows_.empty()) {
+      beginRemoveRows(createIndex(marketRow, 0, &market->idx_), groupRow, groupRow);
+      market->groupIndex_.erase(group->securityKey_);
+      market->rows_.erase(market->rows_.begin() + groupRow);
+      endRemoveRows();
+   }
+
+   if (market->rows_.empty()) {
+      beginRemoveRows(createIndex(sg->row_, 0, &sg->idx_), marketRow, marketRow);
+      sg->marketIndex_.erase(market->assetType_);
+      sg->rows_.erase(sg->rows_.begin() + marketRow);
+      endRemoveRows();
    }
 }
 
@@ -506,93 +544,69 @@ void OrderListModel::removeRowIfContainerChanged(const bs::network::Order &order
    int &oldOrderRow)
 {
    // Remove row if container (settled/unsettled) changed.
-   auto git = groups_.find(order.exchOrderId.toStdString());
+   auto itOrder = orders_.find(order.exchOrderId.toStdString());
 
-   if (git != groups_.end() && git->second != getStatusGroup(order) && oldOrderRow >= 0) {
-      StatusGroup *tmpsg = (git->second == StatusGroup::UnSettled ? unsettled_.get() :
-         settled_.get());
+   if (itOrder != orders_.end() && itOrder->second.statusGroup != getStatusGroup(order) && oldOrderRow >= 0) {
+      StatusGroup *tmpsg = statusGroup(itOrder->second.statusGroup);
+      auto market = findMarketByType(tmpsg, order.assetType);
 
-      const auto assetGrpName = tr(bs::network::Asset::toString(order.assetType));
+      if (market) {
+         auto group = findGroupBySecurity(market, order.security);
 
-      auto mit = std::find_if(tmpsg->rows_.cbegin(), tmpsg->rows_.cend(),
-         [assetGrpName] (const std::unique_ptr<Market> & m) { return (m->name_ == assetGrpName); });
-
-      if (mit != tmpsg->rows_.cend()) {
-         auto git = std::find_if((*mit)->rows_.cbegin(), (*mit)->rows_.cend(),
-            [&order] (const std::unique_ptr<Group> &g)
-               { return (order.security == g->security_.toStdString()); });
-
-         if (git != (*mit)->rows_.cend()) {
-            const auto groupRow = findGroup(mit->get(), git->get());
-            const auto didx = createIndex(groupRow, 0, &(*git)->idx_);
-
-            beginRemoveRows(didx, oldOrderRow, oldOrderRow);
-            (*git)->rows_.erase((*git)->rows_.begin() + oldOrderRow);
+         if (group) {
+            eraseRow(tmpsg, market, group, oldOrderRow);
             oldOrderRow = -1;
-            endRemoveRows();
-
-            const auto marketRow = findMarket(tmpsg, mit->get());
-
-            if (!(*git)->rows_.size()) {
-               beginRemoveRows(createIndex(marketRow, 0, &(*mit)->idx_),
-                  groupRow, groupRow);
-               (*mit)->rows_.erase(git);
-               endRemoveRows();
-            }
-
-            if (!(*mit)->rows_.size()) {
-               beginRemoveRows(createIndex(tmpsg->row_, 0, &tmpsg->idx_), marketRow, marketRow);
-               tmpsg->rows_.erase(mit);
-               endRemoveRows();
-            }
          }
       }
    }
 }
 
-void OrderListModel::findMarketAndGroup(const bs::network::Order &order, Market *&market,
-   Group *&group)
+void OrderListModel::removeOrder(const std::string &id)
 {
-   StatusGroup *sg = (getStatusGroup(order) == StatusGroup::UnSettled ? unsettled_.get() :
-      settled_.get());
-
-   const auto assetGrpName = tr(bs::network::Asset::toString(order.assetType));
-
-   auto mit = std::find_if(sg->rows_.cbegin(), sg->rows_.cend(),
-      [assetGrpName] (const std::unique_ptr<Market> & m) { return (m->name_ == assetGrpName); });
-
-   if (mit != sg->rows_.cend()) {
-      auto git = std::find_if((*mit)->rows_.cbegin(), (*mit)->rows_.cend(),
-         [&order] (const std::unique_ptr<Group> & g)
-            { return (g->security_.toStdString() == order.security); });
+   const auto itOrder = orders_.find(id);
+   if (itOrder == orders_.end()) {
+      return;
+   }
+   const auto ref = itOrder->second;
+   orders_.erase(itOrder);
 
-      if (git != (*mit)->rows_.cend()) {
-         group = git->get();
-         market = mit->get();
-      } else {
-         group = nullptr;
-         market = mit->get();
-      }
-   } else {
-      group = nullptr;
-      market = nullptr;
+   auto sg = statusGroup(ref.statusGroup);
+   auto market = findMarketByType(sg, ref.assetType);
+   if (!market) {
+      return;
+   }
+   auto group = findGroupBySecurity(market, ref.security);
+   if (!group) {
+      return;
+   }
+   const int row = findRow(group, id);
+   if (row >= 0) {
+      eraseRow(sg, market, group, row);
    }
 }
 
+void OrderListModel::findMarketAndGroup(const bs::network::Order &order, Market *&market,
+   Group *&group)
+{
+   market = findMarketByType(statusGroup(getStatusGroup(order)), order.assetType);
+   group = market ? findGroupBySecurity(market, order.security) : nullptr;
+}
+
 void OrderListModel::createGroupsIfNeeded(const bs::network::Order &order, Market *&marketItem,
    Group *&groupItem)
 {
    QModelIndex sidx = (getStatusGroup(order) == StatusGroup::UnSettled ?
       createIndex(0, 0, &unsettled_->idx_) : createIndex(1, 0, &settled_->idx_));
-   StatusGroup *sg = (getStatusGroup(order) == StatusGroup::UnSettled ? unsettled_.get() :
-      settled_.get());
+   StatusGroup *sg = statusGroup(getStatusGroup(order));
 
    // Create market if it doesn't exist.
    if (!marketItem) {
       beginInsertRows(sidx, static_cast<int>(sg->rows_.size()), static_cast<int>(sg->rows_.size()));
       sg->rows_.push_back(make_unique<Market>(
-         tr(bs::network::Asset::toString(order.assetType)), &sg->idx_));
+         tr(bs::network::Asset::toString(order.assetType)), static_cast<int>(order.assetType)
+         , &sg->idx_));
       marketItem = sg->rows_.back().get();
+      sg->marketIndex_[marketItem->assetType_] = marketItem;
       endInsertRows();
    }
 
@@ -603,6 +617,7 @@ void OrderListModel::createGroupsIfNeeded(const bs::network::Order &order, Marke
       marketItem->rows_.push_back(make_unique<Group>(
          QString::fromStdString(order.security), &marketItem->idx_));
       groupItem = marketItem->rows_.back().get();
+      marketItem->groupIndex_[groupItem->securityKey_] = groupItem;
       endInsertRows();
    }
 }
@@ -610,7 +625,7 @@ void OrderListModel::createGroupsIfNeeded(const bs::network::Order &order, Marke
 void OrderListModel::reset()
 {
    beginResetModel();
-   groups_.clear();
+   orders_.clear();
    unsettled_ = std::make_unique<StatusGroup>(StatusGroup::toString(StatusGroup::UnSettled), 0);
    settled_ = std::make_unique<StatusGroup>(StatusGroup::toString(StatusGroup::Settled), 1);
    endResetModel();
@@ -620,12 +635,21 @@ void OrderListModel::processUpdateOrders(const Blocksettle::Communication::Proxy
 {
    // Save latest selected index first
    resetLatestChangedStatus(message);
-   // OrderListModel supposed to work correctly when orders states updated one by one.
-   // We don't use this anymore (server sends all active orders every time) so just clear old caches.
-   // Remove this if old behavior is needed
-   reset();
-   // Use some fake orderId so old code works correctly
-   int orderId = 0;
+
+   // Server sends all active orders every time. Orders have no id, so they are keyed
+   // by their immutable fields and the snapshot is diffed against the current tree:
+   // only new orders are inserted, only vanished ones are removed and status changes
+   // are applied in place. This keeps selection and scroll position in the view.
+   const auto orderKey = [](const auto &data) {
+      return data.product() + "/" + data.product_against()
+         + ':' + std::to_string(data.timestamp_ms())
+         + ':' + std::to_string(static_cast<int>(data.side()))
+         + ':' + std::to_string(data.price())
+         + ':' + std::to_string(data.quantity());
+   };
+
+   std::unordered_set<std::string> receivedIds;
+   receivedIds.reserve(static_cast<std::size_t>(message.orders_size()));
 
    for (const auto &data : message.orders()) {
       bs::network::Order order;
@@ -656,8 +680,18 @@ void OrderListModel::processUpdateOrders(const Blocksettle::Communication::Proxy
          order.assetType = bs::network::Asset::SpotFX;
       }
 
-      orderId += 1;
-      order.exchOrderId = QString::number(orderId);
+      auto id = orderKey(data);
+      if (!receivedIds.insert(id).second) {
+         // Several orders with the same fields are distinguished by their
+         // occurrence in the snapshot
+         const auto baseId = id;
+         int occurrence = 1;
+         do {
+            id = baseId + '#' + std::to_string(++occurrence);
+         } while (!receivedIds.insert(id).second);
+      }
+
+      order.exchOrderId = QString::fromStdString(id);
       order.side = bs::network::Side::Type(data.side());
       order.pendingStatus = data.status_text();
       order.dateTime = QDateTime::fromMSecsSinceEpoch(data.timestamp_ms());
@@ -668,6 +702,16 @@ void OrderListModel::processUpdateOrders(const Blocksettle::Communication::Proxy
 
       onOrderUpdated(order);
    }
+
+   std::vector<std::string> removedIds;
+   for (const auto &order : orders_) {
+      if (receivedIds.find(order.first) == receivedIds.end()) {
+         removedIds.push_back(order.first);
+      }
+   }
+   for (const auto &id : removedIds) {
+      removeOrder(id);
+   }
 }
 
 void OrderListModel::resetLatestChangedStatus(const Blocksettle::Communication::ProxyTerminalPb::Response_UpdateOrders &message)
@@ -713,7 +757,7 @@ void OrderListModel::onOrderUpdated(const bs::network::Order& order)
 
    createGroupsIfNeeded(order, marketItem, groupItem);
 
-   groups_[order.exchOrderId.toStdString()] = getStatusGroup(order);
+   orders_[order.exchOrderId.toStdString()] = { getStatusGroup(order), order.assetType, order.security };
 
    const auto parentIndex = createIndex(findGroup(marketItem, groupItem), 0, &groupItem->idx_);
 
@@ -736,6 +780,8 @@ void OrderListModel::onOrderUpdated(const bs::network::Order& order)
          QString(),
          order.exchOrderId,
          &groupItem->idx_));
+      groupItem->rows_.front()->pos_ = --groupItem->frontPos_;
+      groupItem->rowIndex_[order.exchOrderId.toStdString()] = groupItem->rows_.front().get();
 
       setOrderStatus(groupItem, 0, order);
 
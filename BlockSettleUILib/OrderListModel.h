@@ -20,6 +20,8 @@
 #include <memory>
 #include <vector>
 #include <deque>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Blocksettle {
    namespace Communication {
@@ -100,6 +102,8 @@ private:
       QString status_;
       QString id_;
       QColor statusColor_;
+      // row in the group is pos_ - Group::frontPos_
+      int64_t pos_{};
       IndexHelper idx_;
 
       Data(const QString &time, const QString &prod,
@@ -122,11 +126,17 @@ private:
 
    struct Group {
       std::deque<std::unique_ptr<Data>> rows_;
+      // order id -> row data, to avoid linear scans over rows_ on every update
+      std::unordered_map<std::string, Data*> rowIndex_;
+      // rows are inserted only at the front, so positions stay valid on insert
+      int64_t frontPos_{};
       QString security_;
+      std::string securityKey_;
       IndexHelper idx_;
 
       Group(const QString &sec, IndexHelper *parent)
          : security_(sec)
+         , securityKey_(sec.toStdString())
          , idx_(parent, this, DataType::Group)
       {
       }
@@ -134,12 +144,16 @@ private:
 
    struct Market {
       std::vector<std::unique_ptr<Group>> rows_;
+      // security -> group, to avoid linear scans over rows_ on every update
+      std::unordered_map<std::string, Group*> groupIndex_;
       QString name_;
+      int assetType_;
       IndexHelper idx_;
       QFont font_;
 
-      Market(const QString &name, IndexHelper *parent)
+      Market(const QString &name, int assetType, IndexHelper *parent)
          : name_(name)
+         , assetType_(assetType)
          , idx_(parent, this, DataType::Market)
       {
          font_.setBold(true);
@@ -148,6 +162,8 @@ private:
 
    struct StatusGroup {
       std::vector<std::unique_ptr<Market>> rows_;
+      // asset type -> market
+      std::unordered_map<int, Market*> marketIndex_;
       QString name_;
       IndexHelper idx_;
       int row_;
@@ -169,8 +185,20 @@ private:
       static QString toString(Type);
    };
 
+   // Where an order currently lives in the tree, keyed by order id in orders_
+   struct OrderRef {
+      StatusGroup::Type statusGroup;
+      bs::network::Asset::Type assetType;
+      std::string security;
+   };
+
    static StatusGroup::Type getStatusGroup(const bs::network::Order &);
 
+   StatusGroup *statusGroup(StatusGroup::Type) const;
+   static Market *findMarketByType(StatusGroup *, bs::network::Asset::Type);
+   static Group *findGroupBySecurity(Market *, const std::string &security);
+   static int findRow(Group *, const std::string &id);
+
    void onOrderUpdated(const bs::network::Order &);
    int findGroup(Market *market, Group *group) const;
    int findMarket(StatusGroup *statusGroup, Market *market) const;
@@ -180,13 +208,15 @@ private:
    void removeRowIfContainerChanged(const bs::network::Order &order, int &oldOrderRow);
    void findMarketAndGroup(const bs::network::Order &order, Market *&market, Group *&group);
    void createGroupsIfNeeded(const bs::network::Order &order, Market *&market, Group *&group);
+   void eraseRow(StatusGroup *sg, Market *market, Group *group, int row);
+   void removeOrder(const std::string &id);
 
    void reset();
    void processUpdateOrders(const Blocksettle::Communication::ProxyTerminalPb::Response_UpdateOrders &msg);
    void resetLatestChangedStatus(const Blocksettle::Communication::ProxyTerminalPb::Response_UpdateOrders &message);
 
    std::shared_ptr<AssetManager>    assetManager_;
-   std::unordered_map<std::string, StatusGroup::Type> groups_;
+   std::unordered_map<std::string, OrderRef> orders_;
    std::unique_ptr<StatusGroup> unsettled_;
    std::unique_ptr<StatusGroup> settled_;
    QDateTime latestOrderTimestamp_;
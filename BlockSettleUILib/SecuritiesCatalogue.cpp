@@ -0,0 +1,136 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "SecuritiesCatalogue.h"
+
+#include "AssetManager.h"
+
+SecuritiesCatalogue::SecuritiesCatalogue()
+   : byAssetType_(static_cast<size_t>(bs::network::Asset::last))
+   , nbVisible_(static_cast<size_t>(bs::network::Asset::last), 0)
+{
+   for (int asset = static_cast<int>(bs::network::Asset::first); asset < static_cast<int>(bs::network::Asset::last); asset++) {
+      const auto assetType = static_cast<bs::network::Asset::Type>(asset);
+      groupByName_[QLatin1String(bs::network::Asset::toString(assetType))] = assetType;
+   }
+}
+
+void SecuritiesCatalogue::reset(const std::shared_ptr<AssetManager> &assetMgr)
+{
+   securities_.clear();
+   bySymbol_.clear();
+   for (auto &group : byAssetType_) {
+      group.clear();
+   }
+
+   if (assetMgr && assetMgr->hasSecurities()) {
+      for (int asset = static_cast<int>(bs::network::Asset::first); asset < static_cast<int>(bs::network::Asset::last); asset++) {
+         const auto assetType = static_cast<bs::network::Asset::Type>(asset);
+         auto &group = byAssetType_[asset];
+         for (const auto &symbol : assetMgr->securities(assetType)) {
+            const int index = size();
+            securities_.push_back({ symbol, assetType, static_cast<int>(group.size()) });
+            group.push_back(index);
+            bySymbol_[symbol].push_back(index);
+         }
+      }
+   }
+
+   visible_.assign(securities_.size(), true);
+   for (int asset = 0; asset < static_cast<int>(bs::network::Asset::last); asset++) {
+      nbVisible_[asset] = static_cast<int>(byAssetType_[asset].size());
+   }
+}
+
+std::vector<int> SecuritiesCatalogue::indexesOf(const QString &symbol) const
+{
+   return bySymbol_.value(symbol);
+}
+
+int SecuritiesCatalogue::indexOf(bs::network::Asset::Type assetType, const QString &symbol) const
+{
+   const auto it = bySymbol_.constFind(symbol);
+   if (it == bySymbol_.cend()) {
+      return -1;
+   }
+   for (const int index : it.value()) {
+      if (securities_[index].assetType == assetType) {
+         return index;
+      }
+   }
+   return -1;
+}
+
+int SecuritiesCatalogue::indexOf(bs::network::Asset::Type assetType, int row) const
+{
+   if (!isValid(assetType)) {
+      return -1;
+   }
+   const auto &group = byAssetType_[assetType];
+   if ((row < 0) || (row >= static_cast<int>(group.size()))) {
+      return -1;
+   }
+   return group[row];
+}
+
+bs::network::Asset::Type SecuritiesCatalogue::groupType(const QString &groupName) const
+{
+   return groupByName_.value(groupName, bs::network::Asset::Undefined);
+}
+
+int SecuritiesCatalogue::nbSecurities(bs::network::Asset::Type assetType) const
+{
+   return isValid(assetType) ? static_cast<int>(byAssetType_[assetType].size()) : 0;
+}
+
+void SecuritiesCatalogue::setHidden(const QStringList &hiddenSymbols)
+{
+   visible_.assign(securities_.size(), true);
+   for (int asset = 0; asset < static_cast<int>(bs::network::Asset::last); asset++) {
+      nbVisible_[asset] = static_cast<int>(byAssetType_[asset].size());
+   }
+   // Symbol is hidden under all asset types
+   for (const auto &symbol : hiddenSymbols) {
+      for (const int index : indexesOf(symbol)) {
+         setVisible(index, false);
+      }
+   }
+}
+
+QStringList SecuritiesCatalogue::hidden() const
+{
+   QStringList result;
+   for (int i = 0; i < size(); i++) {
+      if (!visible_[i]) {
+         result << securities_[i].symbol;
+      }
+   }
+   result.removeDuplicates();
+   return result;
+}
+
+void SecuritiesCatalogue::setVisible(int index, bool visible)
+{
+   if (visible_[index] == visible) {
+      return;
+   }
+   visible_[index] = visible;
+   nbVisible_[securities_[index].assetType] += visible ? 1 : -1;
+}
+
+int SecuritiesCatalogue::nbVisible(bs::network::Asset::Type assetType) const
+{
+   return isValid(assetType) ? nbVisible_[assetType] : 0;
+}
+
+bool SecuritiesCatalogue::isValid(bs::network::Asset::Type assetType)
+{
+   return (assetType >= bs::network::Asset::first) && (assetType < bs::network::Asset::last);
+}
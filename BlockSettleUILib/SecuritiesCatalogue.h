@@ -0,0 +1,78 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __SECURITIES_CATALOGUE_H__
+#define __SECURITIES_CATALOGUE_H__
+
+#include <memory>
+#include <vector>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include "CommonTypes.h"
+
+class AssetManager;
+
+// Flat index of securities received from AssetManager. Securities are
+// grouped by asset type (product group) and looked up by symbol with a hash
+// (the same symbol could be listed under several asset types),
+// so models don't need to walk groups and rows. Visibility is kept as a
+// bitset with per-group counters, computed once from settings (list of hidden
+// symbols) and updated on each toggle.
+class SecuritiesCatalogue
+{
+public:
+   struct Security
+   {
+      QString                    symbol;
+      bs::network::Asset::Type   assetType;
+      int                        row;     // within its asset type
+   };
+
+   SecuritiesCatalogue();
+
+   void reset(const std::shared_ptr<AssetManager> &);
+
+   bool empty() const { return securities_.empty(); }
+   int size() const { return static_cast<int>(securities_.size()); }
+   const Security &at(int index) const { return securities_[index]; }
+
+   // Indices of the symbol under all asset types
+   std::vector<int> indexesOf(const QString &symbol) const;
+
+   // Return -1 if not found
+   int indexOf(bs::network::Asset::Type, const QString &symbol) const;
+   int indexOf(bs::network::Asset::Type, int row) const;
+
+   // Product group name is bs::network::Asset::toString(type)
+   // Return Asset::Undefined if not found
+   bs::network::Asset::Type groupType(const QString &groupName) const;
+   int nbSecurities(bs::network::Asset::Type) const;
+
+   void setHidden(const QStringList &hiddenSymbols);
+   QStringList hidden() const;
+
+   bool isVisible(int index) const { return visible_[index]; }
+   void setVisible(int index, bool visible);
+   int nbVisible(bs::network::Asset::Type) const;
+
+private:
+   static bool isValid(bs::network::Asset::Type);
+
+private:
+   std::vector<Security>                        securities_;
+   QHash<QString, std::vector<int>>             bySymbol_;
+   QHash<QString, bs::network::Asset::Type>     groupByName_;
+   std::vector<std::vector<int>>                byAssetType_;
+   std::vector<bool>                            visible_;
+   std::vector<int>                             nbVisible_;
+};
+
+#endif // __SECURITIES_CATALOGUE_H__
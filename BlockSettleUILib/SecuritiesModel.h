@@ -14,10 +14,9 @@
 #include <QAbstractItemModel>
 
 #include <memory>
+#include "SecuritiesCatalogue.h"
 
 class AssetManager;
-class BaseSecurityNode;
-class RootSecuritiesNode;
 
 class SecuritiesModel : public QAbstractItemModel
 {
@@ -50,10 +49,14 @@ public:
    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
 
 private:
-   BaseSecurityNode* getNodeByIndex(const QModelIndex& index) const;
+   // Group rows have internal id 0, security rows - group row + 1
+   static bool isGroup(const QModelIndex &index) { return (index.internalId() == 0); }
+   static bs::network::Asset::Type groupType(int groupRow);
+   int securityIndex(const QModelIndex &index) const;
+   int groupCheckedState(bs::network::Asset::Type) const;
 
 private:
-   std::shared_ptr<RootSecuritiesNode> rootNode_;
+   SecuritiesCatalogue  catalogue_;
 };
 
 #endif // __SECURITIES_MODEL_H__
\ No newline at end of file
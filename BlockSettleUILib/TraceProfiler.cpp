@@ -0,0 +1,233 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "TraceProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <QCoreApplication>
+
+using namespace bs::trace;
+
+namespace {
+
+   std::atomic<uint64_t> lastThreadId{};
+
+   void writeJsonString(std::ostringstream &out, const char *str)
+   {
+      out << '"';
+      for (const char *c = str; c && *c; ++c) {
+         switch (*c) {
+         case '"':   out << "\\\""; break;
+         case '\\':  out << "\\\\"; break;
+         case '\n':  out << "\\n"; break;
+         case '\t':  out << "\\t"; break;
+         default:
+            if (static_cast<unsigned char>(*c) >= 0x20) {
+               out << *c;
+            }
+            break;
+         }
+      }
+      out << '"';
+   }
+
+   void writeThreadName(std::ostringstream &out, int64_t pid, uint64_t threadId, const std::string &name)
+   {
+      out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+         << ",\"tid\":" << threadId << ",\"args\":{\"name\":";
+      writeJsonString(out, name.c_str());
+      out << "}}";
+   }
+
+   void writeEvent(std::ostringstream &out, int64_t pid, uint64_t threadId, const Event &event)
+   {
+      out << "{\"name\":";
+      writeJsonString(out, event.name);
+      out << ",\"cat\":";
+      writeJsonString(out, event.category);
+      out << ",\"ph\":\"X\",\"ts\":" << event.beginUs << ",\"dur\":" << event.durationUs
+         << ",\"pid\":" << pid << ",\"tid\":" << threadId << "}";
+   }
+
+} // namespace
+
+constexpr size_t Profiler::kEventsPerThread;
+
+Profiler &Profiler::instance()
+{
+   static Profiler profiler;
+   return profiler;
+}
+
+int64_t Profiler::now()
+{
+   return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::ThreadBuffer::ThreadBuffer()
+   : events(kEventsPerThread)
+{}
+
+Profiler::ThreadBufferHolder::~ThreadBufferHolder()
+{
+   if (buffer) {
+      Profiler::instance().retire(buffer);
+   }
+}
+
+Profiler::ThreadBuffer &Profiler::threadBuffer()
+{
+   thread_local ThreadBufferHolder holder;
+   if (!holder.buffer) {
+      std::lock_guard<std::mutex> lock(buffersMutex_);
+      if (freeBuffers_.empty()) {
+         holder.buffer = std::make_shared<ThreadBuffer>();
+      } else {
+         holder.buffer = std::move(freeBuffers_.back());
+         freeBuffers_.pop_back();
+      }
+      holder.buffer->threadId = ++lastThreadId;
+      buffers_.push_back(holder.buffer);
+   }
+   return *holder.buffer;
+}
+
+void Profiler::retire(const std::shared_ptr<ThreadBuffer> &buffer)
+{
+   std::lock_guard<std::mutex> lock(buffersMutex_);
+   ExitedThread exited;
+   {
+      std::lock_guard<std::mutex> bufLock(buffer->mutex);
+      exited.threadId = buffer->threadId;
+      exited.threadName = std::move(buffer->threadName);
+      buffer->threadName.clear();
+
+      const size_t nbEvents = std::min(buffer->nbWritten, kEventsPerThread);
+      exited.events.reserve(nbEvents);
+      for (size_t i = buffer->nbWritten - nbEvents; i < buffer->nbWritten; ++i) {
+         exited.events.push_back(buffer->events[i % kEventsPerThread]);
+      }
+      buffer->nbWritten = 0;
+   }
+
+   buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+   freeBuffers_.push_back(buffer);
+
+   if (exited.events.empty() && exited.threadName.empty()) {
+      return;
+   }
+   nbExitedEvents_ += exited.events.size();
+   exitedThreads_.push_back(std::move(exited));
+
+   // Drop the oldest events of exited threads first
+   while (nbExitedEvents_ > kEventsPerThread) {
+      auto &oldest = exitedThreads_.front().events;
+      const size_t nbDropped = std::min(oldest.size(), nbExitedEvents_ - kEventsPerThread);
+      oldest.erase(oldest.begin(), oldest.begin() + nbDropped);
+      nbExitedEvents_ -= nbDropped;
+      if (oldest.empty()) {
+         exitedThreads_.pop_front();
+      }
+   }
+}
+
+void Profiler::record(const char *name, const char *category, int64_t beginUs, int64_t durationUs)
+{
+   auto &buffer = threadBuffer();
+   std::lock_guard<std::mutex> lock(buffer.mutex);
+   buffer.events[buffer.nbWritten % kEventsPerThread] = { name, category, beginUs, durationUs };
+   ++buffer.nbWritten;
+}
+
+void Profiler::setThreadName(const std::string &name)
+{
+   auto &buffer = threadBuffer();
+   std::lock_guard<std::mutex> lock(buffer.mutex);
+   buffer.threadName = name;
+}
+
+size_t Profiler::nbEvents() const
+{
+   std::lock_guard<std::mutex> lock(buffersMutex_);
+   size_t result = nbExitedEvents_;
+   for (const auto &buffer : buffers_) {
+      std::lock_guard<std::mutex> bufLock(buffer->mutex);
+      result += std::min(buffer->nbWritten, kEventsPerThread);
+   }
+   return result;
+}
+
+void Profiler::clear()
+{
+   std::lock_guard<std::mutex> lock(buffersMutex_);
+   for (const auto &buffer : buffers_) {
+      std::lock_guard<std::mutex> bufLock(buffer->mutex);
+      buffer->nbWritten = 0;
+   }
+   exitedThreads_.clear();
+   nbExitedEvents_ = 0;
+}
+
+std::string Profiler::toChromeJson() const
+{
+   const auto pid = QCoreApplication::applicationPid();
+   std::ostringstream out;
+   out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+   bool first = true;
+   const auto separator = [&out, &first] {
+      if (!first) {
+         out << ",\n";
+      }
+      first = false;
+   };
+
+   std::lock_guard<std::mutex> lock(buffersMutex_);
+   for (const auto &exited : exitedThreads_) {
+      if (!exited.threadName.empty()) {
+         separator();
+         writeThreadName(out, pid, exited.threadId, exited.threadName);
+      }
+      for (const auto &event : exited.events) {
+         separator();
+         writeEvent(out, pid, exited.threadId, event);
+      }
+   }
+
+   for (const auto &buffer : buffers_) {
+      std::lock_guard<std::mutex> bufLock(buffer->mutex);
+      if (!buffer->threadName.empty()) {
+         separator();
+         writeThreadName(out, pid, buffer->threadId, buffer->threadName);
+      }
+
+      const size_t nbEvents = std::min(buffer->nbWritten, kEventsPerThread);
+      const size_t start = buffer->nbWritten - nbEvents;
+      for (size_t i = start; i < buffer->nbWritten; ++i) {
+         separator();
+         writeEvent(out, pid, buffer->threadId, buffer->events[i % kEventsPerThread]);
+      }
+   }
+   out << "]}\n";
+   return out.str();
+}
+
+bool Profiler::saveChromeJson(const std::string &fileName) const
+{
+   std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+   if (!file.is_open()) {
+      return false;
+   }
+   file << toChromeJson();
+   return file.good();
+}
@@ -0,0 +1,158 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef __TRACE_PROFILER_H__
+#define __TRACE_PROFILER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped spans are compiled in only with BS_TRACING defined (CMake option
+// BSTERMINAL_TRACING), otherwise the macros expand to nothing.
+// Only pointers to names and categories are stored, so these must be string
+// literals (or __func__ alike).
+#ifdef BS_TRACING
+#define BS_TRACE_CONCAT_IMPL(a, b) a##b
+#define BS_TRACE_CONCAT(a, b) BS_TRACE_CONCAT_IMPL(a, b)
+#define BS_TRACE_SCOPE(name) \
+   const bs::trace::Span BS_TRACE_CONCAT(bsTraceSpan_, __LINE__)((name), "terminal")
+#if defined(_MSC_VER)
+#define BS_TRACE_FUNCTION() BS_TRACE_SCOPE(__FUNCTION__)
+#else
+#define BS_TRACE_FUNCTION() BS_TRACE_SCOPE(__PRETTY_FUNCTION__)
+#endif
+#else
+#define BS_TRACE_SCOPE(name)
+#define BS_TRACE_FUNCTION()
+#endif
+
+namespace bs {
+   namespace trace {
+
+      struct Event
+      {
+         const char  *name;
+         const char  *category;
+         int64_t     beginUs;
+         int64_t     durationUs;
+      };
+
+      // Collects completed spans. Each thread writes to its own fixed-size
+      // ring buffer (oldest spans are overwritten), so recording doesn't
+      // allocate and the buffer lock is contended only while exporting.
+      // When a thread exits, its events are moved to a shared store of
+      // exited threads (limited to kEventsPerThread latest events) and the
+      // buffer is reused by the next new thread.
+      class Profiler
+      {
+      public:
+         static constexpr size_t kEventsPerThread = 16384;
+
+         static Profiler &instance();
+
+         Profiler(const Profiler &) = delete;
+         Profiler &operator=(const Profiler &) = delete;
+         Profiler(Profiler &&) = delete;
+         Profiler &operator=(Profiler &&) = delete;
+
+         bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+         void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+         // Timestamps are microseconds of a monotonic clock
+         static int64_t now();
+         void record(const char *name, const char *category, int64_t beginUs, int64_t durationUs);
+
+         // Name is shown for the calling thread in the trace viewer
+         void setThreadName(const std::string &);
+
+         size_t nbEvents() const;
+         void clear();
+
+         // Chrome trace-event format (chrome://tracing, Perfetto UI)
+         std::string toChromeJson() const;
+         bool saveChromeJson(const std::string &fileName) const;
+
+      private:
+         Profiler() = default;
+
+         struct ThreadBuffer
+         {
+            ThreadBuffer();
+
+            uint64_t             threadId{};
+            std::string          threadName;
+            std::vector<Event>   events;
+            size_t               nbWritten{};
+            mutable std::mutex   mutex;
+         };
+
+         // Owned by thread_local storage, retires the buffer on thread exit
+         struct ThreadBufferHolder
+         {
+            ~ThreadBufferHolder();
+
+            std::shared_ptr<ThreadBuffer> buffer;
+         };
+
+         struct ExitedThread
+         {
+            uint64_t             threadId;
+            std::string          threadName;
+            std::vector<Event>   events;  // oldest first
+         };
+
+         ThreadBuffer &threadBuffer();
+         void retire(const std::shared_ptr<ThreadBuffer> &);
+
+      private:
+         std::atomic_bool  enabled_{ true };
+
+         mutable std::mutex                           buffersMutex_;
+         std::vector<std::shared_ptr<ThreadBuffer>>   buffers_;
+         std::vector<std::shared_ptr<ThreadBuffer>>   freeBuffers_;
+         std::deque<ExitedThread>                     exitedThreads_;
+         size_t                                       nbExitedEvents_{};
+      };
+
+      class Span
+      {
+      public:
+         Span(const char *name, const char *category)
+            : name_(name), category_(category)
+            , beginUs_(Profiler::instance().enabled() ? Profiler::now() : -1)
+         {}
+
+         ~Span()
+         {
+            if (beginUs_ >= 0) {
+               Profiler::instance().record(name_, category_, beginUs_, Profiler::now() - beginUs_);
+            }
+         }
+
+         Span(const Span &) = delete;
+         Span &operator=(const Span &) = delete;
+         Span(Span &&) = delete;
+         Span &operator=(Span &&) = delete;
+
+      private:
+         const char     *name_;
+         const char     *category_;
+         const int64_t  beginUs_;
+      };
+
+   } // namespace trace
+} // namespace bs
+
+#endif // __TRACE_PROFILER_H__
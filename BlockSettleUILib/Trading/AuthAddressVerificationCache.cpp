@@ -0,0 +1,220 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "AuthAddressVerificationCache.h"
+
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <QApplication>
+#include <QTimer>
+
+#include "AuthAddressManager.h"
+
+using namespace bs;
+
+namespace {
+
+   const auto kBatchTimeout = std::chrono::seconds(60);
+
+} // namespace
+
+AuthAddressVerificationCache::AuthAddressVerificationCache(const std::shared_ptr<spdlog::logger> &logger
+   , const std::shared_ptr<ArmoryConnection> &armory
+   , const std::shared_ptr<AuthAddressManager> &authAddrMgr
+   , QObject *parent)
+   : QObject(parent)
+   , logger_(logger)
+   , armory_(armory)
+   , authAddrMgr_(authAddrMgr)
+{
+   init(armory_.get());
+}
+
+AuthAddressVerificationCache::~AuthAddressVerificationCache() noexcept
+{
+   cleanup();
+}
+
+void AuthAddressVerificationCache::verify(const bs::Address &address, const ResultCb &cb)
+{
+   const auto key = address.display();
+   const auto itEntry = entries_.find(key);
+   if ((itEntry != entries_.end()) && (itEntry->second.topBlock == armory_->topBlock())) {
+      if (cb) {
+         cb(address, itEntry->second.state);
+      }
+      return;
+   }
+
+   if (cb) {
+      waiters_[key].push_back(cb);
+   }
+   // Tracked separately from waiters_ as null callbacks are not stored there
+   if (!inFlight_.insert(key).second) {
+      return;
+   }
+
+   if (queued_.empty()) {
+      QMetaObject::invokeMethod(this, [this] { startBatch(); }, Qt::QueuedConnection);
+   }
+   queued_.push_back(address);
+}
+
+bool AuthAddressVerificationCache::cachedState(const bs::Address &address
+   , AddressVerificationState &state) const
+{
+   const auto it = entries_.find(address.display());
+   if ((it == entries_.end()) || (it->second.topBlock != armory_->topBlock())) {
+      return false;
+   }
+   state = it->second.state;
+   return true;
+}
+
+void AuthAddressVerificationCache::onNewBlock(unsigned int height, unsigned int)
+{
+   QMetaObject::invokeMethod(this, [this, height] { invalidate(height); });
+}
+
+void AuthAddressVerificationCache::onStateChanged(ArmoryState state)
+{
+   if (state == ArmoryState::Offline) {
+      QMetaObject::invokeMethod(this, [this] { failAll(); });
+   }
+}
+
+void AuthAddressVerificationCache::startBatch()
+{
+   if (queued_.empty()) {
+      return;
+   }
+   const auto batchId = ++lastBatchId_;
+   auto &batch = batches_[batchId];
+   batch.verificator = std::make_shared<AddressVerificator>(logger_, armory_
+      , [this, batchId, handle = validityFlag_.handle()](const bs::Address &address, AddressVerificationState state)
+   {
+      QMetaObject::invokeMethod(qApp, [this, handle, batchId, address, state] {
+         if (!handle.isValid()) {
+            return;
+         }
+         onResult(batchId, address, state);
+      });
+   });
+   batch.verificator->SetBSAddressList(authAddrMgr_->GetBSAddresses());
+
+   for (const auto &address : queued_) {
+      batch.pending.emplace(address.display(), address);
+      batch.verificator->addAddress(address);
+   }
+   SPDLOG_LOGGER_DEBUG(logger_, "verifying {} auth address[es] in batch #{}"
+      , queued_.size(), batchId);
+   queued_.clear();
+
+   batch.verificator->startAddressVerification();
+
+   QTimer::singleShot(kBatchTimeout, this, [this, batchId] {
+      if (batches_.find(batchId) != batches_.end()) {
+         SPDLOG_LOGGER_WARN(logger_, "auth address verification batch #{} timed out", batchId);
+         failBatch(batchId);
+      }
+   });
+}
+
+void AuthAddressVerificationCache::onResult(uint64_t batchId, const bs::Address &address
+   , AddressVerificationState state)
+{
+   const auto key = address.display();
+
+   // Results of failed (timed out or disconnected) batches are stale
+   const auto itBatch = batches_.find(batchId);
+   if ((itBatch == batches_.end()) || (itBatch->second.pending.count(key) == 0)) {
+      return;
+   }
+
+   if (isFinal(state)) {
+      // VerificationFailed is not cached as it could be caused by connection issues
+      if (state != AddressVerificationState::VerificationFailed) {
+         entries_[key] = { state, armory_->topBlock() };
+      }
+      itBatch->second.pending.erase(key);
+      if (itBatch->second.pending.empty()) {
+         batches_.erase(itBatch);
+      }
+   }
+
+   deliver(address, state);
+}
+
+void AuthAddressVerificationCache::failBatch(uint64_t batchId)
+{
+   const auto itBatch = batches_.find(batchId);
+   if (itBatch == batches_.end()) {
+      return;
+   }
+   const auto pending = std::move(itBatch->second.pending);
+   batches_.erase(itBatch);
+
+   for (const auto &item : pending) {
+      deliver(item.second, AddressVerificationState::VerificationFailed);
+   }
+}
+
+void AuthAddressVerificationCache::failAll()
+{
+   // Queued addresses are left alone: their batch is started on the next
+   // event loop iteration and is covered by its own timeout
+   std::vector<uint64_t> batchIds;
+   batchIds.reserve(batches_.size());
+   for (const auto &batch : batches_) {
+      batchIds.push_back(batch.first);
+   }
+   for (const auto batchId : batchIds) {
+      failBatch(batchId);
+   }
+}
+
+void AuthAddressVerificationCache::deliver(const bs::Address &address
+   , AddressVerificationState state)
+{
+   const auto key = address.display();
+
+   std::vector<ResultCb> waiters;
+   const auto itWaiters = waiters_.find(key);
+   if (isFinal(state)) {
+      inFlight_.erase(key);
+      if (itWaiters != waiters_.end()) {
+         waiters = std::move(itWaiters->second);
+         waiters_.erase(itWaiters);
+      }
+   } else if (itWaiters != waiters_.end()) {
+      waiters = itWaiters->second;
+   }
+
+   // Callbacks could request verification again
+   for (const auto &cb : waiters) {
+      cb(address, state);
+   }
+}
+
+void AuthAddressVerificationCache::invalidate(unsigned int topBlock)
+{
+   for (auto it = entries_.begin(); it != entries_.end(); ) {
+      if (it->second.topBlock != topBlock) {
+         it = entries_.erase(it);
+      } else {
+         ++it;
+      }
+   }
+}
+
+bool AuthAddressVerificationCache::isFinal(AddressVerificationState state)
+{
+   return (state != AddressVerificationState::InProgress);
+}
@@ -0,0 +1,107 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef AUTH_ADDRESS_VERIFICATION_CACHE_H
+#define AUTH_ADDRESS_VERIFICATION_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <QObject>
+#include "AddressVerificator.h"
+#include "ArmoryConnection.h"
+#include "ValidityFlag.h"
+
+namespace spdlog {
+   class logger;
+}
+class AuthAddressManager;
+
+namespace bs {
+
+   // Counterparty auth address states shared by settlement containers
+   // (GUI thread only). Final states are kept per address together with the
+   // top block they were obtained at and are dropped on the next block, so a
+   // repeated settlement with the same counterparty doesn't go to Armory.
+   // Requests made within one event loop iteration are verified in a single
+   // batch by one AddressVerificator. Pending requests are failed with
+   // VerificationFailed if Armory goes offline or the batch times out.
+   class AuthAddressVerificationCache : public QObject, public ArmoryCallbackTarget
+   {
+   public:
+      using ResultCb = std::function<void(const bs::Address &, AddressVerificationState)>;
+
+      AuthAddressVerificationCache(const std::shared_ptr<spdlog::logger> &
+         , const std::shared_ptr<ArmoryConnection> &
+         , const std::shared_ptr<AuthAddressManager> &
+         , QObject *parent = nullptr);
+      ~AuthAddressVerificationCache() noexcept override;
+
+      AuthAddressVerificationCache(const AuthAddressVerificationCache &) = delete;
+      AuthAddressVerificationCache &operator=(const AuthAddressVerificationCache &) = delete;
+      AuthAddressVerificationCache(AuthAddressVerificationCache &&) = delete;
+      AuthAddressVerificationCache &operator=(AuthAddressVerificationCache &&) = delete;
+
+      // Callback is called synchronously if the state is already known for
+      // the current top block, otherwise later for each state update until
+      // the final one. Caller should guard captured objects itself.
+      // Null callback only starts verification to warm up the cache.
+      void verify(const bs::Address &, const ResultCb &);
+
+      // Return false if there is no valid cached state for the address
+      bool cachedState(const bs::Address &, AddressVerificationState &) const;
+
+   protected:
+      void onNewBlock(unsigned int height, unsigned int branchHeight) override;
+      void onStateChanged(ArmoryState) override;
+
+   private:
+      struct Entry
+      {
+         AddressVerificationState   state;
+         unsigned int               topBlock;
+      };
+
+      struct Batch
+      {
+         std::shared_ptr<AddressVerificator> verificator;
+         std::unordered_map<std::string, bs::Address> pending;
+      };
+
+      void startBatch();
+      void onResult(uint64_t batchId, const bs::Address &, AddressVerificationState);
+      void failBatch(uint64_t batchId);
+      void failAll();
+      void deliver(const bs::Address &, AddressVerificationState);
+      void invalidate(unsigned int topBlock);
+
+      static bool isFinal(AddressVerificationState);
+
+   private:
+      std::shared_ptr<spdlog::logger>     logger_;
+      std::shared_ptr<ArmoryConnection>   armory_;
+      std::shared_ptr<AuthAddressManager> authAddrMgr_;
+
+      std::unordered_map<std::string, Entry>                   entries_;
+      std::unordered_map<std::string, std::vector<ResultCb>>   waiters_;
+      std::unordered_set<std::string>                          inFlight_;
+      std::vector<bs::Address>                                 queued_;
+      std::unordered_map<uint64_t, Batch>                      batches_;
+      uint64_t                                                 lastBatchId_{};
+
+      ValidityFlag validityFlag_;
+   };
+
+} // namespace bs
+
+#endif // AUTH_ADDRESS_VERIFICATION_CACHE_H
@@ -0,0 +1,90 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "DeadlineScheduler.h"
+
+#include <algorithm>
+
+using namespace bs;
+
+DeadlineScheduler &DeadlineScheduler::instance()
+{
+   static DeadlineScheduler scheduler;
+   return scheduler;
+}
+
+DeadlineScheduler::DeadlineScheduler()
+{
+   timer_.setSingleShot(true);
+   timer_.setTimerType(Qt::PreciseTimer);
+   QObject::connect(&timer_, &QTimer::timeout, [this] {
+      onTimeout();
+   });
+}
+
+DeadlineScheduler::Id DeadlineScheduler::schedule(Clock::time_point deadline
+   , const std::function<void()> &cb)
+{
+   const auto id = ++lastId_;
+   callbacks_[id] = cb;
+   const bool earliest = heap_.empty() || (deadline < heap_.top().deadline);
+   heap_.push({ deadline, id });
+   if (earliest) {
+      rearm();
+   }
+   return id;
+}
+
+void DeadlineScheduler::cancel(Id id)
+{
+   callbacks_.erase(id);
+   if (callbacks_.empty()) {
+      heap_ = decltype(heap_)();
+      timer_.stop();
+   }
+}
+
+void DeadlineScheduler::onTimeout()
+{
+   const auto now = Clock::now();
+   std::vector<Id> expired;
+   while (!heap_.empty() && (heap_.top().deadline <= now)) {
+      expired.push_back(heap_.top().id);
+      heap_.pop();
+   }
+
+   // Callbacks could schedule new or cancel other (also expired) deadlines
+   for (const auto id : expired) {
+      const auto it = callbacks_.find(id);
+      if (it == callbacks_.end()) {
+         continue;
+      }
+      const auto cb = std::move(it->second);
+      callbacks_.erase(it);
+      if (cb) {
+         cb();
+      }
+   }
+   rearm();
+}
+
+void DeadlineScheduler::rearm()
+{
+   while (!heap_.empty() && (callbacks_.find(heap_.top().id) == callbacks_.end())) {
+      heap_.pop();
+   }
+   if (heap_.empty()) {
+      timer_.stop();
+      return;
+   }
+   const auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(
+      heap_.top().deadline - Clock::now());
+   timer_.start(std::max(0, static_cast<int>(interval.count())));
+}
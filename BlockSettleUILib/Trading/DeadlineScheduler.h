@@ -0,0 +1,69 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef DEADLINE_SCHEDULER_H
+#define DEADLINE_SCHEDULER_H
+
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <QTimer>
+
+namespace bs {
+
+   // Shared expiry timer for settlement containers (GUI thread only).
+   // Deadlines are kept in a min-heap and a single-shot timer is armed for
+   // the earliest one, so there are no wakeups between expiries. Each
+   // callback fires once; cancelled entries are dropped lazily.
+   class DeadlineScheduler
+   {
+   public:
+      using Clock = std::chrono::steady_clock;
+      using Id = uint64_t;
+
+      static DeadlineScheduler &instance();
+
+      DeadlineScheduler(const DeadlineScheduler &) = delete;
+      DeadlineScheduler &operator=(const DeadlineScheduler &) = delete;
+      DeadlineScheduler(DeadlineScheduler &&) = delete;
+      DeadlineScheduler &operator=(DeadlineScheduler &&) = delete;
+
+      // Returned id is never 0
+      Id schedule(Clock::time_point deadline, const std::function<void()> &);
+      void cancel(Id);
+
+      size_t size() const { return callbacks_.size(); }
+
+   private:
+      DeadlineScheduler();
+
+      void onTimeout();
+      void rearm();
+
+   private:
+      struct Entry
+      {
+         Clock::time_point deadline;
+         Id id;
+
+         bool operator>(const Entry &other) const { return deadline > other.deadline; }
+      };
+
+      QTimer   timer_;
+      std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>  heap_;
+      std::unordered_map<Id, std::function<void()>>   callbacks_;
+      Id       lastId_{ 0 };
+   };
+
+} // namespace bs
+
+#endif // DEADLINE_SCHEDULER_H
@@ -16,6 +16,7 @@
 #include "CheckRecipSigner.h"
 #include "SignContainer.h"
 #include "SignerDefs.h"
+#include "TraceProfiler.h"
 #include "UiUtils.h"
 #include "Wallets/SyncHDWallet.h"
 #include "Wallets/SyncWallet.h"
@@ -110,6 +111,7 @@ bs::sync::PasswordDialogData DealerCCSettlementContainer::toPasswordDialogData(Q
 
 bool DealerCCSettlementContainer::startSigning(QDateTime timestamp)
 {
+   BS_TRACE_FUNCTION();
    if (!ccWallet_ || !xbtWallet_) {
       logger_->error("[DealerCCSettlementContainer::accept] failed to validate counterparty's TX - aborting");
       sendFailed();
@@ -163,6 +165,7 @@ bool DealerCCSettlementContainer::startSigning(QDateTime timestamp)
 
 void DealerCCSettlementContainer::activate()
 {
+   BS_TRACE_FUNCTION();
    try {
       signer_.deserializeState(txReqData_);
       foundRecipAddr_ = signer_.findRecipAddress(ownRecvAddr_, [this](uint64_t value, uint64_t valReturn, uint64_t valInput) {
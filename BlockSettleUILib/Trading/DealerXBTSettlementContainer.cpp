@@ -11,9 +11,11 @@
 #include "DealerXBTSettlementContainer.h"
 
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "CheckRecipSigner.h"
 #include "CurrencyPair.h"
 #include "QuoteProvider.h"
+#include "TraceProfiler.h"
 #include "TradesUtils.h"
 #include "UiUtils.h"
 #include "UtxoReservationManager.h"
@@ -37,6 +39,7 @@ DealerXBTSettlementContainer::DealerXBTSettlementContainer(const std::shared_ptr
    , const std::shared_ptr<WalletSignerContainer> &container
    , const std::shared_ptr<ArmoryConnection> &armory
    , const std::shared_ptr<AuthAddressManager> &authAddrMgr
+   , const std::shared_ptr<bs::AuthAddressVerificationCache> &authAddrVerifCache
    , const bs::Address &authAddr
    , const std::vector<UTXO> &utxosPayinFixed
    , const bs::Address &recvAddr
@@ -54,6 +57,7 @@ DealerXBTSettlementContainer::DealerXBTSettlementContainer(const std::shared_ptr
    , xbtWallet_(xbtWallet)
    , signContainer_(container)
    , authAddrMgr_(authAddrMgr)
+   , authAddrVerifCache_(authAddrVerifCache)
    , utxosPayinFixed_(utxosPayinFixed)
    , recvAddr_(recvAddr)
    , authAddr_(authAddr)
@@ -160,38 +164,32 @@ bs::sync::PasswordDialogData DealerXBTSettlementContainer::toPasswordDialogData(
 
 void DealerXBTSettlementContainer::activate()
 {
+   BS_TRACE_FUNCTION();
    startTimer(kWaitTimeoutInSec);
 
-   addrVerificator_ = std::make_shared<AddressVerificator>(logger_, armory_
-      , [this, handle = validityFlag_.handle()](const bs::Address &address, AddressVerificationState state)
+   const auto reqAuthAddrSW = bs::Address::fromPubKey(reqAuthKey_, AddressEntryType_P2WPKH);
+   authAddrVerifCache_->verify(reqAuthAddrSW, [this, handle = validityFlag_.handle()]
+      (const bs::Address &address, AddressVerificationState state)
    {
-      QMetaObject::invokeMethod(qApp, [this, handle, address, state] {
-         if (!handle.isValid()) {
-            return;
-         }
+      if (!handle.isValid()) {
+         return;
+      }
 
-         SPDLOG_LOGGER_INFO(logger_, "counterparty's address verification {} for {}"
-            , to_string(state), address.display());
-         requestorAddressState_ = state;
+      SPDLOG_LOGGER_INFO(logger_, "counterparty's address verification {} for {}"
+         , to_string(state), address.display());
+      requestorAddressState_ = state;
 
-         if (state == AddressVerificationState::Verified) {
-            // we verify only requester's auth address
-            bs::sync::PasswordDialogData dialogData;
-            dialogData.setValue(PasswordDialogData::RequesterAuthAddressVerified, true);
-            dialogData.setValue(PasswordDialogData::SettlementId, settlementId_.toHexStr());
-            dialogData.setValue(PasswordDialogData::SigningAllowed, true);
+      if (state == AddressVerificationState::Verified) {
+         // we verify only requester's auth address
+         bs::sync::PasswordDialogData dialogData;
+         dialogData.setValue(PasswordDialogData::RequesterAuthAddressVerified, true);
+         dialogData.setValue(PasswordDialogData::SettlementId, settlementId_.toHexStr());
+         dialogData.setValue(PasswordDialogData::SigningAllowed, true);
 
-            signContainer_->updateDialogData(dialogData);
-         }
-      });
+         signContainer_->updateDialogData(dialogData);
+      }
    });
 
-   addrVerificator_->SetBSAddressList(authAddrMgr_->GetBSAddresses());
-
-   const auto reqAuthAddrSW = bs::Address::fromPubKey(reqAuthKey_, AddressEntryType_P2WPKH);
-   addrVerificator_->addAddress(reqAuthAddrSW);
-   addrVerificator_->startAddressVerification();
-
    const auto &authLeaf = walletsMgr_->getAuthWallet();
    signContainer_->setSettlAuthAddr(authLeaf->walletId(), settlementId_, authAddr_);
 }
@@ -204,6 +202,7 @@ void DealerXBTSettlementContainer::deactivate()
 void DealerXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signedTX
    , bs::error::ErrorCode errCode, std::string errMsg)
 {
+   BS_TRACE_FUNCTION();
    if (payoutSignId_ && (payoutSignId_ == id)) {
       payoutSignId_ = 0;
 
@@ -278,6 +277,7 @@ void DealerXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signed
 
 void DealerXBTSettlementContainer::onUnsignedPayinRequested(const std::string& settlementId)
 {
+   BS_TRACE_FUNCTION();
    if (settlementIdHex_ != settlementId) {
       // ignore
       return;
@@ -343,6 +343,7 @@ void DealerXBTSettlementContainer::onUnsignedPayinRequested(const std::string& s
 void DealerXBTSettlementContainer::onSignedPayoutRequested(const std::string& settlementId
    , const BinaryData& payinHash, QDateTime timestamp)
 {
+   BS_TRACE_FUNCTION();
    if (settlementIdHex_ != settlementId) {
       // ignore
       return;
@@ -407,6 +408,7 @@ void DealerXBTSettlementContainer::onSignedPayoutRequested(const std::string& se
 void DealerXBTSettlementContainer::onSignedPayinRequested(const std::string& settlementId
    , const BinaryData& unsignedPayin, QDateTime timestamp)
 {
+   BS_TRACE_FUNCTION();
    if (settlementIdHex_ != settlementId) {
       // ignore
       return;
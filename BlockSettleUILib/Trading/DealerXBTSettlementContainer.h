@@ -33,6 +33,7 @@ namespace bs {
    namespace tradeutils {
       struct Args;
    }
+   class AuthAddressVerificationCache;
    class UTXOReservationManager;
 }
 class ArmoryConnection;
@@ -53,6 +54,7 @@ public:
       , const std::shared_ptr<WalletSignerContainer> &
       , const std::shared_ptr<ArmoryConnection> &
       , const std::shared_ptr<AuthAddressManager> &authAddrMgr
+      , const std::shared_ptr<bs::AuthAddressVerificationCache> &
       , const bs::Address &authAddr
       , const std::vector<UTXO> &utxosPayinFixed
       , const bs::Address &recvAddr
@@ -109,9 +111,9 @@ private:
    std::shared_ptr<ArmoryConnection>            armory_;
    std::shared_ptr<bs::sync::WalletsManager>    walletsMgr_;
    std::shared_ptr<bs::sync::hd::Wallet>        xbtWallet_;
-   std::shared_ptr<AddressVerificator>          addrVerificator_;
    std::shared_ptr<WalletSignerContainer>       signContainer_;
    std::shared_ptr<AuthAddressManager>          authAddrMgr_;
+   std::shared_ptr<bs::AuthAddressVerificationCache> authAddrVerifCache_;
    std::shared_ptr<bs::UTXOReservationManager>  utxoReservationManager_;
 
    AddressVerificationState                     requestorAddressState_ = AddressVerificationState::VerificationFailed;
@@ -76,6 +76,11 @@ QToggleItem* priceItem(const QString &price)
 
 QToggleItem *MarketDataModel::getGroup(bs::network::Asset::Type assetType)
 {
+   const auto itGroup = groups_.find(assetType);
+   if (itGroup != groups_.end()) {
+      return itGroup->second;
+   }
+
    QString productGroup;
    if (assetType == bs::network::Asset::Undefined) {
       productGroup = tr("Rejected");
@@ -83,16 +88,10 @@ QToggleItem *MarketDataModel::getGroup(bs::network::Asset::Type assetType)
    else {
       productGroup = tr(bs::network::Asset::toString(assetType));
    }
-   auto groupItems = findItems(productGroup);
-   QToggleItem* groupItem = nullptr;
-   if (groupItems.isEmpty()) {
-      groupItem = new QToggleItem(productGroup, isVisible(productGroup));
-      groupItem->setData(-1);
-      appendRow(QList<QStandardItem*>() << groupItem);
-   }
-   else {
-      groupItem = static_cast<QToggleItem *>(groupItems.first());
-   }
+   auto groupItem = new QToggleItem(productGroup, isVisible(productGroup));
+   groupItem->setData(-1);
+   appendRow(QList<QStandardItem*>() << groupItem);
+   groups_[assetType] = groupItem;
    return groupItem;
 }
 
@@ -160,6 +159,8 @@ void MarketDataModel::onMDUpdated(bs::network::Asset::Type assetType, const QStr
 {
    if ((assetType == bs::network::Asset::Undefined) && security.isEmpty()) {  // Celer disconnected
       priceUpdates_.clear();
+      groups_.clear();
+      rowsByGroup_.clear();
       removeRows(0, rowCount());
       return;
    }
@@ -167,7 +168,8 @@ void MarketDataModel::onMDUpdated(bs::network::Asset::Type assetType, const QStr
    PriceMap fieldsMap;
    FieldsToMap(assetType, mdFields, fieldsMap);
    auto groupItem = getGroup(assetType);
-   auto childRow = groupItem->findRowWithText(security);
+   auto &groupRows = rowsByGroup_[assetType];
+   const auto childRow = groupRows.value(security);
    const auto timeNow = QDateTime::currentDateTime();
    if (!childRow.empty()) {
       for (const auto &price : fieldsMap) {
@@ -193,6 +195,9 @@ void MarketDataModel::onMDUpdated(bs::network::Asset::Type assetType, const QStr
       }
    }
    groupItem->addRow(items);
+   if (assetType != bs::network::Asset::Type::Undefined) {
+      groupRows.insert(security, items);
+   }
 }
 
 QBrush MarketDataModel::bgColorForCol(const QString &security, MarketDataModel::MarketDataColumns col, double price
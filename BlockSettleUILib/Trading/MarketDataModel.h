@@ -16,6 +16,7 @@
 #include <set>
 #include <unordered_map>
 #include <QBrush>
+#include <QHash>
 #include <QStandardItemModel>
 #include <QSortFilterProxyModel>
 #include <QTimer>
@@ -96,6 +97,10 @@ private:
    PriceUpdates         priceUpdates_;
    QTimer               timer_;
 
+   // Lookup of group items and security rows (both visible and filtered out)
+   std::unordered_map<int, QToggleItem *>                            groups_;
+   std::unordered_map<int, QHash<QString, QToggleItem::QToggleRow>>   rowsByGroup_;
+
 private:
    QToggleItem *getGroup(bs::network::Asset::Type);
    QString columnName(MarketDataColumns) const;
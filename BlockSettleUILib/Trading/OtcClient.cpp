@@ -114,6 +114,11 @@ namespace {
    // Use some delay to detect networking problems locally to prevent race.
    const auto kLocalTimeoutDelay = std::chrono::seconds(5);
 
+   bool isSameRequest(const QuoteRequest &a, const QuoteRequest &b)
+   {
+      return (a.ourSide == b.ourSide) && (a.rangeType == b.rangeType) && (a.timestamp == b.timestamp);
+   }
+
    const auto kStartOtcTimeout = std::chrono::seconds(10);
 
    bs::sync::PasswordDialogData toPasswordDialogData(const OtcClientDeal &deal
@@ -1755,6 +1760,7 @@ void OtcClient::updatePublicLists()
    for (auto &item : requestMap_) {
       requests_.push_back(&item.second);
    }
+   reportPublicRequestChanges();
 
    responses_.clear();
    responses_.reserve(responseMap_.size());
@@ -1765,6 +1771,40 @@ void OtcClient::updatePublicLists()
    emit publicUpdated();
 }
 
+void OtcClient::reportPublicRequestChanges()
+{
+   std::unordered_map<std::string, PublicRequest> actualRequests;
+   actualRequests.reserve(requests_.size());
+   for (const auto &peer : requests_) {
+      actualRequests[peer->contactId] = { peer->request, peer->isOwnRequest };
+   }
+
+   for (auto it = publicRequests_.begin(); it != publicRequests_.end(); ) {
+      if (actualRequests.find(it->first) == actualRequests.end()) {
+         const auto requestId = it->first;
+         it = publicRequests_.erase(it);
+         emit publicRequestRemoved(requestId);
+      }
+      else {
+         ++it;
+      }
+   }
+
+   for (const auto &item : actualRequests) {
+      auto it = publicRequests_.find(item.first);
+      if (it == publicRequests_.end()) {
+         publicRequests_.emplace(item.first, item.second);
+         emit publicRequestAdded(item.first, item.second.request, item.second.isOwnRequest);
+         continue;
+      }
+      if (!isSameRequest(it->second.request, item.second.request)
+         || (it->second.isOwnRequest != item.second.isOwnRequest)) {
+         it->second = item.second;
+         emit publicRequestUpdated(item.first, item.second.request, item.second.isOwnRequest);
+      }
+   }
+}
+
 void OtcClient::initTradesArgs(bs::tradeutils::Args &args, Peer *peer, const std::string &settlementId)
 {
    args.amount = bs::XBTAmount(static_cast<uint64_t>(peer->offer.amount));
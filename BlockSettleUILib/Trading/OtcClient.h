@@ -142,6 +142,12 @@ signals:
 
    void publicUpdated();
 
+   // Per-request changes of public requests list (emitted before publicUpdated).
+   // requestId is contactId of the requester and is stable while request is alive.
+   void publicRequestAdded(const std::string &requestId, const bs::network::otc::QuoteRequest &request, bool isOwnRequest);
+   void publicRequestUpdated(const std::string &requestId, const bs::network::otc::QuoteRequest &request, bool isOwnRequest);
+   void publicRequestRemoved(const std::string &requestId);
+
 private slots:
    void onTxSigned(unsigned reqId, BinaryData signedTX, bs::error::ErrorCode result, const std::string &errorReason);
 
@@ -191,6 +197,7 @@ private:
    void setComments(OtcClientDeal *deal);
 
    void updatePublicLists();
+   void reportPublicRequestChanges();
 
    void initTradesArgs(bs::tradeutils::Args &args, bs::network::otc::Peer *peer, const std::string &settlementId);
 
@@ -229,6 +236,14 @@ private:
    bs::network::otc::Peers requests_;
    bs::network::otc::Peers responses_;
 
+   struct PublicRequest
+   {
+      bs::network::otc::QuoteRequest request;
+      bool isOwnRequest{};
+   };
+   // Public requests as last reported with publicRequestXXX signals
+   std::unordered_map<std::string, PublicRequest> publicRequests_;
+
    OtcClientParams params_;
 
    // Utxo reservation
@@ -33,6 +33,7 @@
 #include "QuoteProvider.h"
 #include "SelectedTransactionInputs.h"
 #include "SignContainer.h"
+#include "TraceProfiler.h"
 #include "TradesUtils.h"
 #include "TxClasses.h"
 #include "UiUtils.h"
@@ -275,6 +276,7 @@ void RFQDealerReply::quoteReqNotifStatusChanged(const bs::network::QuoteReqNotif
 
 void RFQDealerReply::setQuoteReqNotification(const bs::network::QuoteReqNotification &qrn, double indicBid, double indicAsk)
 {
+   BS_TRACE_FUNCTION();
    indicBid_ = indicBid;
    indicAsk_ = indicAsk;
 
@@ -283,6 +285,7 @@ void RFQDealerReply::setQuoteReqNotification(const bs::network::QuoteReqNotifica
 
 void RFQDealerReply::updateQuoteReqNotification(const bs::network::QuoteReqNotification &qrn)
 {
+   BS_TRACE_FUNCTION();
    const auto &oldReqId = currentQRN_.quoteRequestId;
    const bool qrnChanged = (oldReqId != qrn.quoteRequestId);
    currentQRN_ = qrn;
@@ -422,6 +425,7 @@ void RFQDealerReply::onAuthAddrChanged(int index)
 
 void RFQDealerReply::updateSubmitButton()
 {
+   BS_TRACE_FUNCTION();
    if (!currentQRN_.empty() && activeQuoteSubmits_.find(currentQRN_.quoteRequestId) != activeQuoteSubmits_.end()) {
       // Do not allow re-enter into submitReply as it could cause problems
       ui_->pushButtonSubmit->setEnabled(false);
@@ -481,6 +485,7 @@ void RFQDealerReply::setBalanceOk(bool ok)
 
 bool RFQDealerReply::checkBalance() const
 {
+   BS_TRACE_FUNCTION();
    if (!assetManager_) {
       return false;
    }
@@ -518,6 +523,7 @@ bool RFQDealerReply::checkBalance() const
 
 void RFQDealerReply::walletSelected(int index)
 {
+   BS_TRACE_FUNCTION();
    reset();
    updateSubmitButton();
 }
@@ -625,6 +631,7 @@ void bs::ui::RFQDealerReply::onParentAboutToHide()
 
 void RFQDealerReply::submitReply(const bs::network::QuoteReqNotification &qrn, double price, ReplyType replyType)
 {
+   BS_TRACE_FUNCTION();
    if (qFuzzyIsNull(price)) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid price");
       return;
@@ -956,6 +963,7 @@ void RFQDealerReply::onTransactionDataChanged()
 
 void RFQDealerReply::onMDUpdate(bs::network::Asset::Type, const QString &security, bs::network::MDFields mdFields)
 {
+   BS_TRACE_FUNCTION();
    const double bid = bs::network::MDField::get(mdFields, bs::network::MDField::PriceBid).value;
    const double ask = bs::network::MDField::get(mdFields, bs::network::MDField::PriceOffer).value;
    const double last = bs::network::MDField::get(mdFields, bs::network::MDField::PriceLast).value;
@@ -984,6 +992,7 @@ void RFQDealerReply::onMDUpdate(bs::network::Asset::Type, const QString &securit
 
 void RFQDealerReply::onBestQuotePrice(const QString reqId, double price, bool own)
 {
+   BS_TRACE_FUNCTION();
    bestQPrices_[reqId.toStdString()] = price;
 
    if (!currentQRN_.empty() && (currentQRN_.quoteRequestId == reqId.toStdString())) {
@@ -1012,6 +1021,7 @@ void RFQDealerReply::onBestQuotePrice(const QString reqId, double price, bool ow
 
 void RFQDealerReply::onAQReply(const bs::network::QuoteReqNotification &qrn, double price)
 {
+   BS_TRACE_FUNCTION();
    // Check assets first
    bool ok = true;
    if (qrn.assetType == bs::network::Asset::Type::SpotXBT) {
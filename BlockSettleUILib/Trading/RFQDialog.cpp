@@ -30,6 +30,7 @@ RFQDialog::RFQDialog(const std::shared_ptr<spdlog::logger> &logger
    , const std::string &id, const bs::network::RFQ& rfq
    , const std::shared_ptr<QuoteProvider>& quoteProvider
    , const std::shared_ptr<AuthAddressManager>& authAddressManager
+   , const std::shared_ptr<bs::AuthAddressVerificationCache> &authAddrVerifCache
    , const std::shared_ptr<AssetManager>& assetManager
    , const std::shared_ptr<bs::sync::WalletsManager> &walletsManager
    , const std::shared_ptr<WalletSignerContainer> &signContainer
@@ -53,6 +54,7 @@ RFQDialog::RFQDialog(const std::shared_ptr<spdlog::logger> &logger
    , recvXbtAddrIfSet_(recvXbtAddrIfSet)
    , quoteProvider_(quoteProvider)
    , authAddressManager_(authAddressManager)
+   , authAddrVerifCache_(authAddrVerifCache)
    , walletsManager_(walletsManager)
    , signContainer_(signContainer)
    , assetMgr_(assetManager)
@@ -178,7 +180,7 @@ std::shared_ptr<bs::SettlementContainer> RFQDialog::newXBTcontainer()
 
    try {
       xbtSettlContainer_ = std::make_shared<ReqXBTSettlementContainer>(logger_
-         , authAddressManager_, signContainer_, armory_, xbtWallet_, walletsManager_
+         , authAddressManager_, authAddrVerifCache_, signContainer_, armory_, xbtWallet_, walletsManager_
          , rfq_, quote_, authAddr_, fixedXbtInputs_, std::move(fixedXbtUtxoRes_), utxoReservationManager_
          , std::move(walletPurpose_), recvXbtAddrIfSet_, expandTxInfo);
 
@@ -35,6 +35,7 @@ namespace bs {
       class WalletsManager;
    }
    class SettlementContainer;
+   class AuthAddressVerificationCache;
    class UTXOReservationManager;
 }
 class ApplicationSettings;
@@ -60,6 +61,7 @@ public:
       , const std::string &id, const bs::network::RFQ& rfq
       , const std::shared_ptr<QuoteProvider>& quoteProvider
       , const std::shared_ptr<AuthAddressManager>& authAddressManager
+      , const std::shared_ptr<bs::AuthAddressVerificationCache> &
       , const std::shared_ptr<AssetManager>& assetManager
       , const std::shared_ptr<bs::sync::WalletsManager> &walletsManager
       , const std::shared_ptr<WalletSignerContainer> &
@@ -127,6 +129,7 @@ private:
 
    std::shared_ptr<QuoteProvider>               quoteProvider_;
    std::shared_ptr<AuthAddressManager>          authAddressManager_;
+   std::shared_ptr<bs::AuthAddressVerificationCache> authAddrVerifCache_;
    std::shared_ptr<bs::sync::WalletsManager>    walletsManager_;
    std::shared_ptr<WalletSignerContainer>       signContainer_;
    std::shared_ptr<AssetManager>                assetMgr_;
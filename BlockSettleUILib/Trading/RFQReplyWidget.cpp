@@ -13,6 +13,7 @@
 
 #include "AssetManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "AutoSignQuoteProvider.h"
 #include "BSMessageBox.h"
 #include "CelerClient.h"
@@ -151,6 +152,8 @@ void RFQReplyWidget::init(const std::shared_ptr<spdlog::logger> &logger
    appSettings_ = appSettings;
    connectionManager_ = connectionManager;
    utxoReservationManager_ = utxoReservationManager;
+   authAddrVerifCache_ = std::make_shared<bs::AuthAddressVerificationCache>(logger
+      , armory, authAddressManager);
 
    statsCollector_ = std::make_shared<bs::SecurityStatsCollector>(appSettings
       , ApplicationSettings::Filter_MD_QN_cnt);
@@ -347,7 +350,7 @@ void RFQReplyWidget::onOrder(const bs::network::Order &order)
             const auto recvXbtAddr = bs::Address();
             const auto settlContainer = std::make_shared<DealerXBTSettlementContainer>(logger_, order
                , walletsManager_, reply.xbtWallet, quoteProvider_, signingContainer_, armory_, authAddressManager_
-               , reply.authAddr, reply.utxosPayinFixed, recvXbtAddr, utxoReservationManager_,
+               , authAddrVerifCache_, reply.authAddr, reply.utxosPayinFixed, recvXbtAddr, utxoReservationManager_,
                std::move(reply.walletPurpose), std::move(reply.utxoRes), expandTxInfo);
 
             connect(settlContainer.get(), &DealerXBTSettlementContainer::sendUnsignedPayinToPB, this, &RFQReplyWidget::sendUnsignedPayinToPB);
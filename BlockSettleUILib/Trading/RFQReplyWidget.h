@@ -40,6 +40,7 @@ namespace bs {
    }
    class SettlementAddressEntry;
    class SecurityStatsCollector;
+   class AuthAddressVerificationCache;
    class UTXOReservationManager;
 }
 class ApplicationSettings;
@@ -169,6 +170,7 @@ private:
    std::shared_ptr<BaseCelerClient>       celerClient_;
    std::shared_ptr<QuoteProvider>         quoteProvider_;
    std::shared_ptr<AuthAddressManager>    authAddressManager_;
+   std::shared_ptr<bs::AuthAddressVerificationCache> authAddrVerifCache_;
    std::shared_ptr<AssetManager>          assetManager_;
    std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
    std::shared_ptr<DialogManager>         dialogManager_;
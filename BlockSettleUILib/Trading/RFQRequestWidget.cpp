@@ -15,6 +15,7 @@
 
 #include "ApplicationSettings.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "AutoSignQuoteProvider.h"
 #include "CelerClient.h"
 #include "CurrencyPair.h"
@@ -225,6 +226,8 @@ void RFQRequestWidget::init(const std::shared_ptr<spdlog::logger> &logger
    armory_ = armory;
    autoSignProvider_ = autoSignProvider;
    utxoReservationManager_ = utxoReservationManager;
+   authAddrVerifCache_ = std::make_shared<bs::AuthAddressVerificationCache>(logger
+      , armory, authAddressManager);
 
    if (walletsManager_) {
       autoSignProvider_->scriptRunner()->setWalletsManager(walletsManager_);
@@ -299,7 +302,7 @@ void RFQRequestWidget::onRFQSubmit(const std::string &id, const bs::network::RFQ
    }
 
    RFQDialog* dialog = new RFQDialog(logger_, id, rfq, quoteProvider_
-      , authAddressManager_, assetManager_, walletsManager_, signingContainer_
+      , authAddressManager_, authAddrVerifCache_, assetManager_, walletsManager_, signingContainer_
       , armory_, celerClient_, appSettings_, rfqStorage_, xbtWallet
       , ui_->pageRFQTicket->recvXbtAddressIfSet(), authAddr, utxoReservationManager_
       , fixedXbtInputs.inputs, std::move(fixedXbtInputs.utxoRes)
@@ -30,6 +30,7 @@ namespace bs {
    namespace sync {
       class WalletsManager;
    }
+   class AuthAddressVerificationCache;
    class UTXOReservationManager;
 }
 
@@ -144,6 +145,7 @@ private:
    std::shared_ptr<QuoteProvider>      quoteProvider_;
    std::shared_ptr<AssetManager>       assetManager_;
    std::shared_ptr<AuthAddressManager> authAddressManager_;
+   std::shared_ptr<bs::AuthAddressVerificationCache> authAddrVerifCache_;
    std::shared_ptr<DialogManager>      dialogManager_;
 
    std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
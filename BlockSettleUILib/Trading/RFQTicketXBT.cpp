@@ -811,55 +811,69 @@ void RFQTicketXBT::sendRFQ(const std::string &id)
          const auto &recvXbtAddressCb = [this, id, rfq, ccWallet]
             (const bs::Address &recvXbtAddr)
          {
-            rfq->receiptAddress = recvXbtAddr.display();
-            const uint64_t spendVal = rfq->quantity * assetManager_->getCCLotSize(rfq->product);
-            if (!ccWallet) {
-               SPDLOG_LOGGER_ERROR(logger_, "ccWallet is not set");
-               return;
-            }
+            // Address could be delivered from another thread
+            QMetaObject::invokeMethod(this, [this, id, rfq, ccWallet, recvXbtAddr] {
+               rfq->receiptAddress = recvXbtAddr.display();
+               const uint64_t spendVal = rfq->quantity * assetManager_->getCCLotSize(rfq->product);
+               if (!ccWallet) {
+                  SPDLOG_LOGGER_ERROR(logger_, "ccWallet is not set");
+                  return;
+               }
+
+               // Spendable CC inputs are cached (and filtered from reserved ones)
+               // by UTXOReservationManager, so no Armory request is needed here
+               const auto ccInputs = utxoReservationManager_->getBestCCUtxoSet(ccWallet->walletId(), spendVal);
+               uint64_t inputVal = 0;
+               for (const auto &input : ccInputs) {
+                  inputVal += input.getValue();
+               }
+               if (inputVal < spendVal) {
+                  // This should not normally happen!
+                  SPDLOG_LOGGER_ERROR(logger_, "insufficient input amount: {}, expected: {}, requestId: {}", inputVal, spendVal, rfq->requestId);
+                  BSMessageBox(BSMessageBox::critical, tr("RFQ not sent")
+                     , tr("Insufficient input amount")).exec();
+                  return;
+               }
 
-            const auto ccInputsCb = [this, id, spendVal, rfq, ccWallet]
-               (const std::vector<UTXO> &ccInputs) mutable
-            {
-               QMetaObject::invokeMethod(this, [this, id, spendVal, rfq, ccInputs, ccWallet] {
-                  uint64_t inputVal = 0;
-                  for (const auto &input : ccInputs) {
-                     inputVal += input.getValue();
+               // Inputs are reserved right away, so they are not selected again
+               // while the change address is being obtained
+               const auto reservation = std::make_shared<bs::UtxoReservationToken>(
+                  utxoReservationManager_->makeNewReservation(ccInputs, rfq->requestId));
+
+               const auto cbAddr = [this, spendVal, id, rfq, ccInputs, ccWallet, reservation](const bs::Address &addr)
+               {
+                  try {
+                     const auto txReq = ccWallet->createPartialTXRequest(spendVal, ccInputs, addr);
+                     rfq->coinTxInput = BinaryData::fromString(txReq.serializeState().SerializeAsString()).toHexStr();
+                     submitRFQCb_(id, *rfq, std::move(*reservation));
                   }
-                  if (inputVal < spendVal) {
-                     // This should not normally happen!
-                     SPDLOG_LOGGER_ERROR(logger_, "insufficient input amount: {}, expected: {}, requestId: {}", inputVal, spendVal, rfq->requestId);
-                     BSMessageBox(BSMessageBox::critical, tr("RFQ not sent")
-                        , tr("Insufficient input amount")).exec();
+                  catch (const std::exception &e) {
+                     reservation->release();
+                     BSMessageBox(BSMessageBox::critical, tr("RFQ Failure")
+                        , QString::fromLatin1(e.what()), this).exec();
                      return;
                   }
-
-                  const auto cbAddr = [this, spendVal, id, rfq, ccInputs, ccWallet](const bs::Address &addr)
+               };
+               if (inputVal == spendVal) {
+                  cbAddr({});
+               }
+               else {
+                  ccWallet->getNewChangeAddress([this, cbAddr, reservation, requestId = rfq->requestId]
+                     (const bs::Address &changeAddr)
                   {
-                     try {
-                        const auto txReq = ccWallet->createPartialTXRequest(spendVal, ccInputs, addr);
-                        rfq->coinTxInput = BinaryData::fromString(txReq.serializeState().SerializeAsString()).toHexStr();
-                        auto reservationToken = utxoReservationManager_->makeNewReservation(txReq.inputs, rfq->requestId);
-                        submitRFQCb_(id, *rfq, std::move(reservationToken));
-                     }
-                     catch (const std::exception &e) {
-                        BSMessageBox(BSMessageBox::critical, tr("RFQ Failure")
-                           , QString::fromLatin1(e.what()), this).exec();
-                        return;
-                     }
-                  };
-                  if (inputVal == spendVal) {
-                     cbAddr({});
-                  }
-                  else {
-                     ccWallet->getNewChangeAddress(cbAddr);
-                  }
-               });
-            };
-            bool result = ccWallet->getSpendableTxOutList(ccInputsCb, spendVal, true);
-            if (!result) {
-               SPDLOG_LOGGER_ERROR(logger_, "can't spendable TX list");
-            }
+                     QMetaObject::invokeMethod(this, [this, cbAddr, reservation, requestId, changeAddr] {
+                        if (!changeAddr.isValid()) {
+                           SPDLOG_LOGGER_ERROR(logger_, "failed to get change address, requestId: {}", requestId);
+                           reservation->release();
+                           BSMessageBox(BSMessageBox::critical, tr("RFQ not sent")
+                              , tr("Failed to get change address")).exec();
+                           return;
+                        }
+                        cbAddr(changeAddr);
+                     });
+                  });
+               }
+            });
          };
 
          auto recvXbtAddrIfSet = recvXbtAddressIfSet();
@@ -1052,6 +1066,19 @@ RFQTicketXBT::ProductGroupType RFQTicketXBT::getProductGroupType(const QString&
    return ProductGroupType::GroupNotSelected;
 }
 
+void RFQTicketXBT::setMaxXbtAmount(const std::vector<UTXO> &utxos, float feePerByteArmory)
+{
+   const auto feePerByte = std::max(feePerByteArmory, utxoReservationManager_->feeRatePb());
+   uint64_t total = 0;
+   for (const auto &utxo : utxos) {
+      total += utxo.getValue();
+   }
+   const uint64_t fee = bs::tradeutils::estimatePayinFeeWithoutChange(utxos, feePerByte);
+   const double spendableQuantity = std::max(0.0, (total - fee) / BTCNumericTypes::BalanceDivider);
+   ui_->lineEditAmount->setText(UiUtils::displayAmount(spendableQuantity));
+   updateSubmitButton();
+}
+
 void RFQTicketXBT::onMaxClicked()
 {
    auto balanceInfo = getBalanceInfo();
@@ -1083,18 +1110,16 @@ void RFQTicketXBT::onMaxClicked()
             }
          }
 
+         const float cachedFeePerByte = utxoReservationManager_->estimatedFeePb();
+         if (cachedFeePerByte > 0) {
+            setMaxXbtAmount(utxos, cachedFeePerByte);
+            return;
+         }
+
+         // Fee estimate is not cached yet (right after start-up)
          auto feeCb = [this, utxos = std::move(utxos)](float fee) {
             QMetaObject::invokeMethod(this, [this, fee, utxos = std::move(utxos)]{
-               float feePerByteArmory = ArmoryConnection::toFeePerByte(fee);
-               auto feePerByte = std::max(feePerByteArmory, utxoReservationManager_->feeRatePb());
-               uint64_t total = 0;
-               for (const auto &utxo : utxos) {
-                  total += utxo.getValue();
-               }
-               const uint64_t fee = bs::tradeutils::estimatePayinFeeWithoutChange(utxos, feePerByte);
-               const double spendableQuantity = std::max(0.0, (total - fee) / BTCNumericTypes::BalanceDivider);
-               ui_->lineEditAmount->setText(UiUtils::displayAmount(spendableQuantity));
-               updateSubmitButton();
+               setMaxXbtAmount(utxos, ArmoryConnection::toFeePerByte(fee));
                });
          };
          armory_->estimateFee(bs::tradeutils::feeTargetBlockCount(), feeCb);
@@ -217,6 +217,8 @@ private:
    void reserveBestUtxoSetAndSubmit(const std::string &id
       , const std::shared_ptr<bs::network::RFQ>& rfq);
 
+   void setMaxXbtAmount(const std::vector<UTXO> &utxos, float feePerByteArmory);
+
 private:
    std::unique_ptr<Ui::RFQTicketXBT> ui_;
 
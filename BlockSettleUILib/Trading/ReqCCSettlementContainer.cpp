@@ -13,6 +13,7 @@
 #include "AssetManager.h"
 #include "CheckRecipSigner.h"
 #include "SignContainer.h"
+#include "TraceProfiler.h"
 #include "TradesUtils.h"
 #include "TransactionData.h"
 #include "Wallets/SyncHDWallet.h"
@@ -132,6 +133,7 @@ bs::sync::PasswordDialogData ReqCCSettlementContainer::toPasswordDialogData(QDat
 
 void ReqCCSettlementContainer::activate()
 {
+   BS_TRACE_FUNCTION();
    if (side() == bs::network::Side::Buy) {
       double balance = 0;
       for (const auto &leaf : xbtWallet_->getGroup(xbtWallet_->getXBTGroupType())->getLeaves()) {
@@ -205,6 +207,7 @@ void ReqCCSettlementContainer::deactivate()
 // KLUDGE currently this code not just making unsigned TX, but also initiate signing
 bool ReqCCSettlementContainer::createCCUnsignedTXdata()
 {
+   BS_TRACE_FUNCTION();
    if (side() == bs::network::Side::Sell) {
       const uint64_t spendVal = quantity() * assetMgr_->getCCLotSize(product());
       logger_->debug("[{}] sell amount={}, spend value = {}", __func__, quantity(), spendVal);
@@ -313,6 +316,7 @@ void ReqCCSettlementContainer::AcceptQuote()
 
 bool ReqCCSettlementContainer::startSigning(QDateTime timestamp)
 {
+   BS_TRACE_FUNCTION();
    const auto &cbTx = [this, handle = validityFlag_.handle(), logger=logger_](bs::error::ErrorCode result, const BinaryData &signedTX) {
       if (!handle.isValid()) {
          logger->warn("[ReqCCSettlementContainer::onTXSigned] failed to sign TX half, already destroyed");
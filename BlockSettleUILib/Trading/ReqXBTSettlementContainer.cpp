@@ -16,10 +16,12 @@
 
 #include "AssetManager.h"
 #include "AuthAddressManager.h"
+#include "AuthAddressVerificationCache.h"
 #include "CheckRecipSigner.h"
 #include "CurrencyPair.h"
 #include "QuoteProvider.h"
 #include "WalletSignerContainer.h"
+#include "TraceProfiler.h"
 #include "TradesUtils.h"
 #include "UiUtils.h"
 #include "Wallets/SyncHDWallet.h"
@@ -34,6 +36,7 @@ Q_DECLARE_METATYPE(AddressVerificationState)
 
 ReqXBTSettlementContainer::ReqXBTSettlementContainer(const std::shared_ptr<spdlog::logger> &logger
    , const std::shared_ptr<AuthAddressManager> &authAddrMgr
+   , const std::shared_ptr<bs::AuthAddressVerificationCache> &authAddrVerifCache
    , const std::shared_ptr<WalletSignerContainer> &signContainer
    , const std::shared_ptr<ArmoryConnection> &armory
    , const std::shared_ptr<bs::sync::hd::Wallet> &xbtWallet
@@ -50,6 +53,7 @@ ReqXBTSettlementContainer::ReqXBTSettlementContainer(const std::shared_ptr<spdlo
    : bs::SettlementContainer(std::move(utxoRes), std::move(walletPurpose), expandTxDialogInfo)
    , logger_(logger)
    , authAddrMgr_(authAddrMgr)
+   , authAddrVerifCache_(authAddrVerifCache)
    , walletsMgr_(walletsMgr)
    , signContainer_(signContainer)
    , armory_(armory)
@@ -86,6 +90,7 @@ ReqXBTSettlementContainer::~ReqXBTSettlementContainer() = default;
 
 void ReqXBTSettlementContainer::acceptSpotXBT()
 {
+   BS_TRACE_FUNCTION();
    emit acceptQuote(rfq_.requestId, "not used");
 }
 
@@ -110,24 +115,11 @@ void ReqXBTSettlementContainer::onTimerExpired()
 
 void ReqXBTSettlementContainer::activate()
 {
+   BS_TRACE_FUNCTION();
    startTimer(kWaitTimeoutInSec);
 
    settlementIdHex_ = quote_.settlementId;
 
-   addrVerificator_ = std::make_shared<AddressVerificator>(logger_, armory_
-      , [this, handle = validityFlag_.handle()](const bs::Address &address, AddressVerificationState state)
-   {
-      QMetaObject::invokeMethod(qApp, [this, handle, address, state] {
-         if (!handle.isValid()) {
-            return;
-         }
-         dealerAuthAddress_ = address;
-         dealerVerifStateChanged(state);
-      });
-   });
-
-   addrVerificator_->SetBSAddressList(authAddrMgr_->GetBSAddresses());
-
    settlementId_ = BinaryData::CreateFromHex(quote_.settlementId);
    userKey_ = BinaryData::CreateFromHex(quote_.requestorAuthPublicKey);
    dealerAuthKey_ = BinaryData::CreateFromHex(quote_.dealerAuthPublicKey);
@@ -218,6 +210,7 @@ void ReqXBTSettlementContainer::cancelWithError(const QString& errorMessage, bs:
 void ReqXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signedTX
    , bs::error::ErrorCode errCode, std::string errTxt)
 {
+   BS_TRACE_FUNCTION();
    if ((payoutSignId_ != 0) && (payoutSignId_ == id)) {
       payoutSignId_ = 0;
 
@@ -297,6 +290,7 @@ void ReqXBTSettlementContainer::onTXSigned(unsigned int id, BinaryData signedTX
 
 void ReqXBTSettlementContainer::onUnsignedPayinRequested(const std::string& settlementId)
 {
+   BS_TRACE_FUNCTION();
    if (settlementIdHex_ != settlementId) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid id : {} . {} expected", settlementId, settlementIdHex_);
       return;
@@ -357,8 +351,15 @@ void ReqXBTSettlementContainer::onUnsignedPayinRequested(const std::string& sett
          }
 
          const auto dealerAddrSW = bs::Address::fromPubKey(dealerAuthKey_, AddressEntryType_P2WPKH);
-         addrVerificator_->addAddress(dealerAddrSW);
-         addrVerificator_->startAddressVerification();
+         authAddrVerifCache_->verify(dealerAddrSW, [this, handle]
+            (const bs::Address &address, AddressVerificationState state)
+         {
+            if (!handle.isValid()) {
+               return;
+            }
+            dealerAuthAddress_ = address;
+            dealerVerifStateChanged(state);
+         });
 
          unsignedPayinRequest_ = std::move(result.signRequest);
 
@@ -382,6 +383,7 @@ void ReqXBTSettlementContainer::onUnsignedPayinRequested(const std::string& sett
 
 void ReqXBTSettlementContainer::onSignedPayoutRequested(const std::string& settlementId, const BinaryData& payinHash, QDateTime timestamp)
 {
+   BS_TRACE_FUNCTION();
    if (settlementIdHex_ != settlementId) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid id : {} . {} expected", settlementId, settlementIdHex_);
       return;
@@ -442,6 +444,7 @@ void ReqXBTSettlementContainer::onSignedPayoutRequested(const std::string& settl
 
 void ReqXBTSettlementContainer::onSignedPayinRequested(const std::string& settlementId, const BinaryData& unsignedPayin, QDateTime timestamp)
 {
+   BS_TRACE_FUNCTION();
    if (settlementIdHex_ != settlementId) {
       SPDLOG_LOGGER_ERROR(logger_, "invalid id : {} . {} expected", settlementId, settlementIdHex_);
       return;
@@ -28,9 +28,9 @@ namespace bs {
    namespace tradeutils {
       struct Args;
    }
+   class AuthAddressVerificationCache;
    class UTXOReservationManager;
 }
-class AddressVerificator;
 class ArmoryConnection;
 class AuthAddressManager;
 class WalletSignerContainer;
@@ -43,6 +43,7 @@ class ReqXBTSettlementContainer : public bs::SettlementContainer
 public:
    ReqXBTSettlementContainer(const std::shared_ptr<spdlog::logger> &
       , const std::shared_ptr<AuthAddressManager> &
+      , const std::shared_ptr<bs::AuthAddressVerificationCache> &
       , const std::shared_ptr<WalletSignerContainer> &
       , const std::shared_ptr<ArmoryConnection> &
       , const std::shared_ptr<bs::sync::hd::Wallet> &xbtWallet
@@ -102,6 +103,7 @@ private:
 
    std::shared_ptr<spdlog::logger>           logger_;
    std::shared_ptr<AuthAddressManager>       authAddrMgr_;
+   std::shared_ptr<bs::AuthAddressVerificationCache> authAddrVerifCache_;
    std::shared_ptr<bs::sync::WalletsManager> walletsMgr_;
    std::shared_ptr<WalletSignerContainer>    signContainer_;
    std::shared_ptr<ArmoryConnection>         armory_;
@@ -112,8 +114,6 @@ private:
    bs::network::Quote         quote_;
    bs::Address                settlAddr_;
 
-   std::shared_ptr<AddressVerificator>             addrVerificator_;
-
    double            amount_{};
    std::string       fxProd_;
    BinaryData        settlementId_;
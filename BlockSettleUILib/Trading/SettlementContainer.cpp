@@ -11,6 +11,9 @@
 #include "SettlementContainer.h"
 #include "UiUtils.h"
 
+#include <algorithm>
+#include <QTimer>
+
 using namespace bs;
 using namespace bs::sync;
 
@@ -30,6 +33,7 @@ SettlementContainer::SettlementContainer(UtxoReservationToken utxoRes,
 
 SettlementContainer::~SettlementContainer()
 {
+   cancelDeadline();
    if (utxoRes_.isValid()) {
       QTimer::singleShot(kUtxoReleaseDelay, [utxoRes = std::move(utxoRes_)] () mutable {
          utxoRes.release();
@@ -70,35 +74,45 @@ sync::PasswordDialogData SettlementContainer::toPayOutTxDetailsPasswordDialogDat
    return dialogData;
 }
 
+int SettlementContainer::timeLeftMs() const
+{
+   if (!deadlineId_) {
+      return 0;
+   }
+   const auto timeLeft = std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline_ - std::chrono::steady_clock::now());
+   return std::max(0, static_cast<int>(timeLeft.count()));
+}
+
 void SettlementContainer::startTimer(const unsigned int durationSeconds)
 {
-   timer_.stop();
-   timer_.setInterval(250);
+   cancelDeadline();
    msDuration_ = durationSeconds * 1000;
-   startTime_ = std::chrono::steady_clock::now();
-
-   connect(&timer_, &QTimer::timeout, [this] {
-      const auto timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime_);
-      msTimeLeft_ = msDuration_ - timeDiff.count();
-      if (msTimeLeft_ < 0) {
-         timer_.stop();
-         msDuration_ = 0;
-         msTimeLeft_ = 0;
-         emit timerExpired();
-      }
+   deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(msDuration_);
+
+   deadlineId_ = DeadlineScheduler::instance().schedule(deadline_, [this] {
+      deadlineId_ = 0;
+      msDuration_ = 0;
+      emit timerExpired();
    });
-   timer_.start();
    emit timerStarted(msDuration_);
 }
 
 void SettlementContainer::stopTimer()
 {
    msDuration_ = 0;
-   msTimeLeft_ = 0;
-   timer_.stop();
+   cancelDeadline();
    emit timerStopped();
 }
 
+void SettlementContainer::cancelDeadline()
+{
+   if (deadlineId_) {
+      DeadlineScheduler::instance().cancel(deadlineId_);
+      deadlineId_ = 0;
+   }
+}
+
 void SettlementContainer::releaseUtxoRes()
 {
    utxoRes_.release();
@@ -14,11 +14,11 @@
 #include <chrono>
 #include <string>
 #include <QObject>
-#include <QTimer>
 
 #include "ArmoryConnection.h"
 #include "CommonTypes.h"
 #include "CoreWallet.h"
+#include "DeadlineScheduler.h"
 #include "EncryptionUtils.h"
 #include "PasswordDialogData.h"
 #include "UtxoReservationToken.h"
@@ -51,7 +51,8 @@ namespace bs {
       virtual double amount() const = 0;
 
       int durationMs() const { return msDuration_; }
-      int timeLeftMs() const { return msTimeLeft_; }
+      // Computed on demand, expiry is reported by timerExpired signal
+      int timeLeftMs() const;
 
       virtual bs::sync::PasswordDialogData toPasswordDialogData(QDateTime timestamp) const;
       virtual bs::sync::PasswordDialogData toPayOutTxDetailsPasswordDialogData(bs::core::wallet::TXSignRequest payOutReq
@@ -82,10 +83,12 @@ namespace bs {
       bool expandTxDialogInfo_{};
 
    private:
-      QTimer   timer_;
+      void cancelDeadline();
+
+   private:
       int      msDuration_ = 0;
-      int      msTimeLeft_ = 0;
-      std::chrono::steady_clock::time_point startTime_;
+      DeadlineScheduler::Id   deadlineId_{};
+      std::chrono::steady_clock::time_point deadline_;
    };
 
 }  // namespace bs
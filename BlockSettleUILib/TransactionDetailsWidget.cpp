@@ -13,6 +13,7 @@
 #include "BTCNumericTypes.h"
 #include "BlockObj.h"
 #include "CheckRecipSigner.h"
+#include "TxCache.h"
 #include "UiUtils.h"
 #include "Wallets/SyncWallet.h"
 #include "Wallets/SyncWalletsManager.h"
@@ -98,7 +99,7 @@ void TransactionDetailsWidget::populateTransactionWidget(const TxHash &rpcTXID
             logger_->error("[TransactionDetailsWidget::populateTransactionWidget] Armory is not inited");
             return;
          }
-         if (!armoryPtr_->getTxByHash(rpcTXID, cbTX, false)) {
+         if (!bs::TxCache::instance().getTxByHash(armoryPtr_.get(), rpcTXID, cbTX, false)) {
             if (logger_) {
                logger_->error("[TransactionDetailsWidget::populateTransactionWidget]"
                   " failed to get TXID {}", txidStr);
@@ -173,7 +174,7 @@ void TransactionDetailsWidget::processTxData(const Tx &tx)
       setTxGUIValues();
    }
    else {
-      armoryPtr_->getTXsByHash(prevTxHashSet, cbProcessTX, false);
+      bs::TxCache::instance().getTXsByHash(armoryPtr_.get(), prevTxHashSet, cbProcessTX, false);
    }
 }
 
@@ -12,6 +12,8 @@
 
 #include "ArmoryConnection.h"
 #include "CheckRecipSigner.h"
+#include "TraceProfiler.h"
+#include "TxCache.h"
 #include "UiUtils.h"
 #include "Wallets/SyncWalletsManager.h"
 
@@ -310,6 +312,7 @@ void TransactionsViewModel::onNewBlock(unsigned int, unsigned int)
 
 void TransactionsViewModel::loadAllWallets(bool onNewBlock)
 {
+   BS_TRACE_FUNCTION();
    const auto &cbWalletsLD = [this, onNewBlock](const std::shared_ptr<AsyncClient::LedgerDelegate> &delegate) {
       if (!initialLoadCompleted_) {
          if (onNewBlock && logger_) {
@@ -577,6 +580,7 @@ void TransactionsViewModel::onZCReceived(const std::string& requestId, const std
 
 void TransactionsViewModel::onZCInvalidated(const std::set<BinaryData> &ids)
 {
+   BS_TRACE_FUNCTION();
    std::vector<int> delRows;
 #ifdef TX_MODEL_NESTED_NODES
    std::vector<bs::TXEntry> children;
@@ -648,6 +652,7 @@ static bool isChildOf(TransactionPtr child, TransactionPtr parent)
 
 std::pair<size_t, size_t> TransactionsViewModel::updateTransactionsPage(const std::vector<bs::TXEntry> &page)
 {
+   BS_TRACE_FUNCTION();
    struct ItemKey {
       BinaryData  txHash;
       std::set<std::string>   walletIds;
@@ -814,6 +819,7 @@ std::pair<size_t, size_t> TransactionsViewModel::updateTransactionsPage(const st
 
 void TransactionsViewModel::updateBlockHeight(const std::vector<std::shared_ptr<TransactionsViewItem>> &updItems)
 {
+   BS_TRACE_FUNCTION();
    if (!rootNode_->hasChildren()) {
       logger_->debug("[{}] root node doesn't have children", __func__);
       return;
@@ -885,6 +891,7 @@ void TransactionsViewModel::onRefreshTxValidity()
 
 void TransactionsViewModel::loadLedgerEntries(bool onNewBlock)
 {
+   BS_TRACE_FUNCTION();
    if (!initialLoadCompleted_ || !ledgerDelegate_) {
       if (onNewBlock && logger_) {
          logger_->debug("[TransactionsViewModel::loadLedgerEntries] previous loading is not complete/started");
@@ -922,6 +929,7 @@ void TransactionsViewModel::loadLedgerEntries(bool onNewBlock)
 
             const auto &cbLedger = [thisPtr, onNewBlock, pageId, inPageCnt, rawData, logger, rawDataMutex]
                (ReturnMessage<std::vector<ClientClasses::LedgerEntry>> entries)->void {
+               BS_TRACE_SCOPE("TransactionsViewModel::loadLedgerEntries::cbLedger");
                try {
                   auto le = entries.get();
 
@@ -967,6 +975,7 @@ void TransactionsViewModel::loadLedgerEntries(bool onNewBlock)
 void TransactionsViewModel::ledgerToTxData(const std::map<int, std::vector<bs::TXEntry>> &rawData
    , bool onNewBlock)
 {
+   BS_TRACE_FUNCTION();
    int pageCnt = 0;
 
    signalOnEndLoading_ = true;
@@ -979,6 +988,7 @@ void TransactionsViewModel::ledgerToTxData(const std::map<int, std::vector<bs::T
 
 void TransactionsViewModel::onNewItems(const std::vector<TXNode *> &newItems)
 {
+   BS_TRACE_FUNCTION();
    const int curLastIdx = rootNode_->nbChildren();
 
    // That is less expensive just to compare first two list are the same - O(n)
@@ -1019,6 +1029,7 @@ void TransactionsViewModel::onNewItems(const std::vector<TXNode *> &newItems)
 
 void TransactionsViewModel::onDelRows(std::vector<int> rows)
 {        // optimize for contiguous ranges, if needed
+   BS_TRACE_FUNCTION();
    std::sort(rows.begin(), rows.end());
    int rowCnt = rowCount();
    QMutexLocker locker(&updateMutex_);
@@ -1186,7 +1197,7 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
             item->txHashesReceived = true;
          }
          else {
-            if (!armory->getTXsByHash(txHashSet, cbTXs, true)) {
+            if (!bs::TxCache::instance().getTXsByHash(armory, txHashSet, cbTXs)) {
                userCB(nullptr);
             }
          }
@@ -1213,7 +1224,7 @@ void TransactionsViewItem::initialize(const TransactionPtr &item, ArmoryConnecti
       if (item->tx.isInitialized()) {
          cbTX(item->tx);
       } else {
-         if (!armory->getTxByHash(item->txEntry.txHash, cbTX, true)) {
+         if (!bs::TxCache::instance().getTxByHash(armory, item->txEntry.txHash, cbTX)) {
             userCB(nullptr);
          }
       }
@@ -0,0 +1,226 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include "TxCache.h"
+
+#include <stdexcept>
+
+namespace {
+   // Explorer browsing of busy addresses is the main consumer - keep enough
+   // TXs to cover a few of them together with their previous TXs
+   const size_t kMaxCachedTxs = 20000;
+
+   bool isConfirmed(const bs::TxCache::TxPtr &tx)
+   {
+      return (tx && tx->isInitialized() && (tx->getTxHeight() != UINT32_MAX));
+   }
+}
+
+using namespace bs;
+
+TxCache &TxCache::instance()
+{
+   static TxCache cache;
+   return cache;
+}
+
+bool TxCache::getTXsByHash(ArmoryConnection *armory
+   , const std::set<BinaryData> &hashes, const TxBatchCb &cb, bool allowCached)
+{
+   if (!armory) {
+      return false;
+   }
+   if (!allowCached) {
+      const auto cbFresh = [this, cb](const AsyncClient::TxBatchResult &txs, std::exception_ptr exPtr)
+      {
+         putConfirmed(txs);
+         if (cb) {
+            cb(txs, exPtr);
+         }
+      };
+      return armory->getTXsByHash(hashes, cbFresh, false);
+   }
+   auto request = std::make_shared<Request>();
+   request->cb = cb;
+   std::set<BinaryData> toFetch;
+   bool allCached = false;
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto &hash : hashes) {
+         const auto entry = find(hash);
+         if (entry) {
+            request->result[hash] = entry->tx;
+            continue;
+         }
+         auto &waiters = pending_[hash];
+         if (waiters.empty()) {
+            toFetch.insert(hash);
+         }
+         waiters.push_back(request);
+         request->nbPending++;
+      }
+      allCached = (request->nbPending == 0);
+   }
+
+   if (allCached) {
+      if (cb) {
+         cb(request->result, nullptr);
+      }
+      return true;
+   }
+   if (toFetch.empty()) {
+      return true;   // all missing TXs are being fetched by other requests
+   }
+
+   const auto cbTXs = [this, toFetch](const AsyncClient::TxBatchResult &txs, std::exception_ptr exPtr)
+   {
+      onTXs(toFetch, txs, exPtr);
+   };
+   if (!armory->getTXsByHash(toFetch, cbTXs, true)) {
+      // Failure is reported to the caller by return value only, other
+      // requests waiting for the same TXs get the error through their callbacks
+      request->cb = nullptr;
+      onTXs(toFetch, {}, std::make_exception_ptr(std::runtime_error("failed to request TXs")));
+      return false;
+   }
+   return true;
+}
+
+bool TxCache::getTxByHash(ArmoryConnection *armory
+   , const BinaryData &hash, const TxCb &cb, bool allowCached)
+{
+   const auto cbTXs = [hash, cb](const AsyncClient::TxBatchResult &txs, std::exception_ptr)
+   {
+      if (!cb) {
+         return;
+      }
+      const auto it = txs.find(hash);
+      if ((it == txs.end()) || !it->second) {
+         cb(Tx{});
+         return;
+      }
+      cb(*it->second);
+   };
+   return getTXsByHash(armory, { hash }, cbTXs, allowCached);
+}
+
+void TxCache::onTXs(const std::set<BinaryData> &requested
+   , const AsyncClient::TxBatchResult &txs, std::exception_ptr exPtr)
+{
+   std::vector<std::shared_ptr<Request>> completed;
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto &hash : requested) {
+         TxPtr tx;
+         const auto itTx = txs.find(hash);
+         if (itTx != txs.end()) {
+            tx = itTx->second;
+         }
+         if (isConfirmed(tx)) {
+            put(hash, tx);
+         }
+
+         const auto itPending = pending_.find(hash);
+         if (itPending == pending_.end()) {
+            continue;
+         }
+         for (const auto &request : itPending->second) {
+            if (tx) {
+               request->result[hash] = tx;
+            }
+            if (--request->nbPending == 0) {
+               completed.push_back(request);
+            }
+         }
+         pending_.erase(itPending);
+      }
+   }
+
+   for (const auto &request : completed) {
+      if (request->cb) {
+         request->cb(request->result, exPtr);
+      }
+   }
+}
+
+void TxCache::putConfirmed(const AsyncClient::TxBatchResult &txs)
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   for (const auto &tx : txs) {
+      if (isConfirmed(tx.second)) {
+         put(tx.first, tx.second);
+      }
+   }
+}
+
+void TxCache::put(const BinaryData &hash, const TxPtr &tx)
+{
+   auto itEntry = entries_.find(hash);
+   if (itEntry != entries_.end()) {
+      itEntry->second.tx = tx;
+      lru_.splice(lru_.begin(), lru_, itEntry->second.lruIt);
+      return;
+   }
+
+   lru_.push_front(hash);
+   Entry entry;
+   entry.tx = tx;
+   entry.lruIt = lru_.begin();
+   entries_.emplace(hash, std::move(entry));
+
+   while (entries_.size() > kMaxCachedTxs) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+   }
+}
+
+TxCache::Entry *TxCache::find(const BinaryData &hash)
+{
+   const auto itEntry = entries_.find(hash);
+   if (itEntry == entries_.end()) {
+      return nullptr;
+   }
+   lru_.splice(lru_.begin(), lru_, itEntry->second.lruIt);
+   return &itEntry->second;
+}
+
+void TxCache::setInputsValue(const BinaryData &hash, uint64_t value)
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   const auto entry = find(hash);
+   if (entry) {
+      entry->hasInputsValue = true;
+      entry->inputsValue = value;
+   }
+}
+
+bool TxCache::getInputsValue(const BinaryData &hash, uint64_t &value)
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   const auto entry = find(hash);
+   if (!entry || !entry->hasInputsValue) {
+      return false;
+   }
+   value = entry->inputsValue;
+   return true;
+}
+
+size_t TxCache::size() const
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   return entries_.size();
+}
+
+void TxCache::clear()
+{
+   std::lock_guard<std::mutex> lock(mutex_);
+   entries_.clear();
+   lru_.clear();
+}
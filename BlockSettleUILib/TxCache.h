@@ -0,0 +1,94 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#ifndef TX_CACHE_H
+#define TX_CACHE_H
+
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "ArmoryConnection.h"
+
+namespace bs {
+
+   // Process-wide size-bounded LRU cache of deserialized TXs keyed by hash.
+   // Only confirmed TXs are stored as they never change (unconfirmed ones
+   // still get their height updated by Armory). Concurrent requests for the
+   // same hash are collapsed into a single Armory call.
+   class TxCache
+   {
+   public:
+      using TxPtr = AsyncClient::TxBatchResult::mapped_type;
+      using TxBatchCb = std::function<void(const AsyncClient::TxBatchResult &, std::exception_ptr)>;
+      using TxCb = std::function<void(const Tx &)>;
+
+      static TxCache &instance();
+
+      TxCache(const TxCache &) = delete;
+      TxCache &operator=(const TxCache &) = delete;
+      TxCache(TxCache &&) = delete;
+      TxCache &operator=(TxCache &&) = delete;
+
+      // Same semantics as ArmoryConnection::getTXsByHash/getTxByHash: if false
+      // is returned, the callback is not invoked. Callback is invoked
+      // synchronously if all TXs are already cached. With allowCached unset
+      // all TXs are fetched from Armory (bypassing its cache too) and only
+      // stored here.
+      bool getTXsByHash(ArmoryConnection *
+         , const std::set<BinaryData> &hashes, const TxBatchCb &, bool allowCached = true);
+      bool getTxByHash(ArmoryConnection *
+         , const BinaryData &hash, const TxCb &, bool allowCached = true);
+
+      // Sum of values spent by TX inputs (resolved from previous TXs).
+      // Stored only for TXs that are already in the cache.
+      void setInputsValue(const BinaryData &hash, uint64_t value);
+      bool getInputsValue(const BinaryData &hash, uint64_t &value);
+
+      size_t size() const;
+      void clear();
+
+   private:
+      TxCache() = default;
+
+      struct Request
+      {
+         AsyncClient::TxBatchResult result;
+         size_t   nbPending{ 0 };
+         TxBatchCb   cb;
+      };
+
+      struct Entry
+      {
+         TxPtr    tx;
+         bool     hasInputsValue{ false };
+         uint64_t inputsValue{ 0 };
+         std::list<BinaryData>::iterator lruIt;
+      };
+
+      void onTXs(const std::set<BinaryData> &requested, const AsyncClient::TxBatchResult &
+         , std::exception_ptr);
+      void putConfirmed(const AsyncClient::TxBatchResult &);
+      void put(const BinaryData &hash, const TxPtr &);
+      Entry *find(const BinaryData &hash);
+
+   private:
+      mutable std::mutex   mutex_;
+      std::map<BinaryData, Entry>   entries_;
+      std::list<BinaryData>         lru_;    // most recently used first
+      std::map<BinaryData, std::vector<std::shared_ptr<Request>>>   pending_;
+   };
+
+} // namespace bs
+
+#endif // TX_CACHE_H
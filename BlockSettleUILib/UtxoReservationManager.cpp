@@ -38,6 +38,10 @@ UTXOReservationManager::UTXOReservationManager(const std::shared_ptr<bs::sync::W
       this, &UTXOReservationManager::onWalletsDeleted);
    connect(walletsManager_.get(), &bs::sync::WalletsManager::walletBalanceUpdated,
       this, &UTXOReservationManager::onWalletsBalanceChanged);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::invalidatedZCs,
+      this, &UTXOReservationManager::refreshAvailableUTXO, Qt::QueuedConnection);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::blockchainEvent,
+      this, &UTXOReservationManager::refreshFeeEstimate, Qt::QueuedConnection);
 }
 
 UTXOReservationManager::~UTXOReservationManager() = default;
@@ -186,6 +190,16 @@ std::vector<UTXO> bs::UTXOReservationManager::getAvailableCCUTXOs(const CCWallet
    return utxos;
 }
 
+std::vector<UTXO> bs::UTXOReservationManager::getBestCCUtxoSet(const CCWalletId& walletId
+   , BTCNumericTypes::satoshi_type quantity) const
+{
+   const auto utxos = getAvailableCCUTXOs(walletId);
+   if (utxos.empty()) {
+      return {};
+   }
+   return bs::selectUtxoForAmount(utxos, quantity);
+}
+
 bs::FixedXbtInputs UTXOReservationManager::convertUtxoToFixedInput(const HDWalletId& walletId, const std::vector<UTXO>& utxos)
 {
    FixedXbtInputs fixedXbtInputs;
@@ -220,12 +234,41 @@ float UTXOReservationManager::feeRatePb() const
    return feeRatePb_.load();
 }
 
+float UTXOReservationManager::estimatedFeePb() const
+{
+   return estimatedFeePb_.load();
+}
+
 void bs::UTXOReservationManager::refreshAvailableUTXO()
 {
    availableXbtUTXOs_.clear();
    for (auto &wallet : walletsManager_->hdWallets()) {
       resetHdWallet(wallet->walletId());
    }
+   if (estimatedFeePb_.load() <= 0) {
+      refreshFeeEstimate();
+   }
+}
+
+void bs::UTXOReservationManager::refreshFeeEstimate()
+{
+   if (!armory_) {
+      return;
+   }
+   armory_->estimateFee(bs::tradeutils::feeTargetBlockCount()
+      , [this, handle = validityFlag_.handle()](float fee) mutable {
+      const float feePerByte = ArmoryConnection::toFeePerByte(fee);
+      if (feePerByte <= 0) {
+         return;
+      }
+      ValidityGuard lock(handle);
+      if (!handle.isValid()) {
+         return;
+      }
+      QMetaObject::invokeMethod(this, [this, feePerByte] {
+         estimatedFeePb_.store(feePerByte);
+      });
+   });
 }
 
 void bs::UTXOReservationManager::onWalletsDeleted(const std::string& walledId)
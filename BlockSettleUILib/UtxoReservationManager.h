@@ -16,6 +16,7 @@
 #include "CommonTypes.h"
 #include "UiUtils.h"
 #include "UtxoReservationToken.h"
+#include "ValidityFlag.h"
 
 namespace spdlog {
    class logger;
@@ -78,6 +79,8 @@ namespace bs {
       // CC specific implementation
       BTCNumericTypes::balance_type getAvailableCCUtxoSum(const CCProductName& CCProduct) const;
       std::vector<UTXO> getAvailableCCUTXOs(const CCWalletId& walletId) const;
+      // Selected from cached spendable inputs, no Armory round-trip
+      std::vector<UTXO> getBestCCUtxoSet(const CCWalletId& walletId, BTCNumericTypes::satoshi_type quantity) const;
 
       // Mutual functions
       FixedXbtInputs convertUtxoToFixedInput(const HDWalletId& walletId, const std::vector<UTXO>& utxos);
@@ -86,11 +89,15 @@ namespace bs {
       void setFeeRatePb(float feeRate);
       float feeRatePb() const;
 
+      // Last Armory fee estimate for trade fee target (refreshed on new blocks), 0 if not received yet
+      float estimatedFeePb() const;
+
    signals:
       void availableUtxoChanged(const std::string& walledId);
 
    private slots:
       void refreshAvailableUTXO();
+      void refreshFeeEstimate();
       void onWalletsDeleted(const std::string& walledId);
       void onWalletsAdded(const std::string& walledId);
       void onWalletsBalanceChanged(const std::string& walledId);
@@ -121,6 +128,9 @@ namespace bs {
       std::shared_ptr<spdlog::logger> logger_;
 
       std::atomic<float> feeRatePb_{};
+      std::atomic<float> estimatedFeePb_{};
+
+      ValidityFlag validityFlag_;
    };
 
 }  // namespace bs
@@ -10,6 +10,7 @@
 */
 #include "WalletsViewModel.h"
 
+#include <algorithm>
 #include <QFont>
 #include <QTreeView>
 #include <QSortFilterProxyModel>
@@ -27,6 +28,17 @@ void WalletNode::clear()
    children_.clear();
 }
 
+void WalletNode::removeChild(int index)
+{
+   if ((index >= nbChildren()) || (index < 0)) {
+      return;
+   }
+   delete children_.takeAt(index);
+   for (int i = index; i < nbChildren(); ++i) {
+      children_[i]->row_ = i;
+   }
+}
+
 WalletNode *WalletNode::child(int index) const
 {
    return ((index >= nbChildren()) || (index < 0)) ? nullptr : children_[index];
@@ -133,6 +145,26 @@ public:
    size_t getNbUsedAddresses() const { return nbAddr_; }
    std::shared_ptr<bs::sync::hd::Wallet> hdWallet() const override { return hdWallet_; }
 
+   bool setInfo(const std::string &name, const std::string &desc) {
+      if ((name == name_) && (desc == desc_)) {
+         return false;
+      }
+      name_ = name;
+      desc_ = desc;
+      return true;
+   }
+
+   // Aggregates are recalculated only for the node whose child has changed
+   void recalcCounters() {
+      balTotal_ = 0;
+      balUnconf_ = 0;
+      balSpend_ = 0;
+      nbAddr_ = 0;
+      for (const auto &child : qAsConst(children_)) {
+         updateCounters(static_cast<WalletRootNode *>(child));
+      }
+   }
+
 protected:
    std::string desc_;
    std::atomic<BTCNumericTypes::balance_type> balTotal_, balUnconf_, balSpend_;
@@ -213,19 +245,33 @@ public:
          , 0, 0, 0, wallet->getUsedAddressCount())
       , wallet_(wallet)
    {
-      wallet->onBalanceAvailable([this, wallet, handle = validityFlag_.handle()]() mutable {
+      wallet->onBalanceAvailable([vm, walletId = wallet->walletId(), handle = validityFlag_.handle()]() mutable {
          ValidityGuard lock(handle);
          if (!handle.isValid()) {
             return;
          }
-         balTotal_ = wallet->getTotalBalance();
-         balUnconf_ = wallet->getUnconfirmedBalance();
-         balSpend_ = wallet->getSpendableBalance();
+         QMetaObject::invokeMethod(vm, [vm, walletId] { vm->updateLeaf(walletId); });
       });
    }
 
    std::vector<std::shared_ptr<bs::sync::Wallet>> wallets() const override { return {wallet_}; }
 
+   // Return true if any displayed value has changed
+   bool refresh() {
+      const auto balTotal = wallet_->getTotalBalance();
+      const auto balUnconf = wallet_->getUnconfirmedBalance();
+      const auto balSpend = wallet_->getSpendableBalance();
+      const auto nbAddr = wallet_->getUsedAddressCount();
+      bool changed = setInfo(wallet_->shortName(), wallet_->description());
+      changed |= (balTotal != balTotal_) || (balUnconf != balUnconf_)
+         || (balSpend != balSpend_) || (nbAddr != nbAddr_);
+      balTotal_ = balTotal;
+      balUnconf_ = balUnconf;
+      balSpend_ = balSpend;
+      nbAddr_ = nbAddr;
+      return changed;
+   }
+
    std::string id() const override {
       return wallet_->walletId();
    }
@@ -262,9 +308,14 @@ public:
 
    std::vector<std::shared_ptr<bs::sync::Wallet>> wallets() const override { return wallets_; }
 
+   bool isVisible(const std::shared_ptr<bs::sync::hd::Leaf> &leaf) const {
+      return !viewModel_->showRegularWallets()
+         || ((leaf->type() == bs::core::wallet::Type::Bitcoin) && (leaf->purpose() != bs::hd::Purpose::NonSegWit));
+   }
+
    void addLeaves(const std::vector<std::shared_ptr<bs::sync::hd::Leaf>> &leaves) {
       for (const auto &leaf : leaves) {
-         if (viewModel_->showRegularWallets() && (leaf->type() != bs::core::wallet::Type::Bitcoin || leaf->purpose() == bs::hd::Purpose::NonSegWit)) {
+         if (!isVisible(leaf)) {
             continue;
          }
          const auto leafNode = new WalletLeafNode(viewModel_, leaf, hdWallet_, nbChildren(), this);
@@ -273,12 +324,35 @@ public:
          wallets_.push_back(leaf);
       }
    }
+
+   void removeLeaf(int row) {
+      const auto node = child(row);
+      if (node == nullptr) {
+         return;
+      }
+      const auto walletId = node->id();
+      wallets_.erase(std::remove_if(wallets_.begin(), wallets_.end()
+         , [walletId](const std::shared_ptr<bs::sync::Wallet> &wallet) {
+         return (wallet->walletId() == walletId);
+      }), wallets_.end());
+      removeChild(row);
+      recalcCounters();
+   }
 };
 
+static bool isGroupVisible(const std::shared_ptr<bs::sync::hd::Group> &group, bool showRegularWallets)
+{
+   // don't display Settlement
+   if (group->type() == bs::core::wallet::Type::Settlement) {
+      return false;
+   }
+   return !showRegularWallets || (group->type() == bs::core::wallet::Type::Bitcoin);
+}
+
 void WalletRootNode::addGroups(const std::vector<std::shared_ptr<bs::sync::hd::Group>> &groups)
 {
    for (const auto &group : groups) {
-      if (viewModel_->showRegularWallets() && (group->type() != bs::core::wallet::Type::Bitcoin)) {
+      if (!isGroupVisible(group, viewModel_->showRegularWallets())) {
          continue;
       }
       const auto groupNode = new WalletGroupNode(viewModel_, hdWallet_, group->name(), group->description()
@@ -299,19 +373,19 @@ WalletsViewModel::WalletsViewModel(const std::shared_ptr<bs::sync::WalletsManage
    , showRegularWallets_(showOnlyRegular)
 {
    rootNode_ = std::make_shared<WalletNode>(this, WalletNode::Type::Root);
-   connect(walletsManager_.get(), &bs::sync::WalletsManager::walletsReady, this, &WalletsViewModel::onWalletChanged);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::walletsReady, this, &WalletsViewModel::onWalletsReady);
    connect(walletsManager_.get(), &bs::sync::WalletsManager::walletChanged, this, &WalletsViewModel::onWalletChanged);
-   connect(walletsManager_.get(), &bs::sync::WalletsManager::walletDeleted, this, &WalletsViewModel::onWalletChanged);
-   connect(walletsManager_.get(), &bs::sync::WalletsManager::blockchainEvent, this, &WalletsViewModel::onWalletChanged);
-   connect(walletsManager_.get(), &bs::sync::WalletsManager::invalidatedZCs, this, &WalletsViewModel::onWalletChanged);
-   connect(walletsManager_.get(), &bs::sync::WalletsManager::walletBalanceUpdated, this, &WalletsViewModel::onWalletChanged);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::walletDeleted, this, &WalletsViewModel::onWalletDeleted);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::blockchainEvent, this, &WalletsViewModel::onBalancesChanged);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::invalidatedZCs, this, &WalletsViewModel::onBalancesChanged);
+   connect(walletsManager_.get(), &bs::sync::WalletsManager::walletBalanceUpdated, this, &WalletsViewModel::onWalletBalanceUpdated);
    connect(walletsManager_.get(), &bs::sync::WalletsManager::newWalletAdded, this, &WalletsViewModel::onNewWalletAdded);
 
    if (signContainer_) {
       connect(signContainer_.get(), &SignContainer::QWalletInfo, this, &WalletsViewModel::onWalletInfo);
       connect(signContainer_.get(), &SignContainer::Error, this, &WalletsViewModel::onHDWalletError);
       connect(signContainer_.get(), &SignContainer::authenticated, this, &WalletsViewModel::onSignerAuthenticated);
-      connect(signContainer_.get(), &SignContainer::ready, this, &WalletsViewModel::onWalletChanged);
+      connect(signContainer_.get(), &SignContainer::ready, this, &WalletsViewModel::onSignerReady);
    }
 }
 
@@ -571,37 +645,7 @@ void WalletsViewModel::LoadWallets(bool keepSelection)
       if (!hdWallet) {
          continue;
       }
-      const auto hdNode = new WalletRootNode(this, hdWallet, hdWallet->name(), hdWallet->description()
-         , getHDWalletType(hdWallet, walletsManager_), rootNode_->nbChildren(), rootNode_.get());
-      rootNode_->add(hdNode);
-
-      // filter groups
-      // don't display Settlement
-      auto groups = hdWallet->getGroups();
-      std::vector<std::shared_ptr<bs::sync::hd::Group>> filteredGroups;
-
-      std::copy_if(groups.begin(), groups.end(), std::back_inserter(filteredGroups),
-         [](const std::shared_ptr<bs::sync::hd::Group>& item)
-         { return item->type() != bs::core::wallet::Type::Settlement; }
-      );
-
-      hdNode->addGroups(filteredGroups);
-      if (signContainer_) {
-         if (signContainer_->isOffline()) {
-            hdNode->setState(WalletNode::State::Offline);
-         }
-         else if (hdWallet->isHardwareWallet()) {
-            hdNode->setState(WalletNode::State::Hardware);
-         }
-         else if (signContainer_->isWalletOffline(hdWallet->walletId())) {
-            hdNode->setState(WalletNode::State::Offline);
-         }
-         else if (hdWallet->isPrimary()) {
-            hdNode->setState(WalletNode::State::Primary);
-         } else {
-            hdNode->setState(WalletNode::State::Full);
-         }
-      }
+      addHdNode(hdWallet);
    }
 
 /*   const auto stmtWallet = walletsManager_->getSettlementWallet();
@@ -641,7 +685,276 @@ void WalletsViewModel::LoadWallets(bool keepSelection)
    emit updateAddresses();
 }
 
-void WalletsViewModel::onWalletChanged()
+void WalletsViewModel::addHdNode(const std::shared_ptr<bs::sync::hd::Wallet> &hdWallet)
+{
+   const auto hdNode = new WalletRootNode(this, hdWallet, hdWallet->name(), hdWallet->description()
+      , getHDWalletType(hdWallet, walletsManager_), rootNode_->nbChildren(), rootNode_.get());
+   rootNode_->add(hdNode);
+   hdNode->addGroups(hdWallet->getGroups());
+   setSignerState(hdNode, hdWallet);
+}
+
+void WalletsViewModel::setSignerState(WalletNode *hdNode
+   , const std::shared_ptr<bs::sync::hd::Wallet> &hdWallet)
+{
+   if (!signContainer_) {
+      return;
+   }
+   if (signContainer_->isOffline()) {
+      hdNode->setState(WalletNode::State::Offline);
+   }
+   else if (hdWallet->isHardwareWallet()) {
+      hdNode->setState(WalletNode::State::Hardware);
+   }
+   else if (signContainer_->isWalletOffline(hdWallet->walletId())) {
+      hdNode->setState(WalletNode::State::Offline);
+   }
+   else if (hdWallet->isPrimary()) {
+      hdNode->setState(WalletNode::State::Primary);
+   } else {
+      hdNode->setState(WalletNode::State::Full);
+   }
+}
+
+QModelIndex WalletsViewModel::nodeIndex(WalletNode *node, int column) const
+{
+   if ((node == nullptr) || (node == rootNode_.get())) {
+      return QModelIndex();
+   }
+   return createIndex(node->row(), column, static_cast<void*>(node));
+}
+
+void WalletsViewModel::emitRowChanged(WalletNode *node)
+{
+   emit dataChanged(nodeIndex(node, 0), nodeIndex(node, columnCount() - 1));
+}
+
+WalletRootNode *WalletsViewModel::findHdNode(const std::string &walletId) const
+{
+   for (int i = 0; i < rootNode_->nbChildren(); i++) {
+      auto hdNode = rootNode_->child(i);
+      if (hdNode->id() == walletId) {
+         return static_cast<WalletRootNode *>(hdNode);
+      }
+   }
+   return nullptr;
+}
+
+bool WalletsViewModel::updateWallets()
+{
+   std::unordered_set<std::string> hdWalletIds;
+   for (const auto &hdWallet : walletsManager_->hdWallets()) {
+      if (hdWallet) {
+         hdWalletIds.insert(hdWallet->walletId());
+      }
+   }
+
+   bool changed = false;
+   for (int i = rootNode_->nbChildren() - 1; i >= 0; i--) {
+      if (hdWalletIds.find(rootNode_->child(i)->id()) == hdWalletIds.end()) {
+         beginRemoveRows(QModelIndex(), i, i);
+         rootNode_->removeChild(i);
+         endRemoveRows();
+         changed = true;
+      }
+   }
+
+   for (const auto &hdWallet : walletsManager_->hdWallets()) {
+      if (!hdWallet) {
+         continue;
+      }
+      const auto hdNode = findHdNode(hdWallet->walletId());
+      if (hdNode == nullptr) {
+         const int row = rootNode_->nbChildren();
+         beginInsertRows(QModelIndex(), row, row);
+         addHdNode(hdWallet);
+         endInsertRows();
+         changed = true;
+         continue;
+      }
+      if (hdNode->setInfo(hdWallet->name(), hdWallet->description())) {
+         emitRowChanged(hdNode);
+      }
+      changed |= updateGroups(hdNode, hdWallet);
+   }
+   return changed;
+}
+
+bool WalletsViewModel::updateGroups(WalletRootNode *hdNode
+   , const std::shared_ptr<bs::sync::hd::Wallet> &hdWallet)
+{
+   std::vector<std::shared_ptr<bs::sync::hd::Group>> groups;
+   for (const auto &group : hdWallet->getGroups()) {
+      if (isGroupVisible(group, showRegularWallets_)) {
+         groups.push_back(group);
+      }
+   }
+   const auto hdIndex = nodeIndex(hdNode);
+
+   bool changed = false;
+   for (int i = hdNode->nbChildren() - 1; i >= 0; i--) {
+      const auto &name = hdNode->child(i)->name();
+      const auto itGroup = std::find_if(groups.cbegin(), groups.cend()
+         , [name](const std::shared_ptr<bs::sync::hd::Group> &group) {
+         return (group->name() == name);
+      });
+      if (itGroup == groups.cend()) {
+         beginRemoveRows(hdIndex, i, i);
+         hdNode->removeChild(i);
+         endRemoveRows();
+         changed = true;
+      }
+   }
+
+   for (const auto &group : groups) {
+      WalletGroupNode *groupNode = nullptr;
+      for (int i = 0; i < hdNode->nbChildren(); i++) {
+         if (hdNode->child(i)->name() == group->name()) {
+            groupNode = static_cast<WalletGroupNode *>(hdNode->child(i));
+            break;
+         }
+      }
+      if (groupNode == nullptr) {
+         const int row = hdNode->nbChildren();
+         beginInsertRows(hdIndex, row, row);
+         hdNode->addGroups({ group });
+         hdNode->child(row)->setState(hdNode->state());
+         endInsertRows();
+         changed = true;
+         continue;
+      }
+      changed |= updateLeaves(groupNode, group->getLeaves());
+   }
+   return changed;
+}
+
+bool WalletsViewModel::updateLeaves(WalletGroupNode *groupNode
+   , const std::vector<std::shared_ptr<bs::sync::hd::Leaf>> &leaves)
+{
+   std::vector<std::shared_ptr<bs::sync::hd::Leaf>> visibleLeaves;
+   for (const auto &leaf : leaves) {
+      if (groupNode->isVisible(leaf)) {
+         visibleLeaves.push_back(leaf);
+      }
+   }
+   const auto groupIndex = nodeIndex(groupNode);
+
+   bool changed = false;
+   for (int i = groupNode->nbChildren() - 1; i >= 0; i--) {
+      const auto walletId = groupNode->child(i)->id();
+      const auto itLeaf = std::find_if(visibleLeaves.cbegin(), visibleLeaves.cend()
+         , [walletId](const std::shared_ptr<bs::sync::hd::Leaf> &leaf) {
+         return (leaf->walletId() == walletId);
+      });
+      if (itLeaf == visibleLeaves.cend()) {
+         beginRemoveRows(groupIndex, i, i);
+         groupNode->removeLeaf(i);
+         endRemoveRows();
+         changed = true;
+      }
+   }
+
+   for (const auto &leaf : visibleLeaves) {
+      if (groupNode->findByWalletId(leaf->walletId()) != nullptr) {
+         continue;
+      }
+      const int row = groupNode->nbChildren();
+      beginInsertRows(groupIndex, row, row);
+      groupNode->addLeaves({ leaf });
+      groupNode->child(row)->setState(groupNode->parent()->state());
+      endInsertRows();
+      changed = true;
+   }
+
+   if (changed) {
+      emitRowChanged(groupNode);
+   }
+   return changed;
+}
+
+void WalletsViewModel::updateLeaf(const std::string &walletId)
+{
+   const auto node = rootNode_->findByWalletId(walletId);
+   if (node == nullptr) {
+      return;
+   }
+   const auto leafNode = static_cast<WalletLeafNode *>(node);
+   if (!leafNode->refresh()) {
+      return;
+   }
+   emitRowChanged(leafNode);
+
+   const auto groupNode = static_cast<WalletRootNode *>(leafNode->parent());
+   groupNode->recalcCounters();
+   emitRowChanged(groupNode);
+}
+
+void WalletsViewModel::onWalletsReady()
 {
    LoadWallets(true);
 }
+
+void WalletsViewModel::onWalletChanged(const std::string &walletId)
+{
+   if (updateWallets()) {
+      emit updateAddresses();
+   }
+   updateLeaf(walletId);
+}
+
+void WalletsViewModel::onWalletDeleted(const std::string &)
+{
+   if (updateWallets()) {
+      emit updateAddresses();
+   }
+}
+
+void WalletsViewModel::onWalletBalanceUpdated(const std::string &walletId)
+{
+   updateLeaf(walletId);
+}
+
+void WalletsViewModel::onBalancesChanged()
+{
+   for (int i = 0; i < rootNode_->nbChildren(); i++) {
+      const auto hdNode = rootNode_->child(i);
+      for (int j = 0; j < hdNode->nbChildren(); j++) {
+         const auto groupNode = static_cast<WalletRootNode *>(hdNode->child(j));
+         bool changed = false;
+         for (int k = 0; k < groupNode->nbChildren(); k++) {
+            const auto leafNode = static_cast<WalletLeafNode *>(groupNode->child(k));
+            if (leafNode->refresh()) {
+               emitRowChanged(leafNode);
+               changed = true;
+            }
+         }
+         if (changed) {
+            groupNode->recalcCounters();
+            emitRowChanged(groupNode);
+         }
+      }
+   }
+}
+
+void WalletsViewModel::onSignerReady()
+{
+   if (updateWallets()) {
+      emit updateAddresses();
+   }
+   for (int i = 0; i < rootNode_->nbChildren(); i++) {
+      const auto hdNode = rootNode_->child(i);
+      const auto hdWallet = hdNode->hdWallet();
+      if (!hdWallet) {
+         continue;
+      }
+      setSignerState(hdNode, hdWallet);
+      emitRowChanged(hdNode);
+      for (int j = 0; j < hdNode->nbChildren(); j++) {
+         const auto groupNode = hdNode->child(j);
+         if (groupNode->hasChildren()) {
+            emit dataChanged(nodeIndex(groupNode->child(0))
+               , nodeIndex(groupNode->child(groupNode->nbChildren() - 1), columnCount() - 1));
+         }
+      }
+   }
+}
@@ -23,6 +23,7 @@
 namespace bs {
    namespace sync {
       namespace hd {
+         class Leaf;
          class Wallet;
       }
       class Wallet;
@@ -31,6 +32,8 @@ namespace bs {
 }
 class SignContainer;
 class WalletsViewModel;
+class WalletRootNode;
+class WalletGroupNode;
 
 
 class WalletNode
@@ -65,6 +68,7 @@ public:
    virtual std::string id() const { return {}; }
 
    void add(WalletNode *child) { children_.append(child); }
+   void removeChild(int index);
    void clear();
    int nbChildren() const { return children_.count(); }
    bool hasChildren() const { return !children_.empty(); }
@@ -129,7 +133,12 @@ signals:
    void updateAddresses();
 
 private slots:
-   void onWalletChanged();
+   void onWalletsReady();
+   void onWalletChanged(const std::string &walletId);
+   void onWalletDeleted(const std::string &walletId);
+   void onWalletBalanceUpdated(const std::string &walletId);
+   void onBalancesChanged();
+   void onSignerReady();
    void onNewWalletAdded(const std::string &walletId);
    void onWalletInfo(unsigned int id, bs::hd::WalletInfo);
    void onHDWalletError(unsigned int id, std::string err);
@@ -159,6 +168,22 @@ public:
       ColumnCount
    };
 
+private:
+   friend class WalletLeafNode;
+
+   QModelIndex nodeIndex(WalletNode *, int column = 0) const;
+   void emitRowChanged(WalletNode *);
+   WalletRootNode *findHdNode(const std::string &walletId) const;
+   void addHdNode(const std::shared_ptr<bs::sync::hd::Wallet> &);
+   void setSignerState(WalletNode *hdNode, const std::shared_ptr<bs::sync::hd::Wallet> &);
+
+   // Apply differences between walletsManager_ and current nodes as row
+   // inserts/removals. Return true if tree structure has changed.
+   bool updateWallets();
+   bool updateGroups(WalletRootNode *hdNode, const std::shared_ptr<bs::sync::hd::Wallet> &);
+   bool updateLeaves(WalletGroupNode *groupNode, const std::vector<std::shared_ptr<bs::sync::hd::Leaf>> &);
+   void updateLeaf(const std::string &walletId);
+
 private:
    std::shared_ptr<bs::sync::WalletsManager> walletsManager_;
    std::shared_ptr<SignContainer>   signContainer_;
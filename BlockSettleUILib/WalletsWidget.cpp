@@ -56,13 +56,10 @@ public:
 
    bool filterAcceptsRow(int source_row, const QModelIndex & source_parent) const override
    {
-      const int txCount = sourceModel()->data(sourceModel()->index(
-         source_row, AddressListModel::ColumnTxCount, source_parent)).toInt();
-      const double balance = QLocale().toDouble(sourceModel()->data(sourceModel()->index(
-         source_row, AddressListModel::ColumnBalance, source_parent)).toString());
-      const bool isExternal = sourceModel()->data(sourceModel()->index(
-            source_row, AddressListModel::ColumnAddress, source_parent),
-         AddressListModel::IsExternalRole).toBool();
+      const auto index = sourceModel()->index(source_row, AddressListModel::ColumnAddress, source_parent);
+      const int txCount = sourceModel()->data(index, AddressListModel::TxCountRole).toInt();
+      const double balance = sourceModel()->data(index, AddressListModel::BalanceRole).toDouble();
+      const bool isExternal = sourceModel()->data(index, AddressListModel::IsExternalRole).toBool();
 
       if (filterMode_ & HideInternal) {
          if (txCount == 0 && qFuzzyIsNull(balance) && !isExternal) {
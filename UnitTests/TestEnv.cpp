@@ -9,6 +9,8 @@
 
 */
 #include <atomic>
+#include <thread>
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QStandardPaths>
@@ -379,3 +381,16 @@ bs::Address randomAddressPKH()
    auto addr = bs::Address::fromPubKey(pubkey, AddressEntryType_P2PKH);
    return addr;
 }
+
+bool waitFor(const std::function<bool()> &pred, std::chrono::milliseconds timeout)
+{
+   const auto deadline = std::chrono::steady_clock::now() + timeout;
+   while (!pred()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+         return false;
+      }
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+   return true;
+}
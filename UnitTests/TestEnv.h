@@ -11,6 +11,8 @@
 #ifndef __TEST_ENV_H__
 #define __TEST_ENV_H__
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <gtest/gtest.h>
@@ -471,4 +473,11 @@ private:
 
 bs::Address randomAddressPKH();
 
+const auto kWaitTimeout = std::chrono::seconds(30);
+
+// Processes Qt events until predicate becomes true as many callbacks are
+// delivered through the main thread. Returns false on timeout.
+bool waitFor(const std::function<bool()> &pred
+   , std::chrono::milliseconds timeout = kWaitTimeout);
+
 #endif // __TEST_ENV_H__
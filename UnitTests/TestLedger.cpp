@@ -0,0 +1,277 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+
+#include "BIP32_Node.h"
+#include "CoreWallet.h"
+#include "TestEnv.h"
+#include "ledger/ledgerCache.h"
+#include "ledger/ledgerDevice.h"
+#include "ledger/ledgerTransport.h"
+
+namespace {
+
+   const auto kSeed = SecureBinaryData::fromString("ledger test seed");
+   const auto kOtherSeed = SecureBinaryData::fromString("other ledger test seed");
+   const uint64_t kPrevTxValue = 100000;
+
+   // Replays recorded APDU exchanges instead of talking to HID device.
+   // Commands without recorded response are answered by instruction code
+   // if default response is set for it, otherwise SW_UNKNOWN is returned.
+   class LedgerReplayTransport : public LedgerTransport
+   {
+   public:
+      LedgerReplayTransport(const std::map<QByteArray, QByteArray> &exchanges
+         , const std::map<uint8_t, QByteArray> &defaultResponses)
+         : exchanges_(exchanges), defaultResponses_(defaultResponses)
+      {}
+
+      bool open() override { return true; }
+      void close() override {}
+
+      int send(const QByteArray &command) override
+      {
+         lastCommand_ = command;
+         ++nbCommands_[static_cast<uint8_t>(command.at(1))];
+         return command.size();
+      }
+
+      uint16_t receive(QByteArray &response) override
+      {
+         const auto it = exchanges_.find(lastCommand_);
+         if (it != exchanges_.end()) {
+            response = it->second;
+            return Ledger::SW_OK;
+         }
+         const auto itDefault = defaultResponses_.find(static_cast<uint8_t>(lastCommand_.at(1)));
+         if (itDefault != defaultResponses_.end()) {
+            response = itDefault->second;
+            return Ledger::SW_OK;
+         }
+         ++nbMisses_;
+         response.clear();
+         return Ledger::SW_UNKNOWN;
+      }
+
+      unsigned nbCommands(uint8_t ins) const
+      {
+         const auto it = nbCommands_.find(ins);
+         return (it == nbCommands_.end()) ? 0 : it->second;
+      }
+      unsigned nbMisses() const { return nbMisses_; }
+
+   private:
+      const std::map<QByteArray, QByteArray> exchanges_;
+      const std::map<uint8_t, QByteArray>    defaultResponses_;
+      QByteArray  lastCommand_;
+      std::map<uint8_t, unsigned>   nbCommands_;
+      unsigned    nbMisses_{};
+   };
+
+   BIP32_Node deriveNode(const bs::hd::Path &path, const SecureBinaryData &seed = kSeed)
+   {
+      BIP32_Node node;
+      node.initFromSeed(seed);
+      for (const auto el : path) {
+         node.derivePrivate(el);
+      }
+      return node;
+   }
+
+   // Records GET_WALLET_PUBLIC_KEY exchange for the path and its parent
+   // as the device with given seed would answer it
+   void recordPublicKey(std::map<QByteArray, QByteArray> &exchanges, const bs::hd::Path &path
+      , const SecureBinaryData &seed = kSeed)
+   {
+      if (path.length() > 1) {
+         auto parentPath = path;
+         parentPath.pop();
+         recordPublicKey(exchanges, parentPath, seed);
+      }
+
+      QByteArray command;
+      command.append(static_cast<char>(Ledger::CLA));
+      command.append(static_cast<char>(Ledger::INS_GET_WALLET_PUBLIC_KEY));
+      command.append(static_cast<char>(0));
+      command.append(static_cast<char>(0));
+      QByteArray payload;
+      payload.append(static_cast<char>(path.length()));
+      for (const auto el : path) {
+         writeUintBE(payload, el);
+      }
+      command.append(static_cast<char>(payload.size()));
+      command.append(payload);
+
+      const auto node = deriveNode(path, seed);
+      const auto pubKey = CryptoECDSA().UncompressPoint(node.getPublicKey());
+      const QByteArray address("mockaddress");
+      QByteArray response;
+      response.append(static_cast<char>(pubKey.getSize()));
+      response.append(pubKey.toCharPtr(), static_cast<int>(pubKey.getSize()));
+      response.append(static_cast<char>(address.size()));
+      response.append(address);
+      response.append(node.getChaincode().toCharPtr(), static_cast<int>(node.getChaincode().getSize()));
+      exchanges[command] = response;
+   }
+
+   QByteArray randomBytes(size_t size)
+   {
+      const auto data = CryptoPRNG::generateRandom(size);
+      return QByteArray(data.toCharPtr(), static_cast<int>(data.getSize()));
+   }
+
+} // namespace
+
+TEST(TestLedger, PublicKeyCache)
+{
+   auto &cache = LedgerPublicKeyCache::instance();
+   cache.clear();
+
+   const auto &recordDevice = [](const SecureBinaryData &seed) {
+      std::map<QByteArray, QByteArray> exchanges;
+      recordPublicKey(exchanges, bs::hd::Path({ bs::hd::hardFlag }), seed);
+      for (const auto purpose : { bs::hd::Nested, bs::hd::Native, bs::hd::NonSegWit }) {
+         recordPublicKey(exchanges, getDerivationPath(true, purpose), seed);
+      }
+      return exchanges;
+   };
+   auto exchanges = recordDevice(kSeed);
+
+   const auto &getPublicKey = [&exchanges](unsigned &nbApdu) {
+      auto transport = std::make_unique<LedgerReplayTransport>(exchanges, std::map<uint8_t, QByteArray>{});
+      const auto transportPtr = transport.get();
+      LedgerCommandThread thread(HidDeviceInfo{}, true, StaticLogger::loggerPtr);
+      thread.setTransport(std::move(transport));
+
+      HwWalletWrapper result;
+      QObject::connect(&thread, &LedgerCommandThread::resultReady, [&result](QVariant value) {
+         result = value.value<HwWalletWrapper>();
+      });
+      thread.prepareGetPublicKey({});
+      const auto start = std::chrono::steady_clock::now();
+      thread.run();
+      const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+         std::chrono::steady_clock::now() - start);
+
+      EXPECT_EQ(transportPtr->nbMisses(), 0);
+      nbApdu = thread.apduCount();
+      StaticLogger::loggerPtr->info("[TestLedger] get public key: {} APDU exchanges, {} us"
+         , nbApdu, elapsed.count());
+      return result;
+   };
+
+   unsigned nbApduCold = 0;
+   auto walletCold = getPublicKey(nbApduCold);
+   ASSERT_TRUE(walletCold.isValid());
+   // root key, then xpub and its parent for each of three purposes
+   EXPECT_EQ(nbApduCold, 7);
+
+   unsigned nbApduWarm = 0;
+   auto walletWarm = getPublicKey(nbApduWarm);
+   ASSERT_TRUE(walletWarm.isValid());
+   // root key is always requested to identify the device
+   EXPECT_EQ(nbApduWarm, 1);
+
+   EXPECT_EQ(walletCold.info_.xpubRoot, walletWarm.info_.xpubRoot);
+   EXPECT_EQ(walletCold.info_.xpubNestedSegwit, walletWarm.info_.xpubNestedSegwit);
+   EXPECT_EQ(walletCold.info_.xpubNativeSegwit, walletWarm.info_.xpubNativeSegwit);
+   EXPECT_EQ(walletCold.info_.xpubLegacy, walletWarm.info_.xpubLegacy);
+
+   // other device must not be served from cache
+   exchanges = recordDevice(kOtherSeed);
+   unsigned nbApduOther = 0;
+   const auto walletOther = getPublicKey(nbApduOther);
+   EXPECT_EQ(nbApduOther, 7);
+   EXPECT_NE(walletOther.info_.xpubNativeSegwit, walletCold.info_.xpubNativeSegwit);
+
+   cache.clear();
+}
+
+TEST(TestLedger, TrustedInputCache)
+{
+   LedgerPublicKeyCache::instance().clear();
+
+   auto inputPath = getDerivationPath(true, bs::hd::NonSegWit);
+   inputPath.append(bs::hd::Path::fromString("0/0"));
+   const auto inputNode = deriveNode(inputPath);
+   const auto inputScript = BtcUtils::getP2PKHScript(BtcUtils::getHash160(inputNode.getPublicKey()));
+
+   // supporting TX with our output
+   BinaryWriter bwTx;
+   bwTx.put_uint32_t(1);
+   bwTx.put_var_int(1);
+   bwTx.put_BinaryData(CryptoPRNG::generateRandom(32));
+   bwTx.put_uint32_t(0);
+   bwTx.put_var_int(0);
+   bwTx.put_uint32_t(UINT32_MAX);
+   bwTx.put_var_int(1);
+   bwTx.put_uint64_t(kPrevTxValue);
+   bwTx.put_var_int(inputScript.getSize());
+   bwTx.put_BinaryData(inputScript);
+   bwTx.put_uint32_t(0);
+   const auto rawPrevTx = bwTx.getData();
+   const Tx prevTx(rawPrevTx);
+
+   bs::core::wallet::TXSignRequest txReq;
+   txReq.inputs.push_back(UTXO(kPrevTxValue, UINT32_MAX, 0, 0, prevTx.getThisHash(), inputScript));
+   txReq.supportingTXs[prevTx.getThisHash()] = rawPrevTx;
+   txReq.recipients.push_back(randomAddressPKH().getRecipient(bs::XBTAmount{ kPrevTxValue / 2 }));
+
+   std::map<QByteArray, QByteArray> exchanges;
+   recordPublicKey(exchanges, bs::hd::Path({ bs::hd::hardFlag }));
+   recordPublicKey(exchanges, inputPath);
+   auto signature = randomBytes(71);
+   signature[0] = 0x30;
+   const std::map<uint8_t, QByteArray> defaultResponses = {
+      { Ledger::INS_GET_TRUSTED_INPUT, randomBytes(56) },
+      { Ledger::INS_HASH_INPUT_START, {} },
+      { Ledger::INS_HASH_INPUT_FINALIZE_FULL, {} },
+      { Ledger::INS_HASH_SIGN, signature }
+   };
+
+   const auto trustedInputCache = std::make_shared<LedgerTrustedInputCache>();
+   const auto &signTx = [&](unsigned &nbApdu, unsigned &nbTrustedInputApdu) {
+      auto transport = std::make_unique<LedgerReplayTransport>(exchanges, defaultResponses);
+      const auto transportPtr = transport.get();
+      LedgerCommandThread thread(HidDeviceInfo{}, true, StaticLogger::loggerPtr);
+      thread.setTransport(std::move(transport));
+      thread.setTrustedInputCache(trustedInputCache);
+
+      bool signedOk = false;
+      QObject::connect(&thread, &LedgerCommandThread::resultReady, [&signedOk](QVariant value) {
+         signedOk = !value.value<HWSignedTx>().signedTx.empty();
+      });
+      thread.prepareSignTx({}, txReq, { inputPath }, {});
+      thread.run();
+
+      EXPECT_EQ(transportPtr->nbMisses(), 0);
+      nbApdu = thread.apduCount();
+      nbTrustedInputApdu = transportPtr->nbCommands(Ledger::INS_GET_TRUSTED_INPUT);
+      StaticLogger::loggerPtr->info("[TestLedger] legacy sign: {} APDU exchanges ({} for trusted inputs)"
+         , nbApdu, nbTrustedInputApdu);
+      return signedOk;
+   };
+
+   unsigned nbApduCold = 0, nbTrustedInputCold = 0;
+   ASSERT_TRUE(signTx(nbApduCold, nbTrustedInputCold));
+   EXPECT_GT(nbTrustedInputCold, 0);
+   EXPECT_EQ(trustedInputCache->size(), 1);
+
+   unsigned nbApduWarm = 0, nbTrustedInputWarm = 0;
+   ASSERT_TRUE(signTx(nbApduWarm, nbTrustedInputWarm));
+   EXPECT_EQ(nbTrustedInputWarm, 0);
+   // trusted input and input public key with its parent are cached
+   EXPECT_EQ(nbApduWarm, nbApduCold - nbTrustedInputCold - 2);
+
+   LedgerPublicKeyCache::instance().clear();
+}
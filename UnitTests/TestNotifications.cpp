@@ -0,0 +1,175 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "NotificationCenter.h"
+#include "TestEnv.h"
+
+using namespace bs::ui;
+
+namespace {
+
+   const auto kWindow = std::chrono::milliseconds(50);
+
+   struct Delivered
+   {
+      NotifyType     type;
+      NotifyMessage  msg;
+   };
+
+   class CountingResponder : public NotificationResponder
+   {
+   public:
+      void respond(NotifyType nt, NotifyMessage msg) override
+      {
+         delivered_.push_back({ nt, msg });
+      }
+
+      const std::vector<Delivered> &delivered() const { return delivered_; }
+
+   private:
+      std::vector<Delivered> delivered_;
+   };
+
+   NotifyMessage chatMessage(const QString &userId, int index)
+   {
+      return { QStringLiteral("user"), QStringLiteral("message %1").arg(index), userId, false };
+   }
+
+} // namespace
+
+TEST(TestNotifications, CoalesceBurst)
+{
+   std::vector<Delivered> delivered;
+   NotificationCoalescer coalescer(kWindow, [&delivered](NotifyType nt, const NotifyMessage &msg) {
+      delivered.push_back({ nt, msg });
+   });
+
+   const int nbTXs = 12;
+   for (int i = 0; i < nbTXs; ++i) {
+      coalescer.push(NotifyType::BlockchainTX, { QStringLiteral("title"), QStringLiteral("tx %1").arg(i), 1 });
+   }
+   EXPECT_TRUE(delivered.empty());
+   EXPECT_EQ(coalescer.nbPending(), 1);
+
+   ASSERT_TRUE(waitFor([&delivered] { return !delivered.empty(); }));
+   ASSERT_EQ(delivered.size(), 1);
+   EXPECT_EQ(delivered[0].type, NotifyType::BlockchainTX);
+   ASSERT_GE(delivered[0].msg.size(), 2);
+   EXPECT_TRUE(delivered[0].msg[1].toString().startsWith(QString::number(nbTXs)));
+   EXPECT_EQ(coalescer.nbPending(), 0);
+}
+
+TEST(TestNotifications, SingleNotificationUnchanged)
+{
+   std::vector<Delivered> delivered;
+   NotificationCoalescer coalescer(kWindow, [&delivered](NotifyType nt, const NotifyMessage &msg) {
+      delivered.push_back({ nt, msg });
+   });
+
+   const NotifyMessage msg{ QStringLiteral("title"), QStringLiteral("text") };
+   coalescer.push(NotifyType::BlockchainTX, msg);
+   ASSERT_TRUE(waitFor([&delivered] { return !delivered.empty(); }));
+   ASSERT_EQ(delivered.size(), 1);
+   EXPECT_EQ(delivered[0].msg, msg);
+}
+
+TEST(TestNotifications, CoalescePerTarget)
+{
+   std::vector<Delivered> delivered;
+   NotificationCoalescer coalescer(kWindow, [&delivered](NotifyType nt, const NotifyMessage &msg) {
+      delivered.push_back({ nt, msg });
+   });
+
+   for (int i = 0; i < 10; ++i) {
+      coalescer.push(NotifyType::UpdateUnreadMessage, chatMessage(QStringLiteral("alice"), i));
+      coalescer.push(NotifyType::UpdateUnreadMessage, chatMessage(QStringLiteral("bob"), i));
+      coalescer.push(NotifyType::DealerQuotes, { i });
+   }
+   ASSERT_TRUE(waitFor([&delivered] { return (delivered.size() >= 3); }));
+   ASSERT_EQ(delivered.size(), 3);
+
+   EXPECT_EQ(delivered[0].type, NotifyType::UpdateUnreadMessage);
+   EXPECT_EQ(delivered[0].msg[2].toString(), QStringLiteral("alice"));
+   EXPECT_TRUE(delivered[0].msg[1].toString().startsWith(QStringLiteral("10")));
+   EXPECT_EQ(delivered[1].msg[2].toString(), QStringLiteral("bob"));
+
+   // Only the latest state is delivered for dealer quotes
+   EXPECT_EQ(delivered[2].type, NotifyType::DealerQuotes);
+   EXPECT_EQ(delivered[2].msg[0].toInt(), 9);
+}
+
+TEST(TestNotifications, PassThroughKeepsOrder)
+{
+   std::vector<Delivered> delivered;
+   NotificationCoalescer coalescer(kWindow, [&delivered](NotifyType nt, const NotifyMessage &msg) {
+      delivered.push_back({ nt, msg });
+   });
+
+   coalescer.push(NotifyType::BlockchainTX, { QStringLiteral("title"), QStringLiteral("text") });
+   coalescer.push(NotifyType::LogOut, {});
+
+   // LogOut is not coalesced and flushes pending ones first
+   ASSERT_EQ(delivered.size(), 2);
+   EXPECT_EQ(delivered[0].type, NotifyType::BlockchainTX);
+   EXPECT_EQ(delivered[1].type, NotifyType::LogOut);
+   EXPECT_EQ(coalescer.nbPending(), 0);
+}
+
+TEST(TestNotifications, RateLimitBurst)
+{
+   const size_t maxQueued = 3;
+   CallRateLimiter limiter(kWindow, maxQueued);
+
+   int nbCalls = 0;
+   const int nbRequests = 20;
+   for (int i = 0; i < nbRequests; ++i) {
+      limiter.call([&nbCalls] { ++nbCalls; });
+   }
+   EXPECT_EQ(nbCalls, 1);
+   EXPECT_EQ(limiter.nbQueued(), maxQueued);
+   EXPECT_EQ(limiter.nbDropped(), nbRequests - 1 - maxQueued);
+
+   ASSERT_TRUE(waitFor([&limiter] { return (limiter.nbQueued() == 0); }));
+   EXPECT_EQ(nbCalls, 1 + maxQueued);
+}
+
+TEST(TestNotifications, CenterRespondsOncePerBurst)
+{
+   NotificationCenter center(StaticLogger::loggerPtr);
+   const auto responder = std::make_shared<CountingResponder>();
+   center.addResponder(responder);
+   const auto &delivered = responder->delivered();
+
+   const int nbTXs = 12;
+   const auto sendBurst = [&center, nbTXs] {
+      for (int i = 0; i < nbTXs; ++i) {
+         center.enqueue(NotifyType::BlockchainTX, { QStringLiteral("title"), QStringLiteral("tx %1").arg(i), 1 });
+      }
+   };
+
+   sendBurst();
+   ASSERT_TRUE(waitFor([&delivered] { return !delivered.empty(); }));
+   // No more responses for the same burst
+   EXPECT_FALSE(waitFor([&delivered] { return (delivered.size() > 1); }, 2 * center.coalescingWindow()));
+   ASSERT_EQ(delivered.size(), 1);
+   EXPECT_EQ(delivered[0].type, NotifyType::BlockchainTX);
+   ASSERT_EQ(delivered[0].msg.size(), 3);
+   EXPECT_EQ(delivered[0].msg[2].toInt(), nbTXs);
+
+   sendBurst();
+   ASSERT_TRUE(waitFor([&delivered] { return (delivered.size() > 1); }));
+   EXPECT_FALSE(waitFor([&delivered] { return (delivered.size() > 2); }, 2 * center.coalescingWindow()));
+   EXPECT_EQ(delivered.size(), 2);
+}
@@ -0,0 +1,632 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "CoreHDWallet.h"
+#include "CoreWalletsManager.h"
+#include "DataConnectionListener.h"
+#include "DispatchQueue.h"
+#include "FutureValue.h"
+#include "HeadlessContainer.h"
+#include "HeadlessContainerListener.h"
+#include "ProtobufHeadlessUtils.h"
+#include "Settings/HeadlessSettings.h"
+#include "SignerAdapterListener.h"
+#include "TestEnv.h"
+#include "Wallets/SyncHDWallet.h"
+#include "Wallets/SyncWalletsManager.h"
+#include "ZmqContext.h"
+#include "ZMQ_BIP15X_DataConnection.h"
+#include "ZMQ_BIP15X_ServerConnection.h"
+
+// Throughput and latency of the headless signer as seen by the terminal:
+// HeadlessContainerListener is served over a local BIP15X ZMQ connection and
+// driven by RemoteSigner with a configurable mix of requests. Offline sign
+// requests go through SignerAdapterListener (signer GUI connection), where
+// pipelined requests are signed in batches. Disabled by default, run with:
+//    unit_tests --gtest_also_run_disabled_tests --gtest_filter=*SignerBenchmark*
+// Parameters are read from the environment:
+//    BS_SIGNER_BENCH_REQUESTS      total number of requests (default 500)
+//    BS_SIGNER_BENCH_CONCURRENCY   requests in flight (default 8)
+//    BS_SIGNER_BENCH_WALLETS       number of HD wallets (default 4)
+//    BS_SIGNER_BENCH_MIX           weights as sign:N,offline:N,sync:N,address:N
+//                                  (default sign:4,offline:2,sync:3,address:1)
+
+using namespace std::chrono_literals;
+
+namespace {
+
+   const auto kPassword = SecureBinaryData::fromString("passphrase");
+   const std::string kHost = "127.0.0.1";
+   const std::string kClientKeyFile = "benchClient.peers";
+
+   const size_t kDefaultNbRequests = 500;
+   const size_t kDefaultConcurrency = 8;
+   const size_t kDefaultNbWallets = 4;
+
+   const auto kSetupTimeout = 30s;
+   const auto kRunTimeout = 600s;
+
+   enum class Op
+   {
+      Sign,
+      OfflineSign,
+      Sync,
+      Address
+   };
+
+   const char *opName(Op op)
+   {
+      switch (op) {
+      case Op::Sign:          return "sign";
+      case Op::OfflineSign:   return "offline";
+      case Op::Sync:          return "sync";
+      case Op::Address:       return "address";
+      }
+      return "unknown";
+   }
+
+   size_t envValue(const char *name, size_t defaultValue)
+   {
+      const char *value = std::getenv(name);
+      if (!value) {
+         return defaultValue;
+      }
+      try {
+         const auto result = std::stoul(value);
+         return result ? result : defaultValue;
+      }
+      catch (const std::exception &) {
+         return defaultValue;
+      }
+   }
+
+   std::map<Op, unsigned> requestMix()
+   {
+      std::map<Op, unsigned> result = { { Op::Sign, 4 }, { Op::OfflineSign, 2 }
+         , { Op::Sync, 3 }, { Op::Address, 1 } };
+      const char *value = std::getenv("BS_SIGNER_BENCH_MIX");
+      if (!value) {
+         return result;
+      }
+      std::stringstream ss(value);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+         const auto pos = item.find(':');
+         if (pos == std::string::npos) {
+            continue;
+         }
+         const auto name = item.substr(0, pos);
+         unsigned weight = 0;
+         try {
+            weight = std::stoul(item.substr(pos + 1));
+         }
+         catch (const std::exception &) {
+            continue;
+         }
+         for (const auto op : { Op::Sign, Op::OfflineSign, Op::Sync, Op::Address }) {
+            if (name == opName(op)) {
+               result[op] = weight;
+            }
+         }
+      }
+      return result;
+   }
+
+   // Nearest-rank percentile of sorted values
+   double percentile(const std::vector<double> &sorted, double p)
+   {
+      if (sorted.empty()) {
+         return 0;
+      }
+      const auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+      return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+   }
+
+} // namespace
+
+// Plays the role of the signer GUI on the adapter connection: sends requests
+// and matches replies by request id
+class AdapterClient : public DataConnectionListener
+{
+public:
+   using ReplyCb = std::function<void(const std::string &data)>;
+
+   void setConnection(ZmqBIP15XDataConnection *conn) { conn_ = conn; }
+   bool isConnected() const { return connected_; }
+
+   bool send(Blocksettle::Communication::signer::PacketType type, const std::string &data
+      , const ReplyCb &cb)
+   {
+      Blocksettle::Communication::signer::Packet packet;
+      packet.set_type(type);
+      packet.set_data(data);
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         packet.set_id(++lastReqId_);
+         replyCbs_[packet.id()] = cb;
+      }
+      return conn_->send(packet.SerializeAsString());
+   }
+
+   void OnDataReceived(const std::string &data) override
+   {
+      Blocksettle::Communication::signer::Packet packet;
+      if (!packet.ParseFromString(data) || !packet.id()) {
+         return;
+      }
+      ReplyCb cb;
+      {
+         std::lock_guard<std::mutex> lock(mutex_);
+         const auto it = replyCbs_.find(packet.id());
+         if (it == replyCbs_.end()) {
+            return;
+         }
+         cb = std::move(it->second);
+         replyCbs_.erase(it);
+      }
+      cb(packet.data());
+   }
+
+   void OnConnected() override { connected_ = true; }
+   void OnDisconnected() override { connected_ = false; }
+   void OnError(DataConnectionError) override { connected_ = false; }
+
+private:
+   ZmqBIP15XDataConnection *conn_{};
+   std::atomic<bool> connected_{ false };
+   std::mutex mutex_;
+   bs::signer::RequestId lastReqId_{};
+   std::map<bs::signer::RequestId, ReplyCb> replyCbs_;
+};
+
+// Plays the role of the signer GUI: supplies wallet password on each request
+class BenchmarkCallbacks : public HeadlessContainerCallbacks
+{
+public:
+   BenchmarkCallbacks(const std::shared_ptr<bs::core::WalletsManager> &walletsMgr
+      , const std::shared_ptr<DispatchQueue> &queue)
+      : walletsMgr_(walletsMgr), queue_(queue)
+   {}
+
+   void setListener(HeadlessContainerListener *listener) { listener_ = listener; }
+
+   void peerConn(const std::string &) override {}
+   void peerDisconn(const std::string &) override {}
+   void clientDisconn(const std::string &) override {}
+   void ccNamesReceived(bool) override {}
+   void txSigned(const BinaryData &) override {}
+   void cancelTxSign(const BinaryData &) override {}
+   void autoSignActivated(bool, const std::string &) override {}
+   void xbtSpent(uint64_t, bool) override {}
+   void customDialog(const std::string &, const std::string &) override {}
+   void terminalHandshakeFailed(const std::string &) override {}
+   void updateDialogData(const Blocksettle::Communication::Internal::PasswordDialogDataWrapper &) override {}
+   void walletChanged(const std::string &) override {}
+
+   void decryptWalletRequest(Blocksettle::Communication::signer::PasswordDialogType
+      , const Blocksettle::Communication::Internal::PasswordDialogDataWrapper &
+      , const bs::core::wallet::TXSignRequest &txReq = {}) override
+   {
+      if (txReq.walletIds.empty()) {
+         return;
+      }
+      const auto hdWallet = walletsMgr_->getHDRootForLeaf(txReq.walletIds.front());
+      if (!hdWallet) {
+         return;
+      }
+      const auto rootId = hdWallet->walletId();
+      queue_->dispatch([this, rootId] {
+         listener_->passwordReceived(rootId, bs::error::ErrorCode::NoError, kPassword);
+      });
+   }
+
+private:
+   std::shared_ptr<bs::core::WalletsManager> walletsMgr_;
+   std::shared_ptr<DispatchQueue>   queue_;
+   HeadlessContainerListener        *listener_{};
+};
+
+class TestSignerBenchmark : public ::testing::Test
+{
+protected:
+   struct BenchWallet
+   {
+      std::string leafId;
+      std::shared_ptr<bs::sync::Wallet>   syncLeaf;
+      bs::Address          changeAddr;
+      std::vector<UTXO>    utxos;
+   };
+
+   void SetUp() override
+   {
+      env_ = std::make_unique<TestEnv>(StaticLogger::loggerPtr);
+      env_->requireConnections();
+      walletsDir_ = env_->armoryInstance()->homedir_;
+
+      walletsMgr_ = std::make_shared<bs::core::WalletsManager>(env_->logger(), 0);
+      const bs::wallet::PasswordData pd{ kPassword, { bs::wallet::EncryptionType::Password } };
+      const bs::hd::Path xbtPath({ bs::hd::Purpose::Native, bs::hd::Bitcoin_test, 0 });
+      const auto nbWallets = envValue("BS_SIGNER_BENCH_WALLETS", kDefaultNbWallets);
+      for (size_t i = 0; i < nbWallets; ++i) {
+         const bs::core::wallet::Seed seed{ CryptoPRNG::generateRandom(32), NetworkType::TestNet };
+         auto wallet = std::make_shared<bs::core::hd::Wallet>("bench" + std::to_string(i), ""
+            , seed, pd, walletsDir_, env_->logger());
+         {
+            const bs::core::WalletPasswordScoped lock(wallet, kPassword);
+            wallet->createStructure(10);
+         }
+         const auto leaf = wallet->getGroup(bs::hd::Bitcoin_test)->getLeafByPath(xbtPath);
+         ASSERT_NE(leaf, nullptr);
+         wallets_.push_back({ leaf->walletId() });
+         walletsMgr_->addWallet(wallet);
+      }
+
+      startSigner();
+      connectTerminal();
+      if (HasFatalFailure()) {
+         return;
+      }
+      startAdapter();
+      if (HasFatalFailure()) {
+         return;
+      }
+      fundWallets();
+   }
+
+   void TearDown() override
+   {
+      if (signer_) {
+         signer_->Stop();
+      }
+      signer_.reset();
+      syncMgr_.reset();
+      if (adapterConn_) {
+         adapterConn_->closeConnection();
+      }
+      adapterConn_.reset();
+      adapterServerConn_.reset();
+      if (listener_) {
+         listener_->resetConnection(nullptr);
+      }
+      serverConn_.reset();
+      if (queue_) {
+         queue_->quit();
+      }
+      if (queueThread_.joinable()) {
+         queueThread_.join();
+      }
+      adapterListener_.reset();
+      adapterClient_.reset();
+      listener_.reset();
+      callbacks_.reset();
+      walletsMgr_.reset();
+      env_.reset();
+   }
+
+   void startSigner()
+   {
+      queue_ = std::make_shared<DispatchQueue>();
+      queueThread_ = std::thread([this] {
+         while (!queue_->done()) {
+            queue_->tryProcess();
+         }
+      });
+
+      callbacks_ = std::make_unique<BenchmarkCallbacks>(walletsMgr_, queue_);
+      listener_ = std::make_unique<HeadlessContainerListener>(env_->logger()
+         , walletsMgr_, queue_, walletsDir_, NetworkType::TestNet);
+      listener_->setCallbacks(callbacks_.get());
+      callbacks_->setListener(listener_.get());
+
+      const auto clientKey = ZmqBIP15XDataConnection::getOwnPubKey(walletsDir_, kClientKeyFile);
+      const auto &cbTrustedClients = [clientKey] {
+         return ZmqBIP15XPeers{ ZmqBIP15XPeer(kHost, clientKey) };
+      };
+      const auto zmqContext = std::make_shared<ZmqContext>(env_->logger());
+      serverConn_ = std::make_unique<ZmqBIP15XServerConnection>(env_->logger()
+         , zmqContext, cbTrustedClients);
+      listener_->resetConnection(serverConn_.get());
+      do {
+         port_ = std::to_string((rand() % 50000) + 10000);
+      } while (!serverConn_->BindConnection(kHost, port_, listener_.get()));
+   }
+
+   void connectTerminal()
+   {
+      // Server key is known in advance, so the new key prompt is not expected
+      const auto &cbNewKey = [](const std::string &, const std::string &, const std::string &
+         , const std::shared_ptr<FutureValue<bool>> &newKeyProm) {
+         newKeyProm->setValue(false);
+      };
+      signer_ = std::make_shared<RemoteSigner>(env_->logger()
+         , QString::fromStdString(kHost), QString::fromStdString(port_), NetworkType::TestNet
+         , env_->connectionMgr(), SignContainer::OpMode::Remote, false
+         , walletsDir_, kClientKeyFile, cbNewKey);
+      signer_->updatePeerKeys({ ZmqBIP15XPeer(kHost + ":" + port_, serverConn_->getOwnPubKey()) });
+
+      std::atomic<bool> ready{ false };
+      QObject::connect(signer_.get(), &WalletSignerContainer::ready, [&ready] {
+         ready = true;
+      });
+      signer_->Start();
+      ASSERT_TRUE(waitFor([&ready] { return ready.load(); }, kSetupTimeout));
+
+      syncMgr_ = std::make_shared<bs::sync::WalletsManager>(env_->logger()
+         , env_->appSettings(), env_->armoryConnection());
+      syncMgr_->setSignContainer(signer_);
+      std::atomic<bool> synced{ false };
+      syncMgr_->syncWallets([&synced](int cur, int total) {
+         if (cur == total) {
+            synced = true;
+         }
+      });
+      ASSERT_TRUE(waitFor([&synced] { return synced.load(); }, kSetupTimeout));
+   }
+
+   // Signer GUI connection served by SignerAdapterListener, as in HeadlessAppObj
+   void startAdapter()
+   {
+      adapterClient_ = std::make_unique<AdapterClient>();
+      ZmqBIP15XDataConnectionParams params;
+      params.ephemeralPeers = true;
+      adapterConn_ = std::make_unique<ZmqBIP15XDataConnection>(env_->logger(), params);
+      adapterClient_->setConnection(adapterConn_.get());
+
+      const auto zmqContext = std::make_shared<ZmqContext>(env_->logger());
+      adapterServerConn_ = std::make_unique<ZmqBIP15XServerConnection>(env_->logger()
+         , zmqContext, [] { return ZmqBIP15XPeers{}; });
+      adapterListener_ = std::make_unique<SignerAdapterListener>(nullptr, adapterServerConn_.get()
+         , env_->logger(), walletsMgr_, queue_, std::make_shared<HeadlessSettings>(env_->logger()));
+      std::string port;
+      do {
+         port = std::to_string((rand() % 50000) + 10000);
+      } while (!adapterServerConn_->BindConnection(kHost, port, adapterListener_.get()));
+
+      adapterServerConn_->addAuthPeer(ZmqBIP15XPeer("client", adapterConn_->getOwnPubKey()));
+      adapterConn_->addAuthPeer(ZmqBIP15XPeer(kHost + ":" + port, adapterServerConn_->getOwnPubKey()));
+      ASSERT_TRUE(adapterConn_->openConnection(kHost, port, adapterClient_.get()));
+      ASSERT_TRUE(waitFor([this] { return adapterClient_->isConnected(); }, kSetupTimeout));
+   }
+
+   void fundWallets()
+   {
+      for (const auto &hdWallet : syncMgr_->hdWallets()) {
+         hdWallet->setCustomACT<UnitTestWalletACT>(env_->armoryConnection());
+      }
+      const auto regIDs = syncMgr_->registerWallets();
+      UnitTestWalletACT::waitOnRefresh(regIDs);
+
+      const unsigned blockCount = 6;
+      for (auto &wallet : wallets_) {
+         wallet.syncLeaf = syncMgr_->getWalletById(wallet.leafId);
+         ASSERT_NE(wallet.syncLeaf, nullptr);
+
+         std::atomic<bool> gotAddr{ false };
+         wallet.syncLeaf->getNewExtAddress([&wallet, &gotAddr](const bs::Address &addr) {
+            wallet.changeAddr = addr;
+            gotAddr = true;
+         });
+         ASSERT_TRUE(waitFor([&gotAddr] { return gotAddr.load(); }, kSetupTimeout));
+
+         const auto curHeight = env_->armoryConnection()->topBlock();
+         const auto recipient = wallet.changeAddr.getRecipient(bs::XBTAmount{ (uint64_t)(50 * COIN) });
+         env_->armoryInstance()->mineNewBlock(recipient.get(), blockCount);
+         ASSERT_EQ(UnitTestWalletACT::waitOnNewBlock(), curHeight + blockCount);
+      }
+
+      for (auto &wallet : wallets_) {
+         std::atomic<bool> gotUtxos{ false };
+         wallet.syncLeaf->getSpendableTxOutList([&wallet, &gotUtxos](std::vector<UTXO> utxos) {
+            wallet.utxos = std::move(utxos);
+            gotUtxos = true;
+         }, UINT64_MAX, true);
+         ASSERT_TRUE(waitFor([&gotUtxos] { return gotUtxos.load(); }, kSetupTimeout));
+         ASSERT_FALSE(wallet.utxos.empty());
+      }
+   }
+
+   // Signed TXs are not broadcast, so the same UTXOs are reused by requests
+   bs::core::wallet::TXSignRequest signRequest(size_t index)
+   {
+      const auto &wallet = wallets_[index % wallets_.size()];
+      const auto &utxo = wallet.utxos[(index / wallets_.size()) % wallet.utxos.size()];
+      const auto recipient = randomAddressPKH().getRecipient(bs::XBTAmount{ (uint64_t)COIN });
+      return wallet.syncLeaf->createTXRequest({ utxo }, { recipient }, true, 1000, false
+         , wallet.changeAddr);
+   }
+
+   // Offline requests must have expiration and address indices set
+   Blocksettle::Communication::signer::SignOfflineTxRequest offlineSignRequest(size_t index)
+   {
+      const auto &wallet = wallets_[index % wallets_.size()];
+      auto txReq = signRequest(index);
+      txReq.expiredTimestamp = std::chrono::system_clock::now() + std::chrono::hours(1);
+      const auto addrIndex = wallet.syncLeaf->getAddressIndex(wallet.changeAddr);
+      txReq.inputIndices.assign(txReq.inputs.size(), addrIndex);
+      txReq.change.index = addrIndex;
+
+      Blocksettle::Communication::signer::SignOfflineTxRequest request;
+      request.set_password(kPassword.toBinStr());
+      *(request.mutable_tx_request()) = bs::signer::coreTxRequestToPb(txReq);
+      return request;
+   }
+
+protected:
+   std::unique_ptr<TestEnv>   env_;
+   std::string                walletsDir_;
+   std::string                port_;
+   std::vector<BenchWallet>   wallets_;
+
+   std::shared_ptr<bs::core::WalletsManager>    walletsMgr_;
+   std::shared_ptr<DispatchQueue>               queue_;
+   std::thread                                  queueThread_;
+   std::unique_ptr<BenchmarkCallbacks>          callbacks_;
+   std::unique_ptr<HeadlessContainerListener>   listener_;
+   std::unique_ptr<ZmqBIP15XServerConnection>   serverConn_;
+
+   std::unique_ptr<AdapterClient>               adapterClient_;
+   std::unique_ptr<SignerAdapterListener>       adapterListener_;
+   std::unique_ptr<ZmqBIP15XServerConnection>   adapterServerConn_;
+   std::unique_ptr<ZmqBIP15XDataConnection>     adapterConn_;
+
+   std::shared_ptr<RemoteSigner>                signer_;
+   std::shared_ptr<bs::sync::WalletsManager>    syncMgr_;
+};
+
+TEST_F(TestSignerBenchmark, DISABLED_SignerBenchmark)
+{
+   const auto nbRequests = envValue("BS_SIGNER_BENCH_REQUESTS", kDefaultNbRequests);
+   const auto concurrency = envValue("BS_SIGNER_BENCH_CONCURRENCY", kDefaultConcurrency);
+   const auto mix = requestMix();
+
+   std::vector<Op> ops;
+   std::vector<unsigned> weights;
+   for (const auto &item : mix) {
+      ops.push_back(item.first);
+      weights.push_back(item.second);
+   }
+   // discrete_distribution requires at least one non-zero weight
+   ASSERT_TRUE(std::any_of(weights.cbegin(), weights.cend(), [](unsigned weight) { return weight > 0; }))
+      << "all request weights in BS_SIGNER_BENCH_MIX are zero";
+   std::mt19937 rng(42);
+   std::discrete_distribution<size_t> opDist(weights.begin(), weights.end());
+
+   // Requests are prepared in advance to measure signer round-trip only
+   std::vector<Op> plan;
+   std::map<size_t, bs::core::wallet::TXSignRequest> txRequests;
+   std::map<size_t, std::string> offlineRequests;
+   for (size_t i = 0; i < nbRequests; ++i) {
+      plan.push_back(ops[opDist(rng)]);
+      if (plan.back() == Op::Sign) {
+         txRequests[i] = signRequest(i);
+      }
+      else if (plan.back() == Op::OfflineSign) {
+         offlineRequests[i] = offlineSignRequest(i).SerializeAsString();
+      }
+   }
+
+   std::recursive_mutex mtx;
+   std::map<Op, std::vector<double>> latencies;
+   std::map<bs::signer::RequestId, std::pair<Op, std::chrono::steady_clock::time_point>> pendingSigns;
+   std::atomic<size_t> inFlight{ 0 };
+   std::atomic<size_t> completed{ 0 };
+   std::atomic<size_t> failed{ 0 };
+
+   const auto &onDone = [&](Op op, std::chrono::steady_clock::time_point start, bool success) {
+      const auto elapsed = std::chrono::duration<double, std::milli>(
+         std::chrono::steady_clock::now() - start).count();
+      {
+         std::lock_guard<std::recursive_mutex> lock(mtx);
+         latencies[op].push_back(elapsed);
+      }
+      if (!success) {
+         ++failed;
+      }
+      ++completed;
+      --inFlight;
+   };
+
+   QObject::connect(signer_.get(), &SignContainer::TXSigned
+      , [&](unsigned int id, BinaryData signedTx, bs::error::ErrorCode result, std::string) {
+      std::lock_guard<std::recursive_mutex> lock(mtx);
+      const auto it = pendingSigns.find(id);
+      if (it == pendingSigns.end()) {
+         return;
+      }
+      onDone(it->second.first, it->second.second
+         , (result == bs::error::ErrorCode::NoError) && !signedTx.empty());
+      pendingSigns.erase(it);
+   });
+
+   const auto &issue = [&](size_t index) {
+      const auto op = plan[index];
+      const auto &wallet = wallets_[index % wallets_.size()];
+      const auto start = std::chrono::steady_clock::now();
+      ++inFlight;
+      switch (op) {
+      case Op::Sign: {
+         std::lock_guard<std::recursive_mutex> lock(mtx);
+         const auto reqId = signer_->signTXRequest(txRequests[index]);
+         if (!reqId) {
+            onDone(op, start, false);
+            break;
+         }
+         pendingSigns[reqId] = { op, start };
+         break;
+      }
+      case Op::OfflineSign: {
+         const bool sent = adapterClient_->send(Blocksettle::Communication::signer::SignOfflineTxRequestType
+            , offlineRequests[index], [&onDone, op, start](const std::string &data) {
+            Blocksettle::Communication::signer::SignTxEvent evt;
+            onDone(op, start, evt.ParseFromString(data) && !evt.errorcode() && !evt.signedtx().empty());
+         });
+         if (!sent) {
+            onDone(op, start, false);
+         }
+         break;
+      }
+      case Op::Sync:
+         signer_->syncWallet(wallet.leafId, [&onDone, op, start](bs::sync::WalletData data) {
+            onDone(op, start, !data.addresses.empty());
+         });
+         break;
+      case Op::Address:
+         signer_->extendAddressChain(wallet.leafId, 1, true
+            , [&onDone, op, start](const std::vector<std::pair<bs::Address, std::string>> &addrs) {
+            onDone(op, start, !addrs.empty());
+         });
+         break;
+      }
+   };
+
+   const auto runStart = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < nbRequests; ++i) {
+      ASSERT_TRUE(waitFor([&inFlight, concurrency] { return inFlight < concurrency; }, kRunTimeout));
+      issue(i);
+   }
+   ASSERT_TRUE(waitFor([&completed, nbRequests] { return completed == nbRequests; }, kRunTimeout));
+   const auto runTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+   EXPECT_EQ(failed, 0);
+
+   std::vector<double> all;
+   std::stringstream ss;
+   ss << "signer benchmark: " << nbRequests << " requests, " << concurrency << " in flight, "
+      << wallets_.size() << " wallets\n";
+   for (auto &item : latencies) {
+      auto &values = item.second;
+      std::sort(values.begin(), values.end());
+      all.insert(all.end(), values.begin(), values.end());
+      ss << "  " << opName(item.first) << ": " << values.size() << " requests, p50 "
+         << percentile(values, 0.5) << " ms, p99 " << percentile(values, 0.99) << " ms\n";
+      RecordProperty(std::string(opName(item.first)) + "_p50_us"
+         , static_cast<int>(percentile(values, 0.5) * 1000));
+      RecordProperty(std::string(opName(item.first)) + "_p99_us"
+         , static_cast<int>(percentile(values, 0.99) * 1000));
+   }
+   std::sort(all.begin(), all.end());
+   ss << "  total: p50 " << percentile(all, 0.5) << " ms, p99 " << percentile(all, 0.99)
+      << " ms, throughput " << (runTime > 0 ? nbRequests / runTime : 0) << " req/s";
+
+   StaticLogger::loggerPtr->info("{}", ss.str());
+   RecordProperty("throughput", static_cast<int>(runTime > 0 ? nbRequests / runTime : 0));
+}
@@ -0,0 +1,146 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "TraceProfiler.h"
+
+using namespace bs::trace;
+
+namespace {
+
+   // Complete events ("X") by default, thread names are metadata ("M") events
+   QJsonArray exportEvents(const QString &phase = QStringLiteral("X"))
+   {
+      const auto json = Profiler::instance().toChromeJson();
+      const auto doc = QJsonDocument::fromJson(QByteArray::fromStdString(json));
+      EXPECT_TRUE(doc.isObject());
+
+      QJsonArray result;
+      for (const auto &value : doc.object().value(QStringLiteral("traceEvents")).toArray()) {
+         if (value.toObject().value(QStringLiteral("ph")).toString() == phase) {
+            result.append(value);
+         }
+      }
+      return result;
+   }
+
+} // namespace
+
+TEST(TestTrace, SpanRecorded)
+{
+   auto &profiler = Profiler::instance();
+   profiler.clear();
+   {
+      Span outer("outer", "test");
+      Span inner("inner \"quoted\"", "test");
+   }
+   EXPECT_EQ(profiler.nbEvents(), 2u);
+
+   const auto events = exportEvents();
+   ASSERT_EQ(events.size(), 2);
+
+   // Inner span is completed first
+   const auto inner = events[0].toObject();
+   const auto outer = events[1].toObject();
+   EXPECT_EQ(inner.value(QStringLiteral("name")).toString(), QStringLiteral("inner \"quoted\""));
+   EXPECT_EQ(outer.value(QStringLiteral("name")).toString(), QStringLiteral("outer"));
+   EXPECT_EQ(outer.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+   EXPECT_EQ(outer.value(QStringLiteral("cat")).toString(), QStringLiteral("test"));
+   EXPECT_LE(outer.value(QStringLiteral("ts")).toDouble(), inner.value(QStringLiteral("ts")).toDouble());
+   EXPECT_GE(outer.value(QStringLiteral("dur")).toDouble(), inner.value(QStringLiteral("dur")).toDouble());
+}
+
+TEST(TestTrace, Disabled)
+{
+   auto &profiler = Profiler::instance();
+   profiler.clear();
+   profiler.setEnabled(false);
+   {
+      Span span("disabled", "test");
+   }
+   profiler.setEnabled(true);
+   EXPECT_EQ(profiler.nbEvents(), 0u);
+}
+
+TEST(TestTrace, RingBufferOverwrites)
+{
+   auto &profiler = Profiler::instance();
+   profiler.clear();
+   const size_t nbSpans = Profiler::kEventsPerThread + 10;
+   for (size_t i = 0; i < nbSpans; ++i) {
+      profiler.record("span", "test", static_cast<int64_t>(i), 1);
+   }
+   EXPECT_EQ(profiler.nbEvents(), Profiler::kEventsPerThread);
+
+   // Only the latest spans are kept, oldest first
+   const auto events = exportEvents();
+   ASSERT_EQ(static_cast<size_t>(events.size()), Profiler::kEventsPerThread);
+   EXPECT_EQ(events.first().toObject().value(QStringLiteral("ts")).toInt(), 10);
+   EXPECT_EQ(static_cast<size_t>(events.last().toObject().value(QStringLiteral("ts")).toInt())
+      , nbSpans - 1);
+   profiler.clear();
+}
+
+TEST(TestTrace, PerThreadBuffers)
+{
+   auto &profiler = Profiler::instance();
+   profiler.clear();
+   {
+      Span span("main", "test");
+   }
+   std::thread worker([&profiler] {
+      profiler.setThreadName("worker");
+      Span span("worker", "test");
+   });
+   worker.join();
+   EXPECT_EQ(profiler.nbEvents(), 2u);
+
+   std::set<int> tids;
+   for (const auto &value : exportEvents()) {
+      tids.insert(value.toObject().value(QStringLiteral("tid")).toInt());
+   }
+   EXPECT_EQ(tids.size(), 2u);
+
+   bool threadNameFound = false;
+   for (const auto &value : exportEvents(QStringLiteral("M"))) {
+      const auto args = value.toObject().value(QStringLiteral("args")).toObject();
+      threadNameFound = threadNameFound
+         || (args.value(QStringLiteral("name")).toString() == QStringLiteral("worker"));
+   }
+   EXPECT_TRUE(threadNameFound);
+}
+
+TEST(TestTrace, ExitedThreadsKeepLatestEvents)
+{
+   auto &profiler = Profiler::instance();
+   profiler.clear();
+   for (int iThread = 0; iThread < 3; ++iThread) {
+      std::thread worker([&profiler, iThread] {
+         for (size_t i = 0; i < Profiler::kEventsPerThread; ++i) {
+            profiler.record("span", "test", static_cast<int64_t>(iThread), 1);
+         }
+      });
+      worker.join();
+   }
+   EXPECT_EQ(profiler.nbEvents(), Profiler::kEventsPerThread);
+
+   // Only events of the last exited thread are left
+   const auto events = exportEvents();
+   ASSERT_EQ(static_cast<size_t>(events.size()), Profiler::kEventsPerThread);
+   EXPECT_EQ(events.first().toObject().value(QStringLiteral("ts")).toInt(), 2);
+   profiler.clear();
+}
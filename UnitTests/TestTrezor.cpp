@@ -0,0 +1,261 @@
+/*
+
+***********************************************************************************
+* Copyright (C) 2020 - 2020, BlockSettle AB
+* Distributed under the GNU Affero General Public License (AGPL v3)
+* See LICENSE or http://www.gnu.org/licenses/agpl.html
+*
+**********************************************************************************
+
+*/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <map>
+
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "ConnectionManager.h"
+#include "CoreWallet.h"
+#include "TestEnv.h"
+#include "trezor/trezorClient.h"
+#include "trezor/trezorDevice.h"
+
+using namespace hw::trezor::messages;
+
+namespace {
+
+   const int kNbInputs = 20;
+   const int kNbPrevInputs = 3;
+   const int kNbPrevOutputs = 2;
+   const uint64_t kPrevOutputValue = 100000;
+   const std::string kSignedTxChunk = "signed tx";
+
+   QByteArray packMessage(int msgType, const google::protobuf::Message &msg)
+   {
+      const auto serialized = QByteArray::fromStdString(msg.SerializeAsString());
+      return QByteArray::number(msgType, 16).rightJustified(4, '0')
+         + QByteArray::number(serialized.size(), 16).rightJustified(8, '0')
+         + serialized.toHex();
+   }
+
+   // Minimal HTTP server standing in for trezord bridge. Plays the device side
+   // of signing workflow for legacy inputs: each input is followed by requests
+   // for metadata, all inputs and all outputs of its previous TX. Every answer
+   // is checked and each /call is counted as a bridge round-trip.
+   class TrezorStandInBridge : public QObject
+   {
+   public:
+      using Check = std::function<bool(const bitcoin::TxAck &)>;
+
+      TrezorStandInBridge()
+      {
+         QObject::connect(&server_, &QTcpServer::newConnection, this, [this] {
+            while (server_.hasPendingConnections()) {
+               auto socket = server_.nextPendingConnection();
+               QObject::connect(socket, &QTcpSocket::readyRead, this, [this, socket] {
+                  onData(socket);
+               });
+               QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+         });
+      }
+
+      bool listen() { return server_.listen(QHostAddress::LocalHost); }
+      QByteArray endPoint() const
+      {
+         return "http://127.0.0.1:" + QByteArray::number(server_.serverPort());
+      }
+
+      void addStep(const bitcoin::TxRequest &request, const Check &check)
+      {
+         steps_.push_back({ request, check });
+      }
+
+      unsigned nbRoundTrips() const { return nbRoundTrips_; }
+      unsigned nbMismatches() const { return nbMismatches_; }
+      size_t nbSteps() const { return steps_.size(); }
+
+   private:
+      void onData(QTcpSocket *socket)
+      {
+         auto &buffer = buffers_[socket];
+         buffer.append(socket->readAll());
+
+         const int headerEnd = buffer.indexOf("\r\n\r\n");
+         if (headerEnd < 0) {
+            return;
+         }
+         int contentLength = 0;
+         for (const auto &line : buffer.left(headerEnd).split('\n')) {
+            if (line.toLower().startsWith("content-length:")) {
+               contentLength = line.mid(15).trimmed().toInt();
+            }
+         }
+         if (buffer.size() < headerEnd + 4 + contentLength) {
+            return;
+         }
+         const auto body = buffer.mid(headerEnd + 4, contentLength);
+         buffer.remove(0, headerEnd + 4 + contentLength);
+
+         const auto response = onCall(body);
+         socket->write("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: "
+            + QByteArray::number(response.size()) + "\r\n\r\n" + response);
+      }
+
+      QByteArray onCall(const QByteArray &body)
+      {
+         ++nbRoundTrips_;
+         const int msgType = body.mid(0, 4).toInt(nullptr, 16);
+         const int length = body.mid(4, 8).toInt(nullptr, 16);
+         const auto payload = QByteArray::fromHex(body.mid(12, 2 * length)).toStdString();
+
+         if (msgType == MessageType_SignTx) {
+            nextStep_ = 0;
+         }
+         else {
+            bitcoin::TxAck txAck;
+            if ((msgType != MessageType_TxAck) || !txAck.ParseFromString(payload)
+               || (nextStep_ == 0) || !steps_[nextStep_ - 1].second(txAck)) {
+               ++nbMismatches_;
+            }
+         }
+
+         if (nextStep_ < steps_.size()) {
+            return packMessage(MessageType_TxRequest, steps_[nextStep_++].first);
+         }
+         bitcoin::TxRequest finished;
+         finished.set_request_type(bitcoin::TxRequest_RequestType_TXFINISHED);
+         finished.mutable_serialized()->set_serialized_tx(kSignedTxChunk);
+         return packMessage(MessageType_TxRequest, finished);
+      }
+
+   private:
+      QTcpServer  server_;
+      std::map<QTcpSocket *, QByteArray>  buffers_;
+      std::vector<std::pair<bitcoin::TxRequest, Check>>  steps_;
+      size_t   nextStep_{};
+      unsigned nbRoundTrips_{};
+      unsigned nbMismatches_{};
+   };
+
+   bitcoin::TxRequest txRequest(bitcoin::TxRequest_RequestType type, uint32_t index
+      , const BinaryData &prevTxHash = {})
+   {
+      bitcoin::TxRequest request;
+      request.set_request_type(type);
+      request.mutable_details()->set_request_index(index);
+      if (!prevTxHash.empty()) {
+         request.mutable_details()->set_tx_hash(prevTxHash.copySwapEndian().toBinStr());
+      }
+      return request;
+   }
+
+   BinaryData makePrevTx(const BinaryData &outputScript)
+   {
+      BinaryWriter bw;
+      bw.put_uint32_t(1);
+      bw.put_var_int(kNbPrevInputs);
+      for (int i = 0; i < kNbPrevInputs; ++i) {
+         bw.put_BinaryData(CryptoPRNG::generateRandom(32));
+         bw.put_uint32_t(i);
+         const auto scriptSig = CryptoPRNG::generateRandom(107);
+         bw.put_var_int(scriptSig.getSize());
+         bw.put_BinaryData(scriptSig);
+         bw.put_uint32_t(UINT32_MAX - i);
+      }
+      bw.put_var_int(kNbPrevOutputs);
+      for (int i = 0; i < kNbPrevOutputs; ++i) {
+         bw.put_uint64_t(kPrevOutputValue + i);
+         bw.put_var_int(outputScript.getSize());
+         bw.put_BinaryData(outputScript);
+      }
+      bw.put_uint32_t(0);
+      return bw.getData();
+   }
+
+} // namespace
+
+TEST(TestTrezor, SignLegacyInputs)
+{
+   TrezorStandInBridge bridge;
+   ASSERT_TRUE(bridge.listen());
+
+   const auto inputScript = randomAddressPKH().getScript();
+   bs::core::wallet::TXSignRequest txReq;
+   for (int i = 0; i < kNbInputs; ++i) {
+      const auto rawPrevTx = makePrevTx(inputScript);
+      const Tx prevTx(rawPrevTx);
+      ASSERT_TRUE(prevTx.isInitialized());
+
+      txReq.inputs.push_back(UTXO(kPrevOutputValue, UINT32_MAX, 0, 0, prevTx.getThisHash(), inputScript));
+      txReq.inputIndices.push_back("0/" + std::to_string(i));
+      txReq.supportingTXs[prevTx.getThisHash()] = rawPrevTx;
+
+      const auto prevHash = prevTx.getThisHash();
+      bridge.addStep(txRequest(bitcoin::TxRequest_RequestType_TXINPUT, i)
+         , [prevHash](const bitcoin::TxAck &ack) {
+         return (ack.tx().inputs_size() == 1)
+            && (ack.tx().inputs(0).prev_hash() == prevHash.copySwapEndian().toBinStr());
+      });
+      bridge.addStep(txRequest(bitcoin::TxRequest_RequestType_TXMETA, 0, prevHash)
+         , [prevTx](const bitcoin::TxAck &ack) {
+         return (ack.tx().version() == prevTx.getVersion())
+            && (ack.tx().lock_time() == prevTx.getLockTime())
+            && (ack.tx().inputs_cnt() == prevTx.getNumTxIn())
+            && (ack.tx().outputs_cnt() == prevTx.getNumTxOut());
+      });
+      for (int j = 0; j < kNbPrevInputs; ++j) {
+         bridge.addStep(txRequest(bitcoin::TxRequest_RequestType_TXINPUT, j, prevHash)
+            , [prevTx, j](const bitcoin::TxAck &ack) {
+            const auto txIn = prevTx.getTxInCopy(j);
+            return (ack.tx().inputs_size() == 1)
+               && (ack.tx().inputs(0).prev_hash() == txIn.getOutPoint().getTxHash().copySwapEndian().toBinStr())
+               && (ack.tx().inputs(0).prev_index() == txIn.getOutPoint().getTxOutIndex())
+               && (ack.tx().inputs(0).sequence() == txIn.getSequence())
+               && (ack.tx().inputs(0).script_sig() == txIn.getScript().toBinStr());
+         });
+      }
+      for (int j = 0; j < kNbPrevOutputs; ++j) {
+         bridge.addStep(txRequest(bitcoin::TxRequest_RequestType_TXOUTPUT, j, prevHash)
+            , [prevTx, j](const bitcoin::TxAck &ack) {
+            const auto txOut = prevTx.getTxOutCopy(j);
+            return (ack.tx().bin_outputs_size() == 1)
+               && (ack.tx().bin_outputs(0).amount() == txOut.getValue())
+               && (ack.tx().bin_outputs(0).script_pubkey() == txOut.getScript().toBinStr());
+         });
+      }
+   }
+   txReq.recipients.push_back(randomAddressPKH().getRecipient(bs::XBTAmount{ kPrevOutputValue }));
+   bridge.addStep(txRequest(bitcoin::TxRequest_RequestType_TXOUTPUT, 0)
+      , [](const bitcoin::TxAck &ack) {
+      return (ack.tx().outputs_size() == 1) && (ack.tx().outputs(0).amount() == kPrevOutputValue);
+   });
+
+   const auto connMgr = std::make_shared<ConnectionManager>(StaticLogger::loggerPtr);
+   QPointer<TrezorClient> client = new TrezorClient(connMgr, nullptr, true);
+   client->setBridgeEndPoint(bridge.endPoint());
+   TrezorDevice device(connMgr, nullptr, true, client);
+
+   bool finished = false;
+   std::string signedTx;
+   const auto start = std::chrono::steady_clock::now();
+   device.signTX(txReq, [&finished, &signedTx](QVariant &&result) {
+      signedTx = result.value<HWSignedTx>().signedTx;
+      finished = true;
+   });
+   ASSERT_TRUE(waitFor([&finished] { return finished; }));
+   const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+   StaticLogger::loggerPtr->info("[TestTrezor] signed {} legacy inputs: {} bridge round-trips, {} ms"
+      , kNbInputs, bridge.nbRoundTrips(), elapsed.count());
+
+   EXPECT_EQ(bridge.nbMismatches(), 0);
+   // SignTx followed by one answer per device request
+   EXPECT_EQ(bridge.nbRoundTrips(), bridge.nbSteps() + 1);
+   EXPECT_EQ(signedTx, kSignedTxChunk);
+
+   delete client;
+}
@@ -19,6 +19,7 @@
 #include "CoreHDWallet.h"
 #include "CoreWallet.h"
 #include "CoreWalletsManager.h"
+#include "HDWalletsLoader.h"
 #include "InprocSigner.h"
 #include "SystemFileUtils.h"
 #include "TestEnv.h"
@@ -2062,3 +2063,45 @@ TEST_F(TestWallet, WalletMeta)
       }
    }
 }
+
+TEST_F(TestWallet, ParallelLoadingStartupTime)
+{
+   const size_t nbWallets = 12;
+   const auto passphrase = SecureBinaryData::fromString("test");
+   const bs::wallet::PasswordData pd{ passphrase, { bs::wallet::EncryptionType::Password } };
+   const SecureBinaryData ctrlPass;
+
+   std::set<std::string> walletIds;
+   for (size_t i = 0; i < nbWallets; ++i) {
+      const bs::core::wallet::Seed seed{ CryptoPRNG::generateRandom(32), NetworkType::TestNet };
+      auto wallet = std::make_shared<bs::core::hd::Wallet>("test" + std::to_string(i), ""
+         , seed, pd, walletFolder_, envPtr_->logger());
+      {
+         const bs::core::WalletPasswordScoped lock(wallet, passphrase);
+         wallet->createStructure();
+      }
+      walletIds.insert(wallet->walletId());
+   }
+   ASSERT_EQ(HDWalletsLoader::walletFiles(walletFolder_).size(), nbWallets);
+
+   const auto &loadWallets = [this, ctrlPass, walletIds](unsigned nbThreads) {
+      std::set<std::string> loadedIds;
+      const auto start = std::chrono::steady_clock::now();
+      const HDWalletsLoader loader(envPtr_->logger(), nbThreads);
+      const auto result = loader.load(NetworkType::TestNet, walletFolder_, ctrlPass
+         , [&loadedIds](const HDWalletsLoader::WalletPtr &wallet) {
+         loadedIds.insert(wallet->walletId());
+      });
+      const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+         std::chrono::steady_clock::now() - start);
+      EXPECT_EQ(result.nbLoaded, walletIds.size());
+      EXPECT_EQ(result.nbFailed, 0);
+      EXPECT_EQ(loadedIds, walletIds);
+      return elapsed;
+   };
+
+   const auto serialTime = loadWallets(1);
+   const auto parallelTime = loadWallets(0);
+   StaticLogger::loggerPtr->info("loading {} wallets took {} ms serially, {} ms in parallel"
+      , nbWallets, serialTime.count(), parallelTime.count());
+}